@@ -0,0 +1,76 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/game_controller.h"
+
+#include <memory>
+
+#include "jactorioTests.h"
+
+#include "proto/resource_entity.h"
+#include "proto/tile.h"
+
+namespace jactorio::game
+{
+    constexpr auto kBenchSaveName = "__jactorio_bench";
+
+    /// Game with side * side chunks, base layer filled, one in every 4 tiles has a resource
+    class SaveBenchGame
+    {
+    public:
+        explicit SaveBenchGame(const int side) {
+            data::active_prototype_manager   = &gameController.proto;
+            data::active_unique_data_manager = &gameController.unique;
+
+            auto& tile = gameController.proto.Make<proto::Tile>();
+            auto& ore  = gameController.proto.Make<proto::ResourceEntity>();
+            gameController.proto.GenerateRelocationTable();
+
+            auto& world = gameController.worlds[0];
+            for (int cy = 0; cy < side; ++cy) {
+                for (int cx = 0; cx < side; ++cx) {
+                    auto& chunk = world.EmplaceChunk({cx, cy});
+
+                    for (auto& chunk_tile : chunk.Tiles(TileLayer::base)) {
+                        chunk_tile.SetPrototype(Orientation::up, &tile);
+                    }
+
+                    auto& resource_tiles = chunk.Tiles(TileLayer::resource);
+                    for (std::size_t i = 0; i < resource_tiles.size(); i += 4) {
+                        resource_tiles[i].SetPrototype(Orientation::up, &ore);
+                        chunk.GetResourceAmount({SafeCast<ChunkTileCoordAxis>(i % Chunk::kChunkWidth),
+                                                 SafeCast<ChunkTileCoordAxis>(i / Chunk::kChunkWidth)}) = 100;
+                    }
+                }
+            }
+        }
+
+        // Game controller is large, kept on heap
+        std::unique_ptr<GameController> gameControllerPtr = std::make_unique<GameController>(nullptr);
+        GameController& gameController                    = *gameControllerPtr;
+    };
+
+    static void BM_GameControllerSaveGame(benchmark::State& state) {
+        const auto side = SafeCast<int>(state.range(0));
+        const SaveBenchGame game(side);
+
+        for (auto _ : state) {
+            game.gameController.SaveGame(kBenchSaveName);
+        }
+        state.SetItemsProcessed(state.iterations() * side * side);
+    }
+    BENCHMARK(BM_GameControllerSaveGame)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond);
+
+    static void BM_GameControllerLoadGame(benchmark::State& state) {
+        const auto side = SafeCast<int>(state.range(0));
+        SaveBenchGame game(side);
+        game.gameController.SaveGame(kBenchSaveName);
+
+        for (auto _ : state) {
+            game.gameController.LoadGame(kBenchSaveName);
+        }
+        state.SetItemsProcessed(state.iterations() * side * side);
+    }
+    BENCHMARK(BM_GameControllerLoadGame)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond);
+} // namespace jactorio::game
@@ -0,0 +1,112 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/logic/conveyor_controller.h"
+
+#include <memory>
+#include <vector>
+
+#include "jactorioTests.h"
+
+#include "core/thread_pool.h"
+#include "proto/transport_belt.h"
+
+namespace jactorio::game
+{
+    /// Segments are laid out in rows of this many tiles
+    constexpr int kConveyorRowWidth = 1024;
+    /// Segments are chained into loops of this many segments so items never stop moving
+    constexpr int kConveyorLoopSize = 4;
+
+    /// World filled with single tile conveyor segments, each lane holding one item
+    class ConveyorBenchWorld
+    {
+    public:
+        /// \param with_items If false, conveyors are empty
+        explicit ConveyorBenchWorld(const int segment_count, const bool with_items = true) {
+            data::active_prototype_manager = &proto_;
+
+            transportBelt_.speed = 0.05;
+
+            const int rows = (segment_count + kConveyorRowWidth - 1) / kConveyorRowWidth;
+            for (int cy = 0; cy <= (rows - 1) / Chunk::kChunkWidth; ++cy) {
+                for (int cx = 0; cx < kConveyorRowWidth / Chunk::kChunkWidth; ++cx) {
+                    world.EmplaceChunk({cx, cy});
+                }
+            }
+
+            structs_.reserve(segment_count);
+            for (int i = 0; i < segment_count; ++i) {
+                auto con_struct =
+                    std::make_shared<ConveyorStruct>(Orientation::right, ConveyorStruct::TerminationType::straight, 1);
+                if (with_items) {
+                    con_struct->AppendItem(true, proto::LineDistT(0.5), item_);
+                    con_struct->AppendItem(false, proto::LineDistT(0.5), item_);
+                }
+
+                TestCreateConveyorSegment(
+                    world, {i % kConveyorRowWidth, i / kConveyorRowWidth}, con_struct, transportBelt_);
+                structs_.push_back(con_struct);
+            }
+
+            for (int i = 0; i < segment_count; ++i) {
+                const int loop_start = i / kConveyorLoopSize * kConveyorLoopSize;
+                const int next       = loop_start + (i + 1 - loop_start) % kConveyorLoopSize;
+                if (next < segment_count)
+                    structs_[i]->target = structs_[next].get();
+            }
+        }
+
+        World world;
+
+    private:
+        data::PrototypeManager proto_;
+
+        proto::Item item_;
+        proto::TransportBelt& transportBelt_ = proto_.Make<proto::TransportBelt>();
+
+        std::vector<std::shared_ptr<ConveyorStruct>> structs_;
+    };
+
+    static void BM_ConveyorLogicUpdate(benchmark::State& state) {
+        const auto segment_count = SafeCast<int>(state.range(0));
+        ConveyorBenchWorld bench_world(segment_count);
+
+        for (auto _ : state) {
+            ConveyorLogicUpdate(bench_world.world);
+        }
+        state.SetItemsProcessed(state.iterations() * segment_count);
+    }
+    BENCHMARK(BM_ConveyorLogicUpdate)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+    /// Loops are independent and updated across all hardware threads
+    static void BM_ConveyorLogicUpdateParallel(benchmark::State& state) {
+        const auto segment_count = SafeCast<int>(state.range(0));
+        ConveyorBenchWorld bench_world(segment_count);
+        ThreadPool pool;
+
+        for (auto _ : state) {
+            ConveyorLogicUpdate(bench_world.world, pool);
+        }
+        state.SetItemsProcessed(state.iterations() * segment_count);
+    }
+    BENCHMARK(BM_ConveyorLogicUpdateParallel)
+        ->RangeMultiplier(8)
+        ->Range(1 << 10, 1 << 20)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+
+    /// Empty conveyors sleep after the first update
+    static void BM_ConveyorLogicUpdateIdle(benchmark::State& state) {
+        const auto segment_count = SafeCast<int>(state.range(0));
+        ConveyorBenchWorld bench_world(segment_count, false);
+        ConveyorLogicUpdate(bench_world.world);
+
+        for (auto _ : state) {
+            ConveyorLogicUpdate(bench_world.world);
+        }
+        state.SetItemsProcessed(state.iterations() * segment_count);
+    }
+    BENCHMARK(BM_ConveyorLogicUpdateIdle)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+} // namespace jactorio::game
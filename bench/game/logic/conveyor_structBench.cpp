@@ -0,0 +1,53 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/logic/conveyor_struct.h"
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    /// Distance between items on the benchmark lanes, leaves room for an item to be inserted between each item
+    constexpr proto::LineDistT kBenchItemGap(0.5);
+
+    /// \return Lane holding item_count items, each kBenchItemGap apart
+    static ConveyorLane MakeBenchLane(const int64_t item_count, const proto::Item& item) {
+        ConveyorLane lane;
+        for (int64_t i = 0; i < item_count; ++i) {
+            lane.AppendItem(kBenchItemGap, item);
+        }
+        return lane;
+    }
+
+    /// Inserts an item in the gap at the middle of the lane, then removes it again
+    static void BM_ConveyorLaneTryInsertItem(benchmark::State& state) {
+        const proto::Item item;
+        auto lane = MakeBenchLane(state.range(0), item);
+
+        // Midway between the two middle items
+        const auto offset =
+            proto::LineDistT(SafeCast<int>(state.range(0) / 2)) * kBenchItemGap + kBenchItemGap / proto::LineDistT(2);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(lane.TryInsertItem(offset, item, 0));
+            benchmark::DoNotOptimize(lane.TryPopItem(offset));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ConveyorLaneTryInsertItem)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+    /// Finds the item in the middle of the lane
+    static void BM_ConveyorLaneGetItem(benchmark::State& state) {
+        const proto::Item item;
+        const auto lane = MakeBenchLane(state.range(0), item);
+
+        const auto offset = proto::LineDistT(SafeCast<int>(state.range(0) / 2)) * kBenchItemGap;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(lane.GetItem(offset));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ConveyorLaneGetItem)->RangeMultiplier(8)->Range(8, 1 << 15);
+} // namespace jactorio::game
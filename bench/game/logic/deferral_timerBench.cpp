@@ -0,0 +1,67 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/logic/deferral_timer.h"
+
+#include <vector>
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    /// Ticks between each callback of an entity, similar to a mining drill
+    constexpr GameTickT kBenchDeferPeriod = 60;
+
+    /// Re-registers itself every time it is called, as machines do
+    class BenchDeferred final : public TestMockEntity
+    {
+    public:
+        void OnDeferTimeElapsed(World& /*world*/, Logic& logic, proto::UniqueDataBase* unique_data) const override {
+            logic.deferralTimer.RegisterFromTick(
+                *this, SafeCast<proto::FEntityData*>(unique_data), kBenchDeferPeriod);
+        }
+    };
+
+    /// Entities registered are spread evenly across the period, cost per tick is entities / period callbacks
+    static void BM_DeferralUpdate(benchmark::State& state) {
+        const auto entity_count = SafeCast<std::size_t>(state.range(0));
+
+        Logic logic;
+        World world;
+        BenchDeferred deferred;
+        std::vector<proto::FEntityData> unique_datas(entity_count);
+
+        for (std::size_t i = 0; i < entity_count; ++i) {
+            logic.deferralTimer.RegisterAtTick(deferred, &unique_datas[i], i % kBenchDeferPeriod + 1);
+        }
+
+        GameTickT game_tick = 0;
+        for (auto _ : state) {
+            logic.DeferralUpdate(world, ++game_tick);
+        }
+        state.SetItemsProcessed(state.iterations() * SafeCast<int64_t>(entity_count / kBenchDeferPeriod));
+    }
+    BENCHMARK(BM_DeferralUpdate)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+    /// Registers then removes a deferral, as machines do when their state changes before the callback is due
+    static void BM_DeferralRegisterRemove(benchmark::State& state) {
+        const auto entity_count = SafeCast<std::size_t>(state.range(0));
+
+        Logic logic;
+        BenchDeferred deferred;
+        std::vector<proto::FEntityData> unique_datas(entity_count);
+
+        for (std::size_t i = 0; i < entity_count; ++i) {
+            logic.deferralTimer.RegisterAtTick(deferred, &unique_datas[i], i % kBenchDeferPeriod + 1);
+        }
+
+        proto::FEntityData unique_data;
+        for (auto _ : state) {
+            auto entry = logic.deferralTimer.RegisterFromTick(deferred, &unique_data, kBenchDeferPeriod / 2);
+            logic.deferralTimer.RemoveDeferralEntry(entry);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DeferralRegisterRemove)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+} // namespace jactorio::game
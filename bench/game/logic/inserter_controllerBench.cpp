@@ -0,0 +1,55 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/logic/inserter_controller.h"
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    /// Chest, inserter, chest; laid out in rows of this many tiles
+    constexpr int kInserterRowWidth = 3 * 341;
+
+    /// Each inserter moves items from a chest on its right to a chest on its left
+    static void BM_InserterLogicUpdate(benchmark::State& state) {
+        const auto inserter_count = SafeCast<int>(state.range(0));
+
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        World world;
+        Logic logic;
+
+        proto::Item item;
+        item.stackSize = UINT16_MAX; // Pickup chest does not empty during the benchmark
+
+        auto& container        = proto.Make<proto::ContainerEntity>();
+        auto& inserter         = proto.Make<proto::Inserter>();
+        inserter.rotationSpeed = 2.1;
+
+        const int units_per_row = kInserterRowWidth / 3;
+        const int rows          = (inserter_count + units_per_row - 1) / units_per_row;
+        for (int cy = 0; cy <= (rows - 1) / Chunk::kChunkWidth; ++cy) {
+            for (int cx = 0; cx <= (kInserterRowWidth - 1) / Chunk::kChunkWidth; ++cx) {
+                world.EmplaceChunk({cx, cy});
+            }
+        }
+
+        for (int i = 0; i < inserter_count; ++i) {
+            const WorldCoord coord{i % units_per_row * 3, i / units_per_row};
+
+            TestSetupContainer(world, coord, Orientation::up, container);
+            auto& pickup_tile = TestSetupContainer(world, {coord.x + 2, coord.y}, Orientation::up, container);
+            pickup_tile.GetUniqueData<proto::ContainerEntityData>()->inventory[0] = {&item, item.stackSize};
+
+            TestSetupInserter(world, logic, {coord.x + 1, coord.y}, Orientation::left, inserter);
+        }
+
+        for (auto _ : state) {
+            InserterLogicUpdate(world, logic);
+        }
+        state.SetItemsProcessed(state.iterations() * inserter_count);
+    }
+    BENCHMARK(BM_InserterLogicUpdate)->RangeMultiplier(8)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+} // namespace jactorio::game
@@ -0,0 +1,30 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/logistic/inventory.h"
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    /// All slots but the last are filled with another item, thus Add searches the whole inventory
+    static void BM_InventoryAdd(benchmark::State& state) {
+        const auto slot_count = SafeCast<std::size_t>(state.range(0));
+
+        const proto::Item filler_item;
+        const proto::Item item;
+
+        Inventory inv(slot_count);
+        for (std::size_t i = 0; i < slot_count - 1; ++i) {
+            inv[i] = {&filler_item, filler_item.stackSize};
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(inv.Add({&item, 1}));
+            inv.Delete(item, 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_InventoryAdd)->RangeMultiplier(8)->Range(8, 1 << 15);
+} // namespace jactorio::game
@@ -0,0 +1,31 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/world/perlin_noise.h"
+
+namespace jactorio::game
+{
+    /// Noise for one chunk per iteration with kernel range(0), parameters of the default noise layer
+    static void BM_ChunkNoise(benchmark::State& state) {
+        const auto kernel = static_cast<NoiseKernel>(state.range(0));
+        if (!NoiseKernelSupported(kernel)) {
+            state.SkipWithError("Kernel unsupported on this CPU");
+            return;
+        }
+
+        PerlinParams params;
+        params.octaveCount = 8;
+        params.frequency   = 0.25;
+
+        ChunkNoiseMap noise_map;
+
+        ChunkCoordAxis x = 0;
+        for (auto _ : state) {
+            GenerateChunkNoise(kernel, params, {x++, 0}, noise_map);
+            benchmark::DoNotOptimize(noise_map.data());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ChunkNoise)->DenseRange(0, static_cast<int>(NoiseKernel::count_) - 1);
+} // namespace jactorio::game
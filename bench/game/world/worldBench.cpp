@@ -0,0 +1,146 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include "game/world/world.h"
+
+#include <random>
+#include <vector>
+
+#include "jactorioTests.h"
+
+#include "proto/noise_layer.h"
+
+namespace jactorio::game
+{
+    /// Number of coordinates looked up, cycled through each iteration
+    constexpr std::size_t kLookupCount = 4096;
+
+    /// World with side * side chunks emplaced, starting at chunk 0, 0
+    static void EmplaceChunkSquare(World& world, const int side) {
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                world.EmplaceChunk({x, y});
+            }
+        }
+    }
+
+    /// Coordinates evenly distributed within side * side chunks, fixed seed for repeatable results
+    static std::vector<WorldCoord> MakeLookupCoords(const int side) {
+        std::mt19937 rng(1001);
+        std::uniform_int_distribution<WorldCoordAxis> dist(0, side * Chunk::kChunkWidth - 1);
+
+        std::vector<WorldCoord> coords;
+        coords.reserve(kLookupCount);
+        for (std::size_t i = 0; i < kLookupCount; ++i) {
+            coords.emplace_back(dist(rng), dist(rng));
+        }
+        return coords;
+    }
+
+    static void BM_WorldGetTile(benchmark::State& state) {
+        const auto side = SafeCast<int>(state.range(0));
+
+        World world;
+        EmplaceChunkSquare(world, side);
+        const auto coords = MakeLookupCoords(side);
+
+        std::size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(world.GetTile(coords[i], TileLayer::entity));
+            i = (i + 1) % kLookupCount;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_WorldGetTile)->RangeMultiplier(2)->Range(2, 32);
+
+    static void BM_WorldGetChunkC(benchmark::State& state) {
+        const auto side = SafeCast<int>(state.range(0));
+
+        World world;
+        EmplaceChunkSquare(world, side);
+        std::vector<ChunkCoord> coords;
+        coords.reserve(kLookupCount);
+        for (const auto& coord : MakeLookupCoords(side)) {
+            coords.push_back(World::WorldCToChunkC(coord));
+        }
+
+        std::size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(world.GetChunkC(coords[i]));
+            i = (i + 1) % kLookupCount;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_WorldGetChunkC)->RangeMultiplier(2)->Range(2, 32);
+
+    /// Registers then removes range(0) objects, front to back
+    static void BM_WorldLogicRegisterRemove(benchmark::State& state) {
+        const auto count = SafeCast<int>(state.range(0));
+
+        int side = 1;
+        while (side * side * Chunk::kChunkArea < count) {
+            ++side;
+        }
+
+        World world;
+        EmplaceChunkSquare(world, side);
+        const auto width = side * Chunk::kChunkWidth;
+
+        for (auto _ : state) {
+            for (int i = 0; i < count; ++i) {
+                world.LogicRegister(LogicGroup::inserter, {i % width, i / width}, TileLayer::entity);
+            }
+            for (int i = 0; i < count; ++i) {
+                world.LogicRemove(LogicGroup::inserter, {i % width, i / width}, TileLayer::entity);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(BM_WorldLogicRegisterRemove)->RangeMultiplier(8)->Range(1 << 9, 1 << 15)->Unit(benchmark::kMillisecond);
+
+    /// Generates range(0) chunks per iteration with a base tile layer and a resource layer
+    static void BM_WorldGenChunk(benchmark::State& state) {
+        const auto chunk_count = SafeCast<uint8_t>(state.range(0));
+
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        proto::Sprite sprite;
+
+        auto& water = proto.Make<proto::Tile>();
+        auto& grass = proto.Make<proto::Tile>();
+        water.sprite  = &sprite;
+        water.isWater = true;
+        grass.sprite  = &sprite;
+
+        auto& tile_layer = proto.Make<proto::NoiseLayer<proto::Tile>>();
+        tile_layer.normalize = true;
+        tile_layer.Add(-0.5, &water);
+        tile_layer.Add(1, &grass);
+
+        auto& ore = proto.Make<proto::ResourceEntity>();
+        ore.sprite = &sprite;
+
+        auto& resource_layer = proto.Make<proto::NoiseLayer<proto::Entity>>();
+        resource_layer.SetStartNoise(0.5);
+        resource_layer.Add(1, &ore);
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            World world;
+            for (int i = 0; i < chunk_count; ++i) {
+                world.QueueChunkGeneration({i, 0});
+            }
+            state.ResumeTiming();
+
+            world.GenChunk(proto, chunk_count);
+
+            state.PauseTiming();
+            world.Clear();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * chunk_count);
+    }
+    BENCHMARK(BM_WorldGenChunk)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond);
+} // namespace jactorio::game
@@ -0,0 +1,25 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "core/crash_handler.h"
+#include "core/logger.h"
+
+int main(int ac, char* av[]) {
+    current_path(std::filesystem::path(av[0]).parent_path());
+
+    jactorio::RegisterCrashHandler();
+
+    // Logging within the measured code would dominate the timings
+    jactorio::log_level = jactorio::LogSeverity::warning;
+
+    benchmark::Initialize(&ac, av);
+    if (benchmark::ReportUnrecognizedArguments(ac, av))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -23,9 +23,11 @@ fi
 cd ./out/"$1" || exit 2
 
 
-# Build tests if --notest is not defined
+# Build tests if --notest is not defined, build benchmarks instead of tests if --bench is defined
 if [[ "$2" == "--notest" ]]; then
     cmake ../.. -DCMAKE_BUILD_TYPE="$1" -DJACTORIO_BUILD_TESTS:BOOL="False" || exit 2
+elif [[ "$2" == "--bench" ]]; then
+    cmake ../.. -DCMAKE_BUILD_TYPE="$1" -DJACTORIO_BUILD_TESTS:BOOL="False" -DJACTORIO_BUILD_BENCHMARKS:BOOL="True" || exit 2
 elif [ -z "$2" ]; then
     cmake ../.. -DCMAKE_BUILD_TYPE="$1" -DJACTORIO_BUILD_TESTS:BOOL="True" || exit 2
 else
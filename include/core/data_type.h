@@ -7,11 +7,10 @@
 #include <unordered_map>
 #include <vector>
 
-#include <decimal.h>
-
 #include "jactorio.h"
 
 #include "core/coordinate_tuple.h"
+#include "core/fixed_point.h"
 
 namespace jactorio::game
 {
@@ -23,13 +22,15 @@ namespace jactorio
     // Data types of the various components within Jactorio
     // Defined here to solve circular includes
 
-    using Decimal3T = dec::decimal<3>;
+    /// 3 decimal places, deterministic across platforms
+    using FixedDecimal3T = FixedPoint<int64_t, 1000>;
 
 
     // Prototypes
 
-    using PrototypeIdT  = uint32_t;
-    using UniqueDataIdT = uint32_t;
+    using PrototypeIdT     = uint32_t;
+    using UniqueDataIdT    = uint32_t;
+    using TilePrototypeIdT = uint16_t;
 
     using SpriteSetT           = uint16_t;
     using SpriteFrameT         = uint16_t;
@@ -0,0 +1,178 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_CORE_FIXED_POINT_H
+#define JACTORIO_INCLUDE_CORE_FIXED_POINT_H
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "jactorio.h"
+
+namespace jactorio
+{
+    /// Deterministic fixed point number, stored as an integer count of 1 / TScale units
+    /// Addition, subtraction and comparisons are plain integer operations
+    /// \tparam TRep Signed integer type holding the value
+    /// \tparam TScale Units per 1, e.g: 1000 for 3 decimal places
+    template <typename TRep, TRep TScale>
+    class FixedPoint
+    {
+        static_assert(std::is_integral_v<TRep> && std::is_signed_v<TRep>);
+        static_assert(TScale > 0);
+
+        /// Holds intermediate results of multiplication and division
+        using WideT = std::conditional_t<(sizeof(TRep) < sizeof(int64_t)), int64_t, TRep>;
+
+    public:
+        using RepT = TRep;
+
+        static constexpr RepT kScale = TScale;
+
+
+        constexpr FixedPoint() noexcept = default;
+
+        /// Rounds to nearest representable value, halves round away from zero
+        constexpr explicit FixedPoint(const double val) noexcept : value_(RoundToRep(val * kScale)) {}
+
+        constexpr explicit FixedPoint(const int val) noexcept : value_(static_cast<RepT>(val * kScale)) {}
+
+        constexpr FixedPoint& operator=(const double val) noexcept {
+            value_ = RoundToRep(val * kScale);
+            return *this;
+        }
+
+        constexpr FixedPoint& operator=(const int val) noexcept {
+            value_ = static_cast<RepT>(val * kScale);
+            return *this;
+        }
+
+        /// Constructs from the underlying integer count of 1 / kScale units
+        J_NODISCARD static constexpr FixedPoint FromRaw(const RepT raw) noexcept {
+            FixedPoint fixed;
+            fixed.value_ = raw;
+            return fixed;
+        }
+
+
+        /// \return Underlying integer count of 1 / kScale units
+        J_NODISCARD constexpr RepT Raw() const noexcept {
+            return value_;
+        }
+
+        J_NODISCARD constexpr double AsDouble() const noexcept {
+            return static_cast<double>(value_) / kScale;
+        }
+
+        /// Rounds to nearest integer, halves round away from zero
+        J_NODISCARD constexpr RepT AsInteger() const noexcept {
+            return static_cast<RepT>(DivRounded(value_, kScale));
+        }
+
+        J_NODISCARD constexpr FixedPoint Abs() const noexcept {
+            return FromRaw(value_ < 0 ? static_cast<RepT>(-value_) : value_);
+        }
+
+
+        // ======================================================================
+        // Arithmetic
+
+        constexpr FixedPoint& operator+=(const FixedPoint& rhs) noexcept {
+            value_ += rhs.value_;
+            return *this;
+        }
+
+        constexpr FixedPoint& operator-=(const FixedPoint& rhs) noexcept {
+            value_ -= rhs.value_;
+            return *this;
+        }
+
+        /// Result is rounded to nearest, halves round away from zero
+        constexpr FixedPoint& operator*=(const FixedPoint& rhs) noexcept {
+            value_ = static_cast<RepT>(MulDivRounded(value_, rhs.value_, kScale));
+            return *this;
+        }
+
+        /// Result is rounded to nearest, halves round away from zero
+        constexpr FixedPoint& operator/=(const FixedPoint& rhs) noexcept {
+            value_ = static_cast<RepT>(MulDivRounded(value_, kScale, rhs.value_));
+            return *this;
+        }
+
+        friend constexpr FixedPoint operator+(FixedPoint lhs, const FixedPoint& rhs) noexcept {
+            return lhs += rhs;
+        }
+
+        friend constexpr FixedPoint operator-(FixedPoint lhs, const FixedPoint& rhs) noexcept {
+            return lhs -= rhs;
+        }
+
+        friend constexpr FixedPoint operator*(FixedPoint lhs, const FixedPoint& rhs) noexcept {
+            return lhs *= rhs;
+        }
+
+        friend constexpr FixedPoint operator/(FixedPoint lhs, const FixedPoint& rhs) noexcept {
+            return lhs /= rhs;
+        }
+
+        friend constexpr FixedPoint operator-(const FixedPoint& val) noexcept {
+            return FromRaw(static_cast<RepT>(-val.value_));
+        }
+
+
+        // ======================================================================
+        // Comparison
+
+        friend constexpr bool operator==(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ == rhs.value_;
+        }
+
+        friend constexpr bool operator!=(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ != rhs.value_;
+        }
+
+        friend constexpr bool operator<(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ < rhs.value_;
+        }
+
+        friend constexpr bool operator<=(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ <= rhs.value_;
+        }
+
+        friend constexpr bool operator>(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ > rhs.value_;
+        }
+
+        friend constexpr bool operator>=(const FixedPoint& lhs, const FixedPoint& rhs) noexcept {
+            return lhs.value_ >= rhs.value_;
+        }
+
+    private:
+        J_NODISCARD static constexpr RepT RoundToRep(const double scaled) noexcept {
+            return static_cast<RepT>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        }
+
+        J_NODISCARD static constexpr WideT DivRounded(const WideT numerator, const WideT denominator) noexcept {
+            const WideT abs_num = numerator < 0 ? -numerator : numerator;
+            const WideT abs_den = denominator < 0 ? -denominator : denominator;
+
+            const WideT quotient = (abs_num + abs_den / 2) / abs_den;
+            return (numerator < 0) != (denominator < 0) ? -quotient : quotient;
+        }
+
+        /// a * b / denominator without forming a * b, which may not fit in WideT
+        /// The whole and remaining parts of a / denominator have the same sign, so rounding the remaining part alone
+        /// rounds the result
+        J_NODISCARD static constexpr WideT MulDivRounded(const WideT a,
+                                                         const WideT b,
+                                                         const WideT denominator) noexcept {
+            const WideT whole     = a / denominator;
+            const WideT remainder = a % denominator;
+            return whole * b + DivRounded(remainder * b, denominator);
+        }
+
+        RepT value_ = 0;
+    };
+} // namespace jactorio
+
+#endif // JACTORIO_INCLUDE_CORE_FIXED_POINT_H
@@ -0,0 +1,171 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_CORE_SLAB_POOL_H
+#define JACTORIO_INCLUDE_CORE_SLAB_POOL_H
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "jactorio.h"
+
+namespace jactorio
+{
+    /// Allocates memory for objects of T from slabs holding SlabObjects objects each
+    ///
+    /// Addresses are stable, objects allocated one after another are contiguous.
+    /// Slabs are aligned to their size, so deallocated memory finds the pool which allocated it without a lookup
+    /// \remark Thread safe
+    template <typename T, std::size_t SlabObjects = 256>
+    class SlabPool
+    {
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        /// At the start of each slab, slots follow
+        struct SlabHeader
+        {
+            SlabPool* pool;
+            SlabHeader* next;
+        };
+
+        static constexpr std::size_t kSlotsOffset =
+            (sizeof(SlabHeader) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+        /// Smallest power of 2 holding header and slots
+        static constexpr std::size_t SlabBytes() {
+            std::size_t bytes = 1;
+            while (bytes < kSlotsOffset + SlabObjects * sizeof(Slot)) {
+                bytes *= 2;
+            }
+            return bytes;
+        }
+
+        static constexpr std::size_t kSlabBytes = SlabBytes();
+
+    public:
+        static constexpr std::size_t kSlabObjects = SlabObjects;
+
+        SlabPool() = default;
+        ~SlabPool() {
+            Release();
+        }
+
+        SlabPool(const SlabPool& other)     = delete;
+        SlabPool(SlabPool&& other) noexcept = delete;
+        SlabPool& operator=(const SlabPool& other) = delete;
+        SlabPool& operator=(SlabPool&& other) noexcept = delete;
+
+        /// \return Uninitialized memory for one T
+        /// \exception std::bad_alloc Failed to allocate slab
+        J_NODISCARD void* Allocate();
+
+        /// Returns memory from Allocate to the pool which allocated it, without locking
+        /// \param ptr Must be allocated by a SlabPool of the same T and SlabObjects, or nullptr
+        static void Deallocate(void* ptr) noexcept;
+
+        /// Frees all slabs at once
+        /// \remark Every object allocated must be destroyed and no longer used
+        void Release() noexcept;
+
+        /// \return Number of objects allocated
+        J_NODISCARD std::size_t Size() const noexcept {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        /// \return Number of slabs held
+        J_NODISCARD std::size_t SlabCount() const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return slabCount_;
+        }
+
+    private:
+        mutable std::mutex mutex_;
+
+        SlabHeader* slabs_     = nullptr;
+        std::size_t slabCount_ = 0;
+
+        /// Deallocated slots taken from returned_, taken before slots never allocated
+        Slot* freeList_ = nullptr;
+        /// Deallocated slots, pushed to without locking mutex_
+        std::atomic<Slot*> returned_ = nullptr;
+
+        /// Slots never allocated in the newest slab
+        Slot* slabNext_ = nullptr;
+        Slot* slabEnd_  = nullptr;
+
+        std::atomic<std::size_t> size_ = 0;
+    };
+
+    template <typename T, std::size_t SlabObjects>
+    void* SlabPool<T, SlabObjects>::Allocate() {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        if (freeList_ == nullptr) {
+            // Taking every returned slot at once cannot take a slot pushed back after being taken
+            freeList_ = returned_.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        Slot* slot;
+        if (freeList_ != nullptr) {
+            slot      = freeList_;
+            freeList_ = slot->next;
+        }
+        else {
+            if (slabNext_ == slabEnd_) {
+                auto* memory = ::operator new(kSlabBytes, std::align_val_t{kSlabBytes});
+                slabs_       = new (memory) SlabHeader{this, slabs_};
+                ++slabCount_;
+
+                slabNext_ = reinterpret_cast<Slot*>(static_cast<unsigned char*>(memory) + kSlotsOffset);
+                slabEnd_  = slabNext_ + kSlabObjects;
+            }
+            slot = slabNext_++;
+        }
+
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    template <typename T, std::size_t SlabObjects>
+    void SlabPool<T, SlabObjects>::Deallocate(void* ptr) noexcept {
+        if (ptr == nullptr)
+            return;
+
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        auto& pool         = *reinterpret_cast<SlabHeader*>(address & ~(kSlabBytes - 1))->pool;
+
+        auto* slot = static_cast<Slot*>(ptr);
+        slot->next = pool.returned_.load(std::memory_order_relaxed);
+        while (!pool.returned_.compare_exchange_weak(
+            slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {}
+
+        pool.size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    template <typename T, std::size_t SlabObjects>
+    void SlabPool<T, SlabObjects>::Release() noexcept {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        while (slabs_ != nullptr) {
+            auto* next = slabs_->next;
+            ::operator delete(slabs_, std::align_val_t{kSlabBytes});
+            slabs_ = next;
+        }
+        slabCount_ = 0;
+
+        freeList_ = nullptr;
+        returned_.store(nullptr, std::memory_order_relaxed);
+        slabNext_ = nullptr;
+        slabEnd_  = nullptr;
+        size_.store(0, std::memory_order_relaxed);
+    }
+} // namespace jactorio
+
+#endif // JACTORIO_INCLUDE_CORE_SLAB_POOL_H
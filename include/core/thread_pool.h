@@ -0,0 +1,60 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_CORE_THREAD_POOL_H
+#define JACTORIO_INCLUDE_CORE_THREAD_POOL_H
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "jactorio.h"
+
+namespace jactorio
+{
+    /// Fixed number of worker threads executing queued tasks
+    class ThreadPool
+    {
+    public:
+        /// \param thread_count Worker threads to create, 0 to use one less than hardware concurrency
+        explicit ThreadPool(std::size_t thread_count = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool& other)     = delete;
+        ThreadPool(ThreadPool&& other) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        ThreadPool& operator=(ThreadPool&& other) noexcept = delete;
+
+
+        J_NODISCARD std::size_t GetThreadCount() const noexcept {
+            return threads_.size();
+        }
+
+        /// Queues func to run on a worker thread
+        /// \return Becomes ready once func completes, holds any exception thrown by func
+        std::future<void> Submit(std::function<void()> func);
+
+        /// Calls func(i) for each i in [0, count), spread across the worker threads and the calling thread
+        /// Blocks until all calls complete, an exception thrown by func is rethrown on the calling thread
+        /// Runs ahead of tasks already submitted, does not wait for workers busy with other tasks
+        /// \remark Do not call from a task running on this pool
+        void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> threads_;
+
+        std::mutex queueMutex_;
+        std::condition_variable queueCv_;
+        std::deque<std::packaged_task<void()>> queue_;
+        bool stopping_ = false;
+    };
+} // namespace jactorio
+
+#endif // JACTORIO_INCLUDE_CORE_THREAD_POOL_H
@@ -5,6 +5,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
 #include <utility>
 
 // Macros for cereal serialization
@@ -73,6 +77,47 @@ namespace jactorio::data
 
         archiver(std::forward<TArgs>(args)...);
     }
+
+
+    /// Number of consecutive elements sharing a value in a run length encoded column
+    using RunLengthT = uint16_t;
+
+    /// Archives get(element) of each element in [begin, end), consecutive equal values are archived once with the
+    /// number of elements sharing it
+    /// \remark Load with CerealLoadRunLength into a range of the same size
+    template <typename TArchive, typename TIt, typename TGet>
+    void CerealSaveRunLength(TArchive& archiver, TIt begin, const TIt end, TGet&& get) {
+        while (begin != end) {
+            const auto value = get(*begin);
+
+            RunLengthT length = 1;
+            auto it           = std::next(begin);
+            for (; it != end && length < std::numeric_limits<RunLengthT>::max() && get(*it) == value; ++it) {
+                ++length;
+            }
+
+            archiver(length, value);
+            begin = it;
+        }
+    }
+
+    /// Loads values archived by CerealSaveRunLength, calls set(element, value) for each element in [begin, end)
+    /// \exception std::runtime_error Run extends past end
+    template <typename TValue, typename TArchive, typename TIt, typename TSet>
+    void CerealLoadRunLength(TArchive& archiver, TIt begin, const TIt end, TSet&& set) {
+        while (begin != end) {
+            RunLengthT length;
+            TValue value;
+            archiver(length, value);
+
+            if (length == 0 || length > std::distance(begin, end)) {
+                throw std::runtime_error("Run length encoded values exceed range");
+            }
+            for (; length > 0; --length, ++begin) {
+                set(*begin, value);
+            }
+        }
+    }
 } // namespace jactorio::data
 
 #endif // JACTORIO_INCLUDE_DATA_CEREAL_SERIALIZE_H
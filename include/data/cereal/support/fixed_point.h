@@ -0,0 +1,52 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_DATA_CEREAL_SUPPORT_FIXED_POINT_H
+#define JACTORIO_INCLUDE_DATA_CEREAL_SUPPORT_FIXED_POINT_H
+#pragma once
+
+#include <limits>
+#include <stdexcept>
+
+#include "core/data_type.h"
+#include "data/cereal/serialize.h"
+#include "data/globals.h"
+
+namespace cereal
+{
+    CEREAL_LOAD_EXTERN(archive, jactorio::FixedDecimal3T, m) {
+        using namespace jactorio;
+
+        if (data::active_save_version < data::kSaveVersionFixedPoint) {
+            // Saved as integer and fractional part, both carrying the sign, e.g: -1.234 is -1, -234
+            int64_t before_val;
+            int64_t after_val;
+            archive(before_val, after_val);
+
+            using LimitsT = std::numeric_limits<FixedDecimal3T::RepT>;
+            if (before_val > LimitsT::max() / FixedDecimal3T::kScale - 1 ||
+                before_val < LimitsT::min() / FixedDecimal3T::kScale + 1)
+                throw std::runtime_error("Decimal value out of range of fixed point");
+
+            const auto raw = before_val * FixedDecimal3T::kScale + after_val % FixedDecimal3T::kScale;
+            m              = FixedDecimal3T::FromRaw(raw);
+            return;
+        }
+
+        if (data::active_save_version < data::kSaveVersionWideFixedPoint) {
+            int32_t raw;
+            archive(raw);
+            m = FixedDecimal3T::FromRaw(raw);
+            return;
+        }
+
+        FixedDecimal3T::RepT raw;
+        archive(raw);
+        m = FixedDecimal3T::FromRaw(raw);
+    }
+
+    CEREAL_SAVE_EXTERN(archive, jactorio::FixedDecimal3T, m) {
+        archive(m.Raw());
+    }
+} // namespace cereal
+
+#endif // JACTORIO_INCLUDE_DATA_CEREAL_SUPPORT_FIXED_POINT_H
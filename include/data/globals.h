@@ -4,6 +4,13 @@
 #define JACTORIO_INCLUDE_DATA_GLOBALS_H
 #pragma once
 
+#include "data/save_game_manager.h"
+
+namespace jactorio
+{
+    class ThreadPool;
+} // namespace jactorio
+
 namespace jactorio::data
 {
     class PrototypeManager;
@@ -12,10 +19,22 @@ namespace jactorio::data
     // Globals for jactorio::data namespace
 
     /// Pybind callbacks to append into the data manager at the pointer
-    /// SerialProtoPtr deserializes with this
+    /// SerialProtoPtr deserializes with this, chunk tiles resolve tile prototype ids with this
     inline PrototypeManager* active_prototype_manager    = nullptr;
     inline UniqueDataManager* active_unique_data_manager = nullptr;
 
+    /// Version of save being deserialized, types whose serialized format changed use this to load older saves
+    /// Set by GameController::LoadGame, kSaveVersion otherwise
+    inline SaveVersionT active_save_version = kSaveVersion;
+
+    /// Workers chunks are serialized and deserialized on, on the calling thread if nullptr
+    /// Set by GameController while saving and loading
+    inline ThreadPool* active_thread_pool = nullptr;
+
+    /// Chunks which can be copied are encoded later into this save instead of while serializing, if not nullptr
+    /// Set by GameController::SaveGameAsync
+    inline DeferredSave* active_deferred_save = nullptr;
+
 } // namespace jactorio::data
 
 #endif // JACTORIO_INCLUDE_DATA_GLOBALS_H
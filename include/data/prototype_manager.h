@@ -13,6 +13,11 @@
 #include "proto/detail/category.h"
 #include "proto/framework/framework_base.h"
 
+namespace jactorio::proto
+{
+    class FWorldObject;
+}
+
 namespace jactorio::data
 {
     template <typename TProto>
@@ -133,6 +138,18 @@ namespace jactorio::data
         J_NODISCARD const TProto& RelocationTableGet(PrototypeIdT prototype_id) const noexcept;
 
 
+        // Chunk tiles store a 16 bit tile prototype id in place of a prototype pointer
+        // World objects are assigned an id when added, alongside their internal id. Tiles resolve ids with
+        // active_prototype_manager
+
+        /// \return Prototype with tile prototype id, nullptr if 0
+        J_NODISCARD const proto::FWorldObject* TilePrototypeGet(
+            const TilePrototypeIdT tile_prototype_id) const noexcept {
+            assert(tile_prototype_id < tilePrototypeTable_.size());
+            return tilePrototypeTable_[tile_prototype_id];
+        }
+
+
         J_NODISCARD DebugInfo GetDebugInfo() const;
 
     private:
@@ -153,6 +170,9 @@ namespace jactorio::data
 
         RelocationTableContainerT relocationTable_;
 
+        /// World objects at their tile prototype id, index 0 is always nullptr
+        std::vector<const proto::FWorldObject*> tilePrototypeTable_{nullptr};
+
 
         /// Internal id which will be assigned to the next prototype added
         PrototypeIdT internalIdNew_ = kInternalIdStart_;
@@ -4,7 +4,13 @@
 #define JACTORIO_INCLUDE_DATA_SAVE_GAME_MANAGER_H
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "jactorio.h"
 
@@ -21,6 +27,38 @@ namespace jactorio::game
 
 namespace jactorio::data
 {
+    using SaveVersionT = uint32_t;
+
+    // Save format versions, when the serialized format changes, add a version and update kSaveVersion
+
+    /// Saves made before the save header was introduced
+    constexpr SaveVersionT kSaveVersionLegacy = 0;
+    /// Conveyor distances and inserter rotations stored as a fixed point integer instead of a decimal integer and
+    /// fraction pair
+    constexpr SaveVersionT kSaveVersionFixedPoint = 1;
+    /// Deferral timer stores callbacks in slots instead of a map of game tick to callbacks
+    constexpr SaveVersionT kSaveVersionDeferralSlots = 2;
+    /// Tex coord ids stored with each chunk instead of in a grid spanning all chunks of a world
+    constexpr SaveVersionT kSaveVersionChunkTexCoords = 3;
+    /// Resource amounts stored in an array with each chunk instead of as unique data of each resource tile
+    constexpr SaveVersionT kSaveVersionResourceAmounts = 4;
+    /// Chunks modified since the save was written may be appended to the save as increments
+    constexpr SaveVersionT kSaveVersionIncremental = 5;
+    /// Chunks serialized independently into buffers listed in a directory, encoded and decoded in parallel
+    constexpr SaveVersionT kSaveVersionParallelChunks = 6;
+    /// Chunk tiles, tex coord ids and resource amounts stored as run length encoded columns instead of tile by tile
+    constexpr SaveVersionT kSaveVersionColumnarChunks = 7;
+    /// Chunk directory marks chunks which can be decoded after the rest of the save is loaded
+    constexpr SaveVersionT kSaveVersionLazyChunks = 8;
+    /// Fixed point values stored as 64 bit integers instead of 32 bit
+    constexpr SaveVersionT kSaveVersionWideFixedPoint = 9;
+    /// Save increments followed by a checksum of the increment
+    constexpr SaveVersionT kSaveVersionIncrementChecksums = 10;
+
+    /// Version new saves are written with
+    constexpr SaveVersionT kSaveVersion = kSaveVersionIncrementChecksums;
+
+
     J_NODISCARD bool IsValidSaveName(const std::string& save_name);
 
     /// \param save_name No path, no extensions
@@ -29,6 +67,50 @@ namespace jactorio::data
     /// Iterator to save directory, directory itself is always valid
     J_NODISCARD std::filesystem::directory_iterator GetSaveDirIt();
 
+
+    /// Writes identifier and kSaveVersion, call before serializing the game
+    void WriteSaveHeader(std::ostream& os);
+
+    /// Reads header written by WriteSaveHeader, stream is left at the start of the serialized game
+    /// \return Version of save, kSaveVersionLegacy if save has no header
+    /// \exception std::runtime_error Save was made by a newer version
+    J_NODISCARD SaveVersionT ReadSaveHeader(std::istream& is);
+
+
+    /// Writes increment of serialized game to be appended after a save, followed by its checksum
+    void WriteSaveIncrement(std::ostream& os, const std::string& increment);
+
+    /// Reads increment written by WriteSaveIncrement
+    /// \param increment Set to increment read
+    /// \param version Version of the save the increment was appended to
+    /// \return false if there are no more increments, an increment cut off part way or not matching its checksum,
+    /// e.g: by a crash while writing, is not read
+    bool ReadSaveIncrement(std::istream& is, std::string& increment, SaveVersionT version = kSaveVersion);
+
+
+    /// Save written on the calling thread, with parts which are slow to encode left to encode later on another thread
+    class DeferredSave
+    {
+    public:
+        /// Save is written here, parts are deferred at the current position
+        J_NODISCARD std::ostream& Stream() noexcept {
+            return stream_;
+        }
+
+        /// Inserts bytes returned by encode at the current position of Stream
+        /// \param encode Called by Finish, must only use data it owns
+        void Defer(std::function<std::string()> encode);
+
+        /// Calls each deferred encode, may be called from any thread once the save is written
+        /// \return Save with encoded parts inserted
+        J_NODISCARD std::string Finish();
+
+    private:
+        std::ostringstream stream_{std::ios_base::binary};
+        std::vector<std::pair<std::size_t, std::function<std::string()>>> deferred_;
+    };
+
+
 } // namespace jactorio::data
 
 #endif // JACTORIO_INCLUDE_DATA_SAVE_GAME_MANAGER_H
@@ -4,6 +4,11 @@
 #define JACTORIO_INCLUDE_DATA_UNIQUE_DATA_MANAGER_H
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "proto/framework/framework_base.h"
@@ -29,12 +34,23 @@ namespace jactorio::data
         // 1. Deserialize all unique data first, call StoreRelocationEntry() with each
         // 2. Call RelocationTableGet with serialized id to retrieve unique data
 
+        // AssignId and StoreRelocationEntry may be called from multiple threads, chunks are serialized in parallel
+
         void AssignId(proto::UniqueDataBase& unique_data) noexcept;
 
         void StoreRelocationEntry(proto::UniqueDataBase& unique_data);
         J_NODISCARD proto::UniqueDataBase& RelocationTableGet(UniqueDataIdT id) const noexcept;
 
 
+        /// Objects shared between chunks are serialized with each chunk, deserialized copies with the same key are
+        /// replaced by the first copy stored
+        /// \param key Identifies the object within the save, e.g: its address when saved
+        /// \return First object stored with key
+        /// \remark Thread safe
+        template <typename T>
+        J_NODISCARD std::shared_ptr<T> StoreSharedEntry(uint64_t key, std::shared_ptr<T> shared);
+
+
         /// Clears the relocation table
         void Clear() noexcept;
 
@@ -47,9 +63,23 @@ namespace jactorio::data
             DataEntriesT& dataEntries;
         };
 
-        UniqueDataIdT nextId_ = kDefaultId;
+        std::atomic<UniqueDataIdT> nextId_ = kDefaultId;
+
+        std::mutex entriesMutex_;
         DataEntriesT dataEntries_;
+        std::unordered_map<uint64_t, std::shared_ptr<void>> sharedEntries_;
     };
+
+    template <typename T>
+    std::shared_ptr<T> UniqueDataManager::StoreSharedEntry(const uint64_t key, std::shared_ptr<T> shared) {
+        std::lock_guard<std::mutex> guard(entriesMutex_);
+
+        const auto [it, inserted] = sharedEntries_.try_emplace(key, shared);
+        if (inserted)
+            return shared;
+
+        return std::static_pointer_cast<T>(it->second);
+    }
 } // namespace jactorio::data
 
 #endif // JACTORIO_INCLUDE_DATA_UNIQUE_DATA_MANAGER_H
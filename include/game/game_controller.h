@@ -4,6 +4,12 @@
 #define JACTORIO_INCLUDE_GAME_GAME_CONTROLLER_H
 #pragma once
 
+#include <chrono>
+#include <future>
+#include <iosfwd>
+#include <string>
+
+#include "core/thread_pool.h"
 #include "data/prototype_manager.h"
 #include "data/unique_data_manager.h"
 #include "game/event/event.h"
@@ -21,8 +27,18 @@ namespace jactorio::game
     {
         static constexpr auto kDefaultWorldCount = 1;
 
+        /// Logic thread time per tick for adding generated chunks to worlds
+        static constexpr auto kChunkGenBudget = std::chrono::microseconds(2000);
+
         static constexpr auto kSettingsPath = "settings.json";
 
+        /// Increments appended to a save by SaveGameAsync before the save is written in full again
+        static constexpr auto kMaxSaveIncrements = 8;
+
+        /// Chunks within this many chunks of the player are decoded by LoadGame, chunks which nothing outside
+        /// themselves refer to are otherwise decoded once needed
+        static constexpr ChunkCoordAxis kLoadChunkRadius = 4;
+
     public:
         /// \param h_render_controller handle to render controller
         explicit GameController(render::RenderController** h_render_controller)
@@ -53,6 +69,11 @@ namespace jactorio::game
         GameInput input;
         EventData event;
 
+        /// Workers for logic updates and chunk generation
+        /// Shared so both together do not use more threads than the hardware has, logic updates run ahead of chunks
+        /// generating across multiple logic updates
+        ThreadPool threadPool;
+
         // Serialized settings
 
         // Initializing this is a big pain in the rear because of what it requires
@@ -78,6 +99,23 @@ namespace jactorio::game
         /// \exception std::runtime_error Failed to save
         void SaveGame(const char* save_name) const;
 
+        /// Serializes game to memory on the calling thread, then writes it to the save file on a background thread
+        /// while the game continues to update. Chunks without unique data are only copied on the calling thread,
+        /// they are encoded on the background thread
+        ///
+        /// If the game was last saved or loaded with save_name, only chunks modified since are appended to the save,
+        /// the save is written in full every kMaxSaveIncrements saves
+        /// \param save_name name of save, no extensions. E.g: "first world"
+        /// \exception std::runtime_error Failed to write previous save started with SaveGameAsync
+        void SaveGameAsync(const char* save_name);
+
+        /// \return true if a save started with SaveGameAsync is still being written
+        J_NODISCARD bool IsSaving() const;
+
+        /// Waits until save started with SaveGameAsync is written, no effect if none
+        /// \exception std::runtime_error Failed to write save
+        void WaitSaveGame();
+
         /// \param save_name name of save, no extensions. E.g: "first world"
         /// \exception std::runtime_error Failed to load
         void LoadGame(const char* save_name);
@@ -86,6 +124,25 @@ namespace jactorio::game
         /// \return false if error
         J_NODISCARD bool InitPrototypes();
 
+        /// Writes save header, then the serialized game to os
+        void WriteGame(std::ostream& os) const;
+
+        /// Writes chunks modified since worlds were last saved and all data outside chunks to os
+        void WriteGameIncrement(std::ostream& os) const;
+
+        /// Applies increment written by WriteGameIncrement
+        /// \exception std::runtime_error Increment does not match game
+        void ReadGameIncrement(std::istream& is);
+
+        /// Save being written by SaveGameAsync
+        std::future<void> pendingSave_;
+
+        /// Save matching the game when worlds were last marked saved, increments can be appended to it
+        /// Empty if the next save must be written in full
+        std::string incrementalSave_;
+        /// Increments appended to incrementalSave_
+        int saveIncrements_ = 0;
+
 
         template <typename T>
         void SerializeSetting(T& archive) {
@@ -0,0 +1,76 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ACTIVE_SET_H
+#define JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ACTIVE_SET_H
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "jactorio.h"
+
+#include "game/logic/conveyor_struct.h"
+
+namespace jactorio::game
+{
+    /// Sleeping conveyors which were woken, may be appended to from multiple threads
+    class ConveyorWakeList
+    {
+    public:
+        /// Conveyor may be destroyed before it is taken, compare conveyor against the logic group before using it
+        struct Entry
+        {
+            /// Logic index of conveyor when woken
+            std::size_t logicIndex;
+            ConveyorStruct* conveyor;
+        };
+
+        void Push(ConveyorStruct& con_struct) {
+            std::lock_guard guard(mutex_);
+            woken_.push_back({con_struct.GetLogicIndex(), &con_struct});
+        }
+
+        /// Removes all woken conveyors
+        /// \return Ordered by logic index, independent of the order conveyors were woken in
+        J_NODISCARD std::vector<Entry> Take() {
+            std::vector<Entry> woken;
+            {
+                std::lock_guard guard(mutex_);
+                woken.swap(woken_);
+            }
+
+            std::sort(woken.begin(), woken.end(), [](const Entry& lhs, const Entry& rhs) {
+                return lhs.logicIndex < rhs.logicIndex;
+            });
+            return woken;
+        }
+
+        void Clear() {
+            std::lock_guard guard(mutex_);
+            woken_.clear();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<Entry> woken_;
+    };
+
+    /// Conveyors of LogicGroup::conveyor which can move items, maintained by ConveyorLogicUpdate
+    struct ConveyorActiveSet
+    {
+        /// Indices into conveyor logic group, in order of update
+        std::vector<std::size_t> active;
+        ConveyorWakeList woken;
+        /// Logic group was replaced, all conveyors are rescheduled
+        bool stale = true;
+        /// Logic indices of conveyors registered, or moved into the slot of a removed conveyor since the last update
+        std::vector<std::size_t> changed;
+
+        /// Node of each conveyor in logic group while finding components, unused entries are npos
+        std::vector<std::size_t> componentNode;
+    };
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ACTIVE_SET_H
@@ -4,12 +4,24 @@
 #define JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_CONTROLLER_H
 #pragma once
 
+#include <cstddef>
+
+namespace jactorio
+{
+    class ThreadPool;
+}
+
 namespace jactorio::game
 {
     class World;
 
     /// Updates belt logic for a logic chunk
     void ConveyorLogicUpdate(World& world);
+
+    /// Updates belt logic for a logic chunk, conveyors which do not feed into each other are updated in parallel
+    /// Results are identical to ConveyorLogicUpdate(World&)
+    /// \param min_parallel Active conveyors below this are updated on the calling thread
+    void ConveyorLogicUpdate(World& world, ThreadPool& pool, std::size_t min_parallel = 2048);
 } // namespace jactorio::game
 
 #endif // JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_CONTROLLER_H
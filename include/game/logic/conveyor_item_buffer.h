@@ -0,0 +1,273 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ITEM_BUFFER_H
+#define JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ITEM_BUFFER_H
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "jactorio.h"
+
+#include "core/convert.h"
+#include "data/cereal/serialization_type.h"
+#include "data/cereal/support/fixed_point.h"
+#include "proto/detail/type.h"
+#include "proto/item.h"
+
+#include <cereal/cereal.hpp>
+
+namespace jactorio::game
+{
+    /// Item on a conveyor
+    /// Tile distance from next item or end of conveyor, pointer to item
+    struct ConveyorItem
+    {
+        ConveyorItem() = default;
+
+        ConveyorItem(const proto::LineDistT& line_dist, const proto::Item* item_ptr)
+            : dist(line_dist), item(item_ptr) {}
+
+        proto::LineDistT dist;
+        data::SerialProtoPtr<const proto::Item> item;
+
+
+        CEREAL_SERIALIZE(archive) {
+            archive(dist, item);
+        }
+    };
+
+    /// Items of a conveyor lane, front is the item closest to the end of the conveyor
+    ///
+    /// Ring buffer, distances and items are kept in separate contiguous arrays
+    /// such that walking the distances of a lane does not load the item pointers
+    /// Indices are relative to the front, and remain valid until an item is inserted or erased before it
+    class ConveyorItemBuffer
+    {
+        using ItemPtrT = data::SerialProtoPtr<const proto::Item>;
+
+        /// Smallest capacity allocated when the first item is added
+        static constexpr std::size_t kMinCapacity = 4;
+
+    public:
+        // Adopt stl naming to be drop in replacement for std::deque<ConveyorItem>
+        // ReSharper disable CppInconsistentNaming
+
+        using size_type = std::size_t;
+
+        /// Refers to a distance and item stored in the buffer
+        template <typename TDist, typename TItem>
+        struct BasicReference
+        {
+            TDist& dist;
+            TItem& item;
+
+            // ReSharper disable once CppNonExplicitConversionOperator
+            operator ConveyorItem() const {
+                return {dist, item.Get()};
+            }
+        };
+
+        using reference       = BasicReference<proto::LineDistT, ItemPtrT>;
+        using const_reference = BasicReference<const proto::LineDistT, const ItemPtrT>;
+
+        template <typename TBuffer, typename TReference>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = ConveyorItem;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = TReference;
+
+            Iterator(TBuffer& buffer, const size_type index) noexcept : buffer_(&buffer), index_(index) {}
+
+            reference operator*() const {
+                return (*buffer_)[index_];
+            }
+
+            Iterator& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept {
+                auto prev = *this;
+                ++index_;
+                return prev;
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+                return lhs.index_ == rhs.index_ && lhs.buffer_ == rhs.buffer_;
+            }
+
+            friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+
+        private:
+            TBuffer* buffer_;
+            size_type index_;
+        };
+
+        using iterator       = Iterator<ConveyorItemBuffer, reference>;
+        using const_iterator = Iterator<const ConveyorItemBuffer, const_reference>;
+
+
+        // ======================================================================
+        // Access
+
+        J_NODISCARD reference operator[](const size_type index) noexcept {
+            assert(index < size_);
+            const auto i = PhysicalIndex(index);
+            return {dist_[i], item_[i]};
+        }
+
+        J_NODISCARD const_reference operator[](const size_type index) const noexcept {
+            assert(index < size_);
+            const auto i = PhysicalIndex(index);
+            return {dist_[i], item_[i]};
+        }
+
+        J_NODISCARD reference front() noexcept {
+            return (*this)[0];
+        }
+        J_NODISCARD const_reference front() const noexcept {
+            return (*this)[0];
+        }
+
+        J_NODISCARD reference back() noexcept {
+            return (*this)[size_ - 1];
+        }
+        J_NODISCARD const_reference back() const noexcept {
+            return (*this)[size_ - 1];
+        }
+
+
+        J_NODISCARD iterator begin() noexcept {
+            return {*this, 0};
+        }
+        J_NODISCARD iterator end() noexcept {
+            return {*this, size_};
+        }
+
+        J_NODISCARD const_iterator begin() const noexcept {
+            return {*this, 0};
+        }
+        J_NODISCARD const_iterator end() const noexcept {
+            return {*this, size_};
+        }
+
+        J_NODISCARD const_iterator cbegin() const noexcept {
+            return begin();
+        }
+        J_NODISCARD const_iterator cend() const noexcept {
+            return end();
+        }
+
+
+        // ======================================================================
+        // Capacity
+
+        J_NODISCARD bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        J_NODISCARD size_type size() const noexcept {
+            return size_;
+        }
+
+        J_NODISCARD size_type capacity() const noexcept {
+            return dist_.size();
+        }
+
+        /// Capacity is rounded up to a power of 2
+        void reserve(size_type new_cap);
+
+
+        // ======================================================================
+        // Modifiers
+
+        void clear() noexcept {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        void push_back(const ConveyorItem& item) {
+            emplace_back(item.dist, item.item.Get());
+        }
+
+        void emplace_back(const proto::LineDistT& dist, const proto::Item* item);
+
+        void push_front(const ConveyorItem& item) {
+            emplace_front(item.dist, item.item.Get());
+        }
+
+        void emplace_front(const proto::LineDistT& dist, const proto::Item* item);
+
+        void pop_front() noexcept {
+            assert(size_ > 0);
+            head_ = PhysicalIndex(1);
+            --size_;
+        }
+
+        void pop_back() noexcept {
+            assert(size_ > 0);
+            --size_;
+        }
+
+        /// Inserts before index, items at and after index are shifted back by 1
+        void insert(size_type index, const proto::LineDistT& dist, const proto::Item* item);
+
+        /// Items after index are shifted forwards by 1
+        void erase(size_type index) noexcept;
+
+        // ReSharper restore CppInconsistentNaming
+
+
+        CEREAL_SAVE(archive) {
+            // Same format as std::deque<ConveyorItem>
+            archive(cereal::make_size_tag(static_cast<cereal::size_type>(size_)));
+            for (const ConveyorItem item : *this) {
+                archive(item);
+            }
+        }
+
+        CEREAL_LOAD(archive) {
+            cereal::size_type size;
+            archive(cereal::make_size_tag(size));
+
+            clear();
+            reserve(SafeCast<size_type>(size));
+            for (cereal::size_type i = 0; i < size; ++i) {
+                ConveyorItem item;
+                archive(item);
+                push_back(item);
+            }
+        }
+
+    private:
+        J_NODISCARD size_type PhysicalIndex(const size_type index) const noexcept {
+            // Capacity is always a power of 2
+            return (head_ + index) & (capacity() - 1);
+        }
+
+        /// Doubles capacity if full
+        void GrowIfFull();
+
+        /// Copies item at physical index from to physical index to
+        void MoveItem(size_type from, size_type to) noexcept;
+
+        std::vector<proto::LineDistT> dist_;
+        std::vector<ItemPtrT> item_;
+
+        /// Physical index of front item
+        size_type head_ = 0;
+        size_type size_ = 0;
+    };
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_ITEM_BUFFER_H
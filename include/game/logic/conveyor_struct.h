@@ -4,46 +4,29 @@
 #define JACTORIO_INCLUDE_GAME_LOGIC_CONVEYOR_STRUCT_H
 #pragma once
 
-#include <deque>
+#include <cstddef>
+#include <limits>
+#include <vector>
 
 #include "core/orientation.h"
-#include "data/cereal/serialization_type.h"
-#include "data/cereal/support/decimal.h"
+#include "data/cereal/support/fixed_point.h"
+#include "game/logic/conveyor_item_buffer.h"
 #include "game/logic/conveyor_prop.h"
 #include "proto/detail/type.h"
 #include "proto/item.h"
 
-#include <cereal/types/deque.hpp>
-
 namespace jactorio::game
 {
+    class ConveyorWakeList;
+
     // Each item's distance (in tiles) to the next item or the end of this conveyor segment
     // Items closest to the end are stored at the front
     // See FFF 176 https://factorio.com/blog/post/fff-176
 
-    /// Item on a conveyor
-    /// Tile distance from next item or end of conveyor, pointer to item
-    struct ConveyorItem
-    {
-        ConveyorItem() = default;
-
-        ConveyorItem(const proto::LineDistT& line_dist, const proto::Item* item_ptr)
-            : dist(line_dist), item(item_ptr) {}
-
-        proto::LineDistT dist;
-        data::SerialProtoPtr<const proto::Item> item;
-
-
-        CEREAL_SERIALIZE(archive) {
-            archive(dist, item);
-        }
-    };
-
     /// One side of a conveyor
     struct ConveyorLane
     {
-        using IntOffsetT   = int16_t;
-        using FloatOffsetT = double;
+        using IntOffsetT = int16_t;
 
         /// \return true if left size is not empty and has a valid index
         J_NODISCARD bool IsActive() const;
@@ -55,19 +38,23 @@ namespace jactorio::game
         // Item insertion
         // See ConveyorSegment for function documentation
 
-        void AppendItem(FloatOffsetT offset, const proto::Item& item);
+        void AppendItem(proto::LineDistT offset, const proto::Item& item);
+
+        void InsertItem(proto::LineDistT offset, const proto::Item& item, IntOffsetT item_offset);
 
-        void InsertItem(FloatOffsetT offset, const proto::Item& item, IntOffsetT item_offset);
+        bool TryInsertItem(const proto::LineDistT& offset, const proto::Item& item, IntOffsetT item_offset);
 
-        bool TryInsertItem(FloatOffsetT offset, const proto::Item& item, IntOffsetT item_offset);
+        J_NODISCARD std::pair<size_t, ConveyorItem> GetItem(const proto::LineDistT& offset,
+                                                            const proto::LineDistT& epsilon = kItemEpsilon) const;
+        const proto::Item* TryPopItem(const proto::LineDistT& offset,
+                                      const proto::LineDistT& epsilon = kItemEpsilon);
 
-        J_NODISCARD std::pair<size_t, ConveyorItem> GetItem(FloatOffsetT offset,
-                                                            FloatOffsetT epsilon = ConveyorProp::kItemWidth / 2) const;
-        const proto::Item* TryPopItem(FloatOffsetT offset, FloatOffsetT epsilon = ConveyorProp::kItemWidth / 2);
+        /// Default distance from offset which items are found within
+        static constexpr proto::LineDistT kItemEpsilon{ConveyorProp::kItemWidth / 2};
 
         // ======================================================================
 
-        std::deque<ConveyorItem> lane;
+        ConveyorItemBuffer lane;
 
         /// Index of active item within lane
         uint16_t index = 0;
@@ -91,8 +78,7 @@ namespace jactorio::game
         using SegmentLengthT = uint8_t;
 
     public:
-        using IntOffsetT   = ConveyorLane::IntOffsetT;
-        using FloatOffsetT = ConveyorLane::FloatOffsetT;
+        using IntOffsetT = ConveyorLane::IntOffsetT;
 
         enum class TerminationType
         {
@@ -110,13 +96,25 @@ namespace jactorio::game
         ConveyorStruct(const Orientation direction,
                        const TerminationType termination_type,
                        const uint8_t segment_length)
-            : direction(direction), terminationType(termination_type), length(segment_length) {}
+            : direction(direction), terminationType(termination_type), length(segment_length) {
+            ReserveLanes();
+        }
 
         ConveyorStruct(const Orientation direction,
                        const TerminationType termination_type,
                        ConveyorStruct* target_segment,
                        const uint8_t segment_length)
-            : direction(direction), terminationType(termination_type), length(segment_length), target(target_segment) {}
+            : direction(direction), terminationType(termination_type), length(segment_length), target(target_segment) {
+            ReserveLanes();
+        }
+
+        /// Removes itself from the sleeping feeders of other conveyors
+        ~ConveyorStruct();
+
+        ConveyorStruct(const ConveyorStruct& other)     = delete;
+        ConveyorStruct(ConveyorStruct&& other) noexcept = delete;
+        ConveyorStruct& operator=(const ConveyorStruct& other) = delete;
+        ConveyorStruct& operator=(ConveyorStruct&& other) noexcept = delete;
 
 
         // ======================================================================
@@ -159,29 +157,30 @@ namespace jactorio::game
         /// Appends item onto the specified side of a belt behind the last item
         /// \param offset Number of tiles to offset from previous item or the end of the conveyor segment when
         /// there are no items
-        void AppendItem(bool left_side, FloatOffsetT offset, const proto::Item& item);
+        void AppendItem(bool left_side, const proto::LineDistT& offset, const proto::Item& item);
 
         /// Inserts the item onto the specified belt side at the offset from the beginning of the conveyor
         /// \param offset Distance from beginning of conveyor
-        void InsertItem(bool left_side, FloatOffsetT offset, const proto::Item& item);
+        void InsertItem(bool left_side, const proto::LineDistT& offset, const proto::Item& item);
 
         /// Attempts to insert the item onto the specified belt side at the offset from the beginning of the
         /// conveyor
         /// \param offset Distance from beginning of conveyor
         /// \return false if unsuccessful
-        bool TryInsertItem(bool left_side, FloatOffsetT offset, const proto::Item& item);
+        bool TryInsertItem(bool left_side, const proto::LineDistT& offset, const proto::Item& item);
 
-        /// Finds item at offset within epsilon upper and lower bounds inclusive, <deque index,
+        /// Finds item at offset within epsilon upper and lower bounds inclusive, <lane index,
         /// ConveyorItem> \return .second.second is nullptr if no items were found
-        J_NODISCARD std::pair<size_t, ConveyorItem> GetItem(bool left_side,
-                                                            FloatOffsetT offset,
-                                                            FloatOffsetT epsilon = ConveyorProp::kItemWidth / 2) const;
+        J_NODISCARD std::pair<size_t, ConveyorItem> GetItem(
+            bool left_side,
+            const proto::LineDistT& offset,
+            const proto::LineDistT& epsilon = ConveyorLane::kItemEpsilon) const;
 
         /// Finds and removes item at offset within epsilon inclusive
         /// \return nullptr if no items were found
         const proto::Item* TryPopItem(bool left_side,
-                                      FloatOffsetT offset,
-                                      FloatOffsetT epsilon = ConveyorProp::kItemWidth / 2);
+                                      const proto::LineDistT& offset,
+                                      const proto::LineDistT& epsilon = ConveyorLane::kItemEpsilon);
 
 
         // Item insertion with itemOffset
@@ -192,9 +191,9 @@ namespace jactorio::game
 
         J_NODISCARD bool CanInsertAbs(bool left_side, const proto::LineDistT& start_offset);
 
-        void InsertItemAbs(bool left_side, FloatOffsetT offset, const proto::Item& item);
+        void InsertItemAbs(bool left_side, const proto::LineDistT& offset, const proto::Item& item);
 
-        bool TryInsertItemAbs(bool left_side, FloatOffsetT offset, const proto::Item& item);
+        bool TryInsertItemAbs(bool left_side, const proto::LineDistT& offset, const proto::Item& item);
 
 
         /// Adjusts provided value such that InsertItem(, offset, ) is at the correct location
@@ -204,7 +203,52 @@ namespace jactorio::game
         /// results in the same location regardless of the segment length.
         /// \param val Distance from beginning of conveyor segment
         void GetOffsetAbs(IntOffsetT& val) const;
-        void GetOffsetAbs(FloatOffsetT& val) const;
+        void GetOffsetAbs(proto::LineDistT& val) const;
+
+
+        // Sleeping
+        // Conveyors which cannot move any items are excluded from logic updates until woken, see ConveyorLogicUpdate
+
+        /// Logic index of conveyors not yet given one
+        static constexpr auto kNoLogicIndex = std::numeric_limits<std::size_t>::max();
+
+        /// Excludes this conveyor from logic updates until woken
+        /// \param wake_list Conveyor appends itself here when woken
+        void Sleep(ConveyorWakeList& wake_list) noexcept;
+
+        /// Appends this conveyor to its wake list if sleeping, no effect if awake
+        /// \remark Item insertion and removal methods wake the conveyor, call after any other change to this conveyor
+        void Wake();
+
+        /// Wakes conveyors which went to sleep as they are blocked by this conveyor
+        void WakeFeeders();
+
+        /// Feeder is woken alongside this conveyor
+        /// \remark Feeder must not be a sleeping feeder of another conveyor, see LeaveSleepingFeeders
+        void AddSleepingFeeder(ConveyorStruct& feeder);
+
+        /// Removes this conveyor from the sleeping feeders of the conveyor it slept on, if any
+        /// \remark Modifies the other conveyor, not thread safe
+        void LeaveSleepingFeeders() noexcept;
+
+        /// Forgets sleep state without waking, conveyor is considered awake
+        /// Used when logic updates for all conveyors are rescheduled
+        /// \param logic_index Index of this conveyor within its logic group
+        void ResetSleep(std::size_t logic_index) noexcept;
+
+        J_NODISCARD bool IsSleeping() const noexcept {
+            return sleeping_;
+        }
+
+        /// Updates index within logic group without changing sleep state
+        void SetLogicIndex(const std::size_t logic_index) noexcept {
+            logicIndex_ = logic_index;
+        }
+
+        /// \return Index within logic group provided to ResetSleep or SetLogicIndex, kNoLogicIndex if none
+        J_NODISCARD std::size_t GetLogicIndex() const noexcept {
+            return logicIndex_;
+        }
 
 
         // ======================================================================
@@ -253,6 +297,24 @@ namespace jactorio::game
 
             archive(construct->left, construct->right, construct->headOffset, construct->sideInsertIndex);
         }
+
+    private:
+        /// Sized for one item per tile, lanes grow if items are more compressed
+        void ReserveLanes() {
+            left.lane.reserve(length);
+            right.lane.reserve(length);
+        }
+
+        // Sleep state is not serialized, all conveyors are awake after loading
+
+        bool sleeping_              = false;
+        std::size_t logicIndex_     = kNoLogicIndex;
+        ConveyorWakeList* wakeList_ = nullptr;
+
+        /// Sleeping conveyors blocked by this conveyor
+        std::vector<ConveyorStruct*> sleepingFeeders_;
+        /// Conveyor whose sleepingFeeders_ holds this conveyor
+        ConveyorStruct* sleptOn_ = nullptr;
     };
 
     template <bool IsLeftLane>
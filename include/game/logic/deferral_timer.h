@@ -4,7 +4,11 @@
 #define JACTORIO_INCLUDE_GAME_LOGIC_DEFERRAL_TIMER_H
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "jactorio.h"
@@ -12,6 +16,7 @@
 #include "core/data_type.h"
 #include "data/cereal/serialization_type.h"
 #include "data/cereal/serialize.h"
+#include "data/globals.h"
 #include "proto/framework/entity.h"
 
 namespace jactorio::game
@@ -19,11 +24,35 @@ namespace jactorio::game
     class Logic;
 
     /// Manages deferrals, prototypes inheriting 'Deferred'
+    ///
+    /// Registered callbacks are kept in slots, removed slots are reused by later registrations
+    /// Slots are placed into a hierarchical timing wheel by their due tick, each level has kBucketCount buckets
+    /// with each bucket of a level spanning kBucketCount times the ticks of the level below.
+    /// Buckets of higher levels are moved to lower levels as the game tick approaches, at level 0 each bucket
+    /// holds the callbacks of a single game tick
     class DeferralTimer
     {
         using DeferPrototypeT  = proto::FEntity;
         using DeferUniqueDataT = proto::FEntityData;
 
+        using SlotIndexT = uint32_t;
+
+        static constexpr SlotIndexT kNoSlot = UINT32_MAX;
+
+        static constexpr int kBucketBits          = 8;
+        static constexpr std::size_t kBucketCount = 1 << kBucketBits;
+        static constexpr GameTickT kBucketMask    = kBucketCount - 1;
+        static constexpr int kLevelCount          = 4;
+
+        /// Callbacks due further than the highest level can hold
+        static constexpr SlotIndexT kOverflowBucket = kBucketCount * kLevelCount;
+        /// Slot is free or not in a bucket
+        static constexpr SlotIndexT kNoBucket = kOverflowBucket + 1;
+        /// Slot is due this tick and awaiting its callback
+        static constexpr SlotIndexT kDispatchBucket = kOverflowBucket + 2;
+
+        using BucketsT = std::array<SlotIndexT, kBucketCount * kLevelCount + 1>;
+
         struct CallbackContainerEntry
         {
             data::SerialProtoPtr<const DeferPrototypeT> prototype;
@@ -35,10 +64,38 @@ namespace jactorio::game
             }
         };
 
-        using CallbackContainerT = std::unordered_map<GameTickT, std::vector<CallbackContainerEntry>>;
+        struct CallbackSlot
+        {
+            /// nullptr if slot is free
+            data::SerialProtoPtr<const DeferPrototypeT> prototype;
+            data::SerialUniqueDataPtr<proto::UniqueDataBase> uniqueData;
+            GameTickT dueTick = 0;
+            /// Incremented when freed, entries to the previous use of this slot no longer match
+            uint32_t generation = 0;
+
+            // Not serialized
+
+            /// Next slot in bucket, or next free slot
+            SlotIndexT next   = kNoSlot;
+            SlotIndexT prev   = kNoSlot;
+            SlotIndexT bucket = kNoBucket;
+
+
+            CEREAL_SERIALIZE(archive) {
+                archive(prototype, uniqueData, dueTick, generation);
+            }
+        };
+
+        /// Bits [0, 32) is slot + 1, bits [32, 63) is generation of slot, 0 indicates invalid callback
+        /// Bit 63 is set if index is the position in due tick of saves prior to kSaveVersionDeferralSlots
+        using CallbackIndex = uint64_t;
+
+        static constexpr CallbackIndex kLegacyIndexFlag = CallbackIndex(1) << 63;
+        static constexpr uint32_t kGenerationMask       = UINT32_MAX >> 1;
 
-        /// 0 indicates invalid callback
-        using CallbackIndex = CallbackContainerT::size_type;
+        /// Callback indices of callbacks loaded from saves prior to kSaveVersionDeferralSlots, for each due tick in the
+        /// order callbacks were registered. Removed once due tick passes
+        using LegacySlotsT = std::unordered_map<GameTickT, std::vector<CallbackIndex>>;
 
         struct DebugInfo;
 
@@ -55,7 +112,15 @@ namespace jactorio::game
             }
 
 
-            CEREAL_SERIALIZE(archive) {
+            CEREAL_LOAD(archive) {
+                archive(dueTick, callbackIndex);
+
+                if (data::active_save_version < data::kSaveVersionDeferralSlots && callbackIndex != 0) {
+                    callbackIndex |= kLegacyIndexFlag;
+                }
+            }
+
+            CEREAL_SAVE(archive) {
                 archive(dueTick, callbackIndex);
             }
 
@@ -64,6 +129,7 @@ namespace jactorio::game
         };
 
         /// Calls all deferred callbacks for the current game tick
+        /// Callbacks of skipped game ticks since the previous update are called in order
         /// \param game_tick Current game tick
         void DeferralUpdate(Logic& logic, World& world, GameTickT game_tick);
 
@@ -84,6 +150,7 @@ namespace jactorio::game
                                        GameTickT elapse_game_tick);
 
         /// Removes registered callback at game_tick at index
+        /// No effect if the callback was already called or removed
         void RemoveDeferral(DeferralEntry entry);
 
         /// Removes registered callback and sets entry index to 0
@@ -93,48 +160,93 @@ namespace jactorio::game
         J_NODISCARD DebugInfo GetDebugInfo() const;
 
 
-        CEREAL_SERIALIZE(archive) {
-            archive(callbacks_, lastGameTick_);
+        CEREAL_LOAD(archive) {
+            if (data::active_save_version < data::kSaveVersionDeferralSlots) {
+                std::unordered_map<GameTickT, std::vector<CallbackContainerEntry>> callbacks;
+                archive(callbacks, lastGameTick_);
+                LoadLegacyCallbacks(callbacks);
+                return;
+            }
+
+            archive(slots_, legacySlots_, lastGameTick_);
+            RebuildWheel();
+        }
+
+        CEREAL_SAVE(archive) {
+            archive(slots_, legacySlots_, lastGameTick_);
         }
 
     private:
-        CallbackContainerT callbacks_;
+        J_NODISCARD static constexpr BucketsT MakeEmptyBuckets() noexcept {
+            BucketsT buckets{};
+            for (auto& bucket : buckets) {
+                bucket = kNoSlot;
+            }
+            return buckets;
+        }
 
-        GameTickT lastGameTick_ = 0;
+        J_NODISCARD static constexpr CallbackIndex MakeCallbackIndex(const SlotIndexT slot,
+                                                                     const uint32_t generation) noexcept {
+            return static_cast<CallbackIndex>(generation) << 32 | (static_cast<CallbackIndex>(slot) + 1);
+        }
 
-        /// Used to fill the gap when a callback has been removed
-        class BlankCallback final : public proto::FEntity
-        {
+        /// \return Slot index of registered callback for entry, kNoSlot if entry does not refer to a registered callback
+        J_NODISCARD SlotIndexT FindSlot(const DeferralEntry& entry) const;
 
-        public:
-            PROTOTYPE_CATEGORY(none);
-            void PostLoadValidate(const data::PrototypeManager& /*proto*/) const override {}
+        /// \return Slot holding callback, slot is placed into the wheel
+        SlotIndexT AllocateSlot(const DeferPrototypeT* prototype,
+                                proto::UniqueDataBase* unique_data,
+                                GameTickT due_game_tick);
+        /// Slot must not be in a bucket
+        void FreeSlot(SlotIndexT slot) noexcept;
 
-            SpriteTexCoordIndexT OnGetTexCoordId(const World& /*world*/,
-                                                 const WorldCoord& /*coord*/,
-                                                 Orientation /*orientation*/) const override {
-                return 0;
-            }
+        /// \return Bucket slot at due tick belongs in relative to lastGameTick_
+        J_NODISCARD SlotIndexT GetBucket(GameTickT due_tick) const noexcept;
 
-            bool OnRShowGui(const gui::Context& /*context*/, ChunkTile* /*tile*/) const override {
-                return false;
-            }
+        J_NODISCARD static constexpr std::size_t GetBucketLevel(const SlotIndexT bucket) noexcept {
+            return bucket / kBucketCount;
+        }
+
+        /// \return Game tick after lastGameTick_ where callbacks may be due or buckets cascade
+        J_NODISCARD GameTickT GetNextEventTick() const noexcept;
+
+        /// Adds to bucket by its due tick
+        void LinkSlot(SlotIndexT slot) noexcept;
+        void UnlinkSlot(SlotIndexT slot) noexcept;
+
+        /// Moves slots in bucket to the bucket for their due tick, relative to lastGameTick_
+        void CascadeBucket(SlotIndexT bucket) noexcept;
+
+        /// Calls callbacks due at lastGameTick_
+        void DispatchTick(Logic& logic, World& world);
+
+        /// Recreates buckets and free list from slots
+        void RebuildWheel();
+
+        void LoadLegacyCallbacks(const std::unordered_map<GameTickT, std::vector<CallbackContainerEntry>>& callbacks);
+
+
+        std::vector<CallbackSlot> slots_;
+        LegacySlotsT legacySlots_;
+
+        GameTickT lastGameTick_ = 0;
 
-            void OnDeserialize(World& /*world*/, const WorldCoord& /*coord*/, ChunkTile& /*tile*/) const override {}
+        // Not serialized
 
-            void OnDeferTimeElapsed(World& /*world*/,
-                                    Logic& /*logic*/,
-                                    proto::UniqueDataBase* /*unique_data*/) const override {}
+        /// First slot of each bucket, level 0 buckets followed by level 1 ...
+        BucketsT buckets_            = MakeEmptyBuckets();
+        SlotIndexT freeSlot_         = kNoSlot;
+        std::size_t registeredCount_ = 0;
+        /// Slots in buckets of each level, overflow bucket last
+        std::array<std::size_t, kLevelCount + 1> levelSizes_{};
 
-            void OnTileUpdate(World& /*world*/,
-                              const WorldCoord& /*emit_coord*/,
-                              const WorldCoord& /*receive_coord*/,
-                              proto::UpdateType /*type*/) const override {}
-        } blankCallback_;
+        /// <Prototype id, slot> of callbacks being dispatched, kept to avoid allocating each tick
+        std::vector<std::pair<PrototypeIdT, SlotIndexT>> dispatchSlots_;
 
         struct DebugInfo
         {
-            const CallbackContainerT& callbacks;
+            /// Registered callbacks by due tick
+            std::map<GameTickT, std::vector<CallbackContainerEntry>> callbacks;
         };
     };
 } // namespace jactorio::game
@@ -4,8 +4,8 @@
 #define JACTORIO_INCLUDE_GAME_PLAYER_PLAYER_H
 #pragma once
 
+#include <deque>
 #include <glm/glm.hpp>
-#include <queue>
 #include <utility>
 
 #include "core/coordinate_tuple.h"
@@ -13,6 +13,8 @@
 #include "game/logistic/inventory.h"
 #include "proto/recipe.h"
 
+#include <cereal/types/deque.hpp>
+
 namespace jactorio::game
 {
     class World;
@@ -5,12 +5,16 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "jactorio.h"
 
+#include "core/data_type.h"
 #include "data/cereal/serialize.h"
+#include "data/globals.h"
 #include "game/world/chunk_tile.h"
 #include "game/world/overlay_element.h"
 #include "game/world/tile_layer.h"
@@ -27,24 +31,82 @@ namespace jactorio::game
     ///		overlays: Has no set amount, can exist anywhere on chunk
     class Chunk
     {
+        friend class ChunkTile;
+
     public:
         using OverlayContainerT    = std::vector<OverlayElement>;
         using LogicGroupContainerT = std::vector<ChunkTile*>;
 
-        static constexpr uint8_t kChunkWidth = 32;
+        static constexpr int kChunkWidthShift = 5;
+        static constexpr uint8_t kChunkWidth  = 1 << kChunkWidthShift;
         static constexpr uint16_t kChunkArea = static_cast<uint16_t>(kChunkWidth) * kChunkWidth;
 
+        /// Format: | 0 1 2 | 0 1 2 |
+        ///         <1 tile >
+        /// 0 1 2 are the different layers, layer 0 first
+        /// Kept contiguous for rendering cache locality
+        using TexCoordIdArrayT = std::array<SpriteTexCoordIndexT, kChunkArea * kTileLayerCount>;
+
+        /// Amount of resource remaining on the resource layer of each tile, row by row from the top left
+        /// 0 if tile has no resource
+        using ResourceAmountArrayT = std::array<ResourceEntityResourceCount, kChunkArea>;
+
     private:
         using TileArrayT    = std::array<ChunkTile, kChunkArea>;
         using OverlayArrayT = std::array<OverlayContainerT, kOverlayLayerCount>;
 
+        /// Tiles of all layers, followed by the side table of their unique data and top left
+        struct TileBlock
+        {
+            std::array<TileArrayT, kTileLayerCount> layers;
+            ChunkTile::SideTable sideTable;
+        };
+
+        /// Smallest power of 2 holding tile block, blocks are aligned to their size so tiles find their block
+        /// from their address
+        static constexpr std::size_t TileBlockBytes() {
+            std::size_t bytes = 1;
+            while (bytes < sizeof(TileBlock)) {
+                bytes *= 2;
+            }
+            return bytes;
+        }
+
+        struct TileBlockDeleter
+        {
+            void operator()(TileBlock* block) const noexcept;
+        };
+
     public:
         /// \remark For cereal deserialization only
-        Chunk() = default;
+        Chunk() : tiles_(MakeTileBlock()) {}
         /// Default initialization of chunk tiles
-        explicit Chunk(const ChunkCoord& c_coord) : position_(c_coord) {}
+        explicit Chunk(const ChunkCoord& c_coord) : position_(c_coord), tiles_(MakeTileBlock()) {}
+
+        /// Unique data is copied, top left of multi tiles is not
+        Chunk(const Chunk& other);
+        /// Tiles keep their address
+        Chunk(Chunk&& other) noexcept = default;
+
+        Chunk& operator=(Chunk other) noexcept {
+            swap(*this, other);
+            return *this;
+        }
+
+        friend void swap(Chunk& lhs, Chunk& rhs) noexcept {
+            using std::swap;
+            swap(lhs.overlays, rhs.overlays);
+            swap(lhs.position_, rhs.position_);
+            swap(lhs.tiles_, rhs.tiles_);
+            swap(lhs.texCoordIds_, rhs.texCoordIds_);
+            swap(lhs.resourceAmounts_, rhs.resourceAmounts_);
+            swap(lhs.dirty_, rhs.dirty_);
+        }
 
-        J_NODISCARD static ChunkTileCoordAxis WorldCToChunkTileC(WorldCoordAxis coord);
+        J_NODISCARD static ChunkTileCoordAxis WorldCToChunkTileC(const WorldCoordAxis coord) {
+            // Two's complement, negative coords wrap from the right of the chunk
+            return static_cast<ChunkTileCoordAxis>(coord & (kChunkWidth - 1));
+        }
         J_NODISCARD static ChunkTileCoord WorldCToChunkTileC(const WorldCoord& coord);
 
 
@@ -65,15 +127,133 @@ namespace jactorio::game
         OverlayContainerT& GetOverlay(OverlayLayer layer);
         J_NODISCARD const OverlayContainerT& GetOverlay(OverlayLayer layer) const;
 
-        CEREAL_SERIALIZE(archive) {
-            archive(position_, layers_);
+        // Tex coord ids - Sprite of each tile drawn by the renderer
+
+        J_NODISCARD TexCoordIdArrayT& TexCoordIds() noexcept {
+            return texCoordIds_;
+        }
+        J_NODISCARD const TexCoordIdArrayT& TexCoordIds() const noexcept {
+            return texCoordIds_;
+        }
+
+        /// \return Index of tile at coord and tlayer in TexCoordIds
+        J_NODISCARD static std::size_t GetTexCoordIndex(const ChunkTileCoord& coord, TileLayer tlayer) noexcept {
+            return (static_cast<std::size_t>(coord.y) * kChunkWidth + coord.x) * kTileLayerCount +
+                static_cast<std::size_t>(tlayer);
+        }
+
+        // Resource amounts - Of resource layer, kept out of tiles so resources need no unique data
+
+        J_NODISCARD ResourceAmountArrayT& ResourceAmounts() noexcept {
+            return resourceAmounts_;
+        }
+        J_NODISCARD const ResourceAmountArrayT& ResourceAmounts() const noexcept {
+            return resourceAmounts_;
+        }
+
+        /// Resource amount of tile at x, y offset from top left of chunk
+        J_NODISCARD ResourceEntityResourceCount& GetResourceAmount(const ChunkTileCoord& coord) noexcept;
+        J_NODISCARD const ResourceEntityResourceCount& GetResourceAmount(const ChunkTileCoord& coord) const noexcept;
+
+        // Saving - Only chunks modified since the last save are appended to it
+
+        /// Chunk must be saved again, call when its tiles, tex coord ids or resource amounts are modified
+        void MarkDirty() noexcept {
+            dirty_ = true;
+        }
+
+        /// \return true if chunk was marked dirty since it was last saved or its tiles hold unique data,
+        /// new chunks are dirty
+        /// \remark Unique data is referred to by id from outside the chunk, ids are only valid within one save
+        J_NODISCARD bool IsDirty() const noexcept;
+
+        void MarkSaved() noexcept {
+            dirty_ = false;
+        }
+
+        /// \return true if nothing outside the chunk refers to its tiles: No entities, unique data or multi tiles
+        J_NODISCARD bool IsStandalone() const noexcept;
+
+
+        CEREAL_LOAD(archive) {
+            if (data::active_save_version >= data::kSaveVersionColumnarChunks) {
+                archive(position_);
+                for (auto& layer : tiles_->layers) {
+                    ChunkTile::LoadColumns(archive, layer);
+                }
+                data::CerealLoadRunLength<SpriteTexCoordIndexT>(
+                    archive, texCoordIds_.begin(), texCoordIds_.end(), [](auto& id, const auto value) { id = value; });
+                data::CerealLoadRunLength<ResourceEntityResourceCount>(
+                    archive, resourceAmounts_.begin(), resourceAmounts_.end(), [](auto& amount, const auto value) {
+                        amount = value;
+                    });
+                CountEntities();
+                return;
+            }
+
+            archive(position_, tiles_->layers);
+
+            // Older saves store tex coord ids of all chunks in the world
+            if (data::active_save_version >= data::kSaveVersionChunkTexCoords) {
+                archive(texCoordIds_);
+            }
+
+            if (data::active_save_version >= data::kSaveVersionResourceAmounts) {
+                archive(resourceAmounts_);
+            }
+            else {
+                LoadLegacyResourceAmounts();
+            }
+            CountEntities();
+        }
+
+        CEREAL_SAVE(archive) {
+            if (data::active_save_version >= data::kSaveVersionColumnarChunks) {
+                archive(position_);
+                for (const auto& layer : tiles_->layers) {
+                    ChunkTile::SaveColumns(archive, layer);
+                }
+                data::CerealSaveRunLength(
+                    archive, texCoordIds_.begin(), texCoordIds_.end(), [](const auto id) { return id; });
+                data::CerealSaveRunLength(archive,
+                                          resourceAmounts_.begin(),
+                                          resourceAmounts_.end(),
+                                          [](const auto amount) { return amount; });
+                return;
+            }
+
+            archive(position_, tiles_->layers);
+
+            if (data::active_save_version >= data::kSaveVersionChunkTexCoords) {
+                archive(texCoordIds_);
+            }
+            if (data::active_save_version >= data::kSaveVersionResourceAmounts) {
+                archive(resourceAmounts_);
+            }
         }
 
         OverlayArrayT overlays;
 
     private:
         ChunkCoord position_;
-        std::array<TileArrayT, kTileLayerCount> layers_;
+        /// Kept on heap so tiles keep their address when chunk is moved
+        std::unique_ptr<TileBlock, TileBlockDeleter> tiles_;
+        TexCoordIdArrayT texCoordIds_{};
+        ResourceAmountArrayT resourceAmounts_{};
+        /// Not serialized
+        bool dirty_ = true;
+
+        J_NODISCARD static std::unique_ptr<TileBlock, TileBlockDeleter> MakeTileBlock();
+
+        /// Block holding tile
+        J_NODISCARD static TileBlock& GetTileBlock(ChunkTile& tile) noexcept;
+        J_NODISCARD static const TileBlock& GetTileBlock(const ChunkTile& tile) noexcept;
+
+        /// Sets entity count of side table from tiles, whose loading does not count them
+        void CountEntities() noexcept;
+
+        /// Moves resource amounts out of the unique data of resource tiles, which older saves store them in
+        void LoadLegacyResourceAmounts() noexcept;
     };
 } // namespace jactorio::game
 
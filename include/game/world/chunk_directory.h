@@ -0,0 +1,188 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_WORLD_CHUNK_DIRECTORY_H
+#define JACTORIO_INCLUDE_GAME_WORLD_CHUNK_DIRECTORY_H
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "jactorio.h"
+
+#include "core/data_type.h"
+#include "data/cereal/serialize.h"
+#include "game/world/chunk.h"
+
+#include <cereal/types/tuple.hpp>
+
+namespace jactorio::game
+{
+    /// Owns chunks of a world, found by chunk coordinate without hashing
+    ///
+    /// Chunks are grouped into square pages of kPageWidth chunks, pages are held in a grid covering all pages with chunks.
+    /// A chunk is found by indexing the grid with the upper bits of its coordinate, then the page with the lower bits
+    class ChunkDirectory
+    {
+    public:
+        static constexpr int kPageWidthShift      = 5;
+        static constexpr ChunkCoordAxis kPageWidth = 1 << kPageWidthShift;
+        static constexpr ChunkCoordAxis kPageMask  = kPageWidth - 1;
+        static constexpr std::size_t kPageArea     = static_cast<std::size_t>(kPageWidth) * kPageWidth;
+
+        ChunkDirectory() = default;
+        ~ChunkDirectory() = default;
+
+        ChunkDirectory(const ChunkDirectory& other)     = delete;
+        ChunkDirectory(ChunkDirectory&& other) noexcept = default;
+        ChunkDirectory& operator=(const ChunkDirectory& other) = delete;
+        ChunkDirectory& operator=(ChunkDirectory&& other) noexcept = default;
+
+
+        /// \return nullptr if no chunk exists
+        J_NODISCARD Chunk* Find(const ChunkCoord& c_coord) noexcept {
+            return const_cast<Chunk*>(static_cast<const ChunkDirectory*>(this)->Find(c_coord));
+        }
+
+        /// \return nullptr if no chunk exists
+        J_NODISCARD const Chunk* Find(const ChunkCoord& c_coord) const noexcept {
+            const auto* page = FindPage(c_coord.x >> kPageWidthShift, c_coord.y >> kPageWidthShift);
+            if (page == nullptr)
+                return nullptr;
+
+            return page->chunks[GetPageIndex(c_coord)].get();
+        }
+
+        /// Creates chunk at c_coord, no chunk may exist at c_coord
+        /// \param args Additional arguments to be provided alongside c_coord to Chunk constructor
+        /// \return Added chunk
+        template <typename... TChunkArgs>
+        Chunk& Emplace(const ChunkCoord& c_coord, TChunkArgs&&... args) {
+            return Insert(c_coord, std::make_unique<Chunk>(c_coord, std::forward<TChunkArgs>(args)...));
+        }
+
+        /// Takes ownership of chunk, no chunk may exist at c_coord
+        /// \return Added chunk
+        Chunk& Insert(const ChunkCoord& c_coord, std::unique_ptr<Chunk> chunk);
+
+        /// Deletes chunk at c_coord
+        /// \return true if a chunk was deleted
+        bool Erase(const ChunkCoord& c_coord);
+
+        void Clear() noexcept;
+
+        /// \return Number of chunks
+        J_NODISCARD std::size_t Size() const noexcept {
+            return size_;
+        }
+
+        /// Calls func(const ChunkCoord&, const Chunk*) for count chunks heading right from c_coord
+        /// Chunk is nullptr if it does not exist, pages are found once for the chunks within them
+        template <typename TFunc>
+        void ForEachInRow(const ChunkCoord& c_coord, const int count, TFunc&& func) const {
+            const Page* page = nullptr;
+            for (int i = 0; i < count; ++i) {
+                const ChunkCoord coord{c_coord.x + i, c_coord.y};
+                if (i == 0 || (coord.x & kPageMask) == 0) {
+                    page = FindPage(coord.x >> kPageWidthShift, coord.y >> kPageWidthShift);
+                }
+
+                const Chunk* chunk = page != nullptr ? page->chunks[GetPageIndex(coord)].get() : nullptr;
+                func(coord, chunk);
+            }
+        }
+
+        /// Calls func with each chunk, order is unspecified
+        template <typename TFunc>
+        void ForEach(TFunc&& func) {
+            static_cast<const ChunkDirectory*>(this)->ForEach(
+                [&func](const Chunk& chunk) { func(const_cast<Chunk&>(chunk)); });
+        }
+
+        /// Calls func with each chunk, order is unspecified
+        template <typename TFunc>
+        void ForEach(TFunc&& func) const {
+            for (const auto& page : pages_) {
+                if (page == nullptr)
+                    continue;
+
+                for (const auto& chunk : page->chunks) {
+                    if (chunk != nullptr) {
+                        func(static_cast<const Chunk&>(*chunk));
+                    }
+                }
+            }
+        }
+
+
+        // Saved in the same format as the chunk coord to chunk map it replaced
+
+        CEREAL_LOAD(archive) {
+            Clear();
+
+            cereal::size_type size;
+            archive(cereal::make_size_tag(size));
+
+            for (cereal::size_type i = 0; i < size; ++i) {
+                std::tuple<ChunkCoordAxis, ChunkCoordAxis> key;
+                auto chunk = std::make_unique<Chunk>();
+                archive(cereal::make_map_item(key, *chunk));
+
+                Insert({std::get<0>(key), std::get<1>(key)}, std::move(chunk));
+            }
+        }
+
+        CEREAL_SAVE(archive) {
+            archive(cereal::make_size_tag(static_cast<cereal::size_type>(size_)));
+
+            ForEach([&archive](const Chunk& chunk) {
+                const auto c_coord = chunk.GetPosition();
+                const auto key     = std::make_tuple(c_coord.x, c_coord.y);
+                archive(cereal::make_map_item(key, chunk));
+            });
+        }
+
+    private:
+        struct Page
+        {
+            std::array<std::unique_ptr<Chunk>, kPageArea> chunks;
+            /// Number of chunks in page, page is deleted once empty
+            std::size_t size = 0;
+        };
+
+        J_NODISCARD static std::size_t GetPageIndex(const ChunkCoord& c_coord) noexcept {
+            return static_cast<std::size_t>(c_coord.y & kPageMask) * kPageWidth + (c_coord.x & kPageMask);
+        }
+
+        /// \param page_x page_y Page coordinate, chunk coordinate shifted by kPageWidthShift
+        /// \return nullptr if page does not exist
+        J_NODISCARD const Page* FindPage(const ChunkCoordAxis page_x, const ChunkCoordAxis page_y) const noexcept {
+            // Below origin wraps around to above width
+            const auto x = static_cast<std::size_t>(static_cast<int64_t>(page_x) - pageOriginX_);
+            const auto y = static_cast<std::size_t>(static_cast<int64_t>(page_y) - pageOriginY_);
+            if (x >= pagesWidth_ || y >= pagesHeight_)
+                return nullptr;
+
+            return pages_[y * pagesWidth_ + x].get();
+        }
+
+        /// Resizes grid of pages to include page at page_x, page_y
+        /// \return Page at page_x, page_y, created if it did not exist
+        Page& MakePage(ChunkCoordAxis page_x, ChunkCoordAxis page_y);
+
+
+        /// Pages increment heading right then down, nullptr if page has no chunks
+        std::vector<std::unique_ptr<Page>> pages_;
+        /// Page coordinate of first page
+        ChunkCoordAxis pageOriginX_ = 0;
+        ChunkCoordAxis pageOriginY_ = 0;
+        std::size_t pagesWidth_     = 0;
+        std::size_t pagesHeight_    = 0;
+
+        std::size_t size_ = 0;
+    };
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_WORLD_CHUNK_DIRECTORY_H
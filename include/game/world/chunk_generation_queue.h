@@ -0,0 +1,72 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_WORLD_CHUNK_GENERATION_QUEUE_H
+#define JACTORIO_INCLUDE_GAME_WORLD_CHUNK_GENERATION_QUEUE_H
+#pragma once
+
+#include "jactorio.h"
+
+#include <mutex>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "core/data_type.h"
+#include "core/hashers.h"
+
+namespace jactorio::game
+{
+    /// Chunks awaiting generation, the chunk nearest to a focus is taken first
+    /// \remark Thread safe
+    class ChunkGenerationQueue
+    {
+    public:
+        ChunkGenerationQueue() = default;
+
+        ChunkGenerationQueue(const ChunkGenerationQueue& other) = delete;
+        ChunkGenerationQueue(ChunkGenerationQueue&& other) noexcept;
+
+        ChunkGenerationQueue& operator=(const ChunkGenerationQueue& other) = delete;
+        ChunkGenerationQueue& operator=(ChunkGenerationQueue&& other) noexcept;
+
+        /// Queues chunk at c_coord, no effect if already queued
+        void Push(const ChunkCoord& c_coord);
+
+        /// Removes chunk nearest to a focus from the queue
+        /// \param c_coord Set to removed chunk
+        /// \return false if queue is empty, c_coord is unchanged
+        bool Pop(ChunkCoord& c_coord);
+
+        /// Chunks are taken by distance to nearest chunk in focus, e.g: the chunk each player views
+        /// If empty, chunks are taken by distance to chunk 0, 0
+        void SetFocus(std::vector<ChunkCoord> focus);
+
+        void Clear() noexcept;
+
+        J_NODISCARD std::size_t Size() const;
+
+    private:
+        using ChunkKey = std::tuple<ChunkCoordAxis, ChunkCoordAxis>;
+
+        struct Entry
+        {
+            ChunkCoord coord;
+            /// Squared distance to the nearest focus
+            uint64_t distance = 0;
+        };
+
+        /// \return true if a is taken after b
+        static bool TakenAfter(const Entry& a, const Entry& b) noexcept;
+
+        J_NODISCARD uint64_t GetDistance(const ChunkCoord& c_coord) const noexcept;
+
+        mutable std::mutex mutex_;
+
+        /// Heap, entry nearest a focus at front
+        std::vector<Entry> heap_;
+        std::unordered_set<ChunkKey, hash<ChunkKey>> queued_;
+        std::vector<ChunkCoord> focus_;
+    };
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_WORLD_CHUNK_GENERATION_QUEUE_H
@@ -4,9 +4,19 @@
 #define JACTORIO_INCLUDE_GAME_WORLD_CHUNK_TILE_H
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
 #include "core/convert.h"
 #include "data/cereal/serialization_type.h"
 #include "data/cereal/serialize.h"
+#include "data/globals.h"
+#include "data/prototype_manager.h"
 #include "data/unique_data_manager.h"
 #include "proto/framework/world_object.h"
 
@@ -15,8 +25,14 @@
 namespace jactorio::game
 {
     /// A tile within a chunk
+    ///
+    /// Kept to one packed word of tile prototype id, multi tile index and orientation. Unique data and top left of
+    /// multi tiles are held sparsely by the chunk in a side table, which tiles find from their address
+    /// \remark Only tiles of a Chunk may be used
     class ChunkTile
     {
+        friend class Chunk;
+
         using TileDistanceT = uint8_t;
 
         using PrototypeContainerT  = data::SerialProtoPtr<const proto::FWorldObject>;
@@ -25,30 +41,17 @@ namespace jactorio::game
         using PrototypeT  = PrototypeContainerT::element_type;
         using UniqueDataT = UniqueDataContainerT::element_type;
 
+        /// Index of tile within the tiles of all layers of its chunk
+        using SideTableKeyT = uint16_t;
+
     public:
         ChunkTile() = default;
 
-        ~ChunkTile();
-
-        ChunkTile(const ChunkTile& other);
-        ChunkTile(ChunkTile&& other) noexcept;
-
-        ChunkTile& operator=(ChunkTile other) noexcept {
-            swap(*this, other);
-            return *this;
-        }
-
-
-        friend void swap(ChunkTile& lhs, ChunkTile& rhs) noexcept {
-            using std::swap;
-            if (lhs.IsTopLeft()) {
-                swap(lhs.data_.topLeft, rhs.data_.topLeft);
-            }
-            else {
-                swap(lhs.data_.nonTopLeft, rhs.data_.nonTopLeft);
-            }
-            swap(lhs.common_, rhs.common_);
-        }
+        /// Tiles are only held by chunks, which copy their side table with them
+        ChunkTile(const ChunkTile& other) = delete;
+        ChunkTile(ChunkTile&& other)      = delete;
+        ChunkTile& operator=(const ChunkTile& other) = delete;
+        ChunkTile& operator=(ChunkTile&& other) = delete;
 
 
         /// Resets data on this tile, becomes TopLeft again if previously NonTopLeft
@@ -78,11 +81,16 @@ namespace jactorio::game
 
         // Unique data
 
-        /// Heap allocates unique data
+        /// Heap allocates unique data, pooled unique data is allocated from proto::UniqueDataPool::Current
         /// \return Created unique data
         template <typename TData, typename... Args>
         TData& MakeUniqueData(Args&&... args);
 
+        /// Heap allocates unique data, pooled unique data is allocated from pool
+        /// \return Created unique data
+        template <typename TData, typename... Args>
+        TData& MakeUniqueData(proto::UniqueDataPool& pool, Args&&... args);
+
         /// Unique data at current tile or if multi tile, top left
         /// \tparam T Return type which uniqueData is cast to
         template <typename T = UniqueDataT>
@@ -97,7 +105,7 @@ namespace jactorio::game
         // ======================================================================
 
 
-        J_NODISCARD bool IsTopLeft() const noexcept; // Destructor use safe
+        J_NODISCARD bool IsTopLeft() const noexcept;
         J_NODISCARD bool IsMultiTile() const noexcept;
         J_NODISCARD bool IsMultiTileTopLeft() const noexcept;
 
@@ -112,6 +120,7 @@ namespace jactorio::game
 
         J_NODISCARD TileDistanceT GetMultiTileIndex() const noexcept;
 
+        /// \return nullptr if multi tile was not set up
         J_NODISCARD ChunkTile* GetTopLeft() noexcept;
         J_NODISCARD const ChunkTile* GetTopLeft() const noexcept;
 
@@ -123,22 +132,24 @@ namespace jactorio::game
         J_NODISCARD TileDistanceT GetOffsetY() const noexcept;
 
 
+        // Serialized as multi tile index, then common, then unique data if top left
+
         CEREAL_LOAD(archive) {
-            decltype(Common::multiTileIndex) multi_tile_index;
+            TileDistanceT multi_tile_index;
             archive(multi_tile_index);
 
             if (IsTopLeft(multi_tile_index)) {
-                data::CerealArchive<sizeof(Common) + sizeof(TopLeft)>(archive, common_, data_.topLeft);
-
-                const auto& unique_data = data_.topLeft.uniqueData;
+                UniqueDataContainerT unique_data;
+                archive(common_, unique_data);
 
                 if (unique_data != nullptr) {
                     assert(data::active_unique_data_manager != nullptr);
                     data::active_unique_data_manager->StoreRelocationEntry(*unique_data);
+                    UniqueDataSlot() = std::move(unique_data);
                 }
             }
             else {
-                data::CerealArchive<sizeof(Common) + sizeof(NonTopLeft)>(archive, common_, data_.nonTopLeft);
+                archive(common_);
             }
         }
 
@@ -146,134 +157,181 @@ namespace jactorio::game
             archive(GetMultiTileIndex());
 
             if (IsTopLeft()) {
-                const auto& unique_data = data_.topLeft.uniqueData;
+                auto& side_table = GetSideTable();
 
-                if (unique_data != nullptr) {
+                const auto it = side_table.uniqueData.find(GetSideTableKey());
+                if (it != side_table.uniqueData.end()) {
                     assert(data::active_unique_data_manager != nullptr);
-                    data::active_unique_data_manager->AssignId(*unique_data);
+                    data::active_unique_data_manager->AssignId(*it->second);
+                    archive(common_, it->second);
+                }
+                else {
+                    archive(common_, UniqueDataContainerT());
                 }
-                data::CerealArchive<sizeof(Common) + sizeof(TopLeft)>(archive, common_, data_.topLeft);
             }
             else {
-                data::CerealArchive<sizeof(Common) + sizeof(NonTopLeft)>(archive, common_, data_.nonTopLeft);
+                archive(common_);
             }
         }
 
-    private:
-        /// Shared between top left and non top left
-        struct Common
-        {
-            friend void swap(Common& lhs, Common& rhs) noexcept {
-                using std::swap;
-                swap(lhs.multiTileIndex, rhs.multiTileIndex);
-                swap(lhs.prototype, rhs.prototype);
-                swap(lhs.orientation, rhs.orientation);
-            }
-
-            /// If the tile is multi-tile, eg: 3 x 2
-            /// 0 1 2
-            /// 3 4 5
-            TileDistanceT multiTileIndex = 0;
 
-            /// Provide additional data (collisions, world gen)
-            PrototypeContainerT prototype;
-
-            Orientation orientation = Orientation::up;
-
-            CEREAL_SERIALIZE(archive) {
-                archive(multiTileIndex, prototype, orientation);
+        /// Serializes tiles as columns of multi tile index, prototype and orientation, followed by unique data of top
+        /// left tiles. Each column is run length encoded, as most tiles of a layer are the same as their neighbor
+        template <typename TArchive, std::size_t N>
+        static void SaveColumns(TArchive& archive, const std::array<ChunkTile, N>& tiles) {
+            static_assert(N <= std::numeric_limits<uint16_t>::max() + 1);
+
+            data::CerealSaveRunLength(
+                archive, tiles.begin(), tiles.end(), [](const ChunkTile& tile) { return tile.GetMultiTileIndex(); });
+            data::CerealSaveRunLength(archive, tiles.begin(), tiles.end(), [](const ChunkTile& tile) {
+                return PrototypeContainerT(tile.GetPrototype());
+            });
+            data::CerealSaveRunLength(
+                archive, tiles.begin(), tiles.end(), [](const ChunkTile& tile) { return tile.GetOrientation(); });
+
+            // Side table holds unique data of all layers
+            const auto& side_table = tiles.front().GetSideTable();
+            const auto first_key   = tiles.front().GetSideTableKey();
+
+            std::vector<uint16_t> unique_indices;
+            for (const auto& [key, unique_data] : side_table.uniqueData) {
+                if (key >= first_key && key - first_key < N) {
+                    unique_indices.push_back(SafeCast<uint16_t>(key - first_key));
+                }
             }
-        };
+            std::sort(unique_indices.begin(), unique_indices.end());
 
-        struct TopLeft
-        {
-            TopLeft() = default;
-
-            /// Does not copy uniqueData
-            TopLeft(const TopLeft& other) noexcept;
-            TopLeft(TopLeft&& other) noexcept = default;
-
-            TopLeft& operator=(TopLeft other) {
-                using std::swap;
-                swap(*this, other);
-                return *this;
-            }
+            archive(cereal::make_size_tag(static_cast<cereal::size_type>(unique_indices.size())));
+            for (const auto index : unique_indices) {
+                const auto& unique_data = side_table.uniqueData.at(SafeCast<SideTableKeyT>(first_key + index));
 
-            friend void swap(TopLeft& lhs, TopLeft& rhs) noexcept {
-                using std::swap;
-                swap(lhs.uniqueData, rhs.uniqueData);
+                assert(data::active_unique_data_manager != nullptr);
+                data::active_unique_data_manager->AssignId(*unique_data);
+                archive(index, unique_data);
             }
+        }
 
-            UniqueDataContainerT uniqueData;
+        /// Loads tiles serialized with SaveColumns
+        /// \exception std::runtime_error Columns do not match tiles
+        template <typename TArchive, std::size_t N>
+        static void LoadColumns(TArchive& archive, std::array<ChunkTile, N>& tiles) {
+            data::CerealLoadRunLength<TileDistanceT>(
+                archive, tiles.begin(), tiles.end(), [](ChunkTile& tile, const TileDistanceT multi_tile_index) {
+                    tile.common_.SetMultiTileIndex(multi_tile_index);
+                });
+            data::CerealLoadRunLength<PrototypeContainerT>(
+                archive, tiles.begin(), tiles.end(), [](ChunkTile& tile, const PrototypeContainerT& prototype) {
+                    tile.common_.SetPrototype(prototype.Get());
+                });
+            data::CerealLoadRunLength<Orientation>(
+                archive, tiles.begin(), tiles.end(), [](ChunkTile& tile, const Orientation orientation) {
+                    tile.common_.SetOrientation(orientation);
+                });
+
+            cereal::size_type unique_count;
+            archive(cereal::make_size_tag(unique_count));
+            for (cereal::size_type i = 0; i < unique_count; ++i) {
+                uint16_t index;
+                archive(index);
+
+                if (index >= N || !tiles[index].IsTopLeft()) {
+                    throw std::runtime_error("Unique data is not of a top left tile");
+                }
 
-            /// Copies this object, prototype must not be null if uniqueData is not null
-            /// \param to UniqueData copied to here
-            void CopyUniqueData(TopLeft& to, PrototypeT* prototype) const;
+                UniqueDataContainerT unique_data;
+                archive(unique_data);
 
-            CEREAL_SERIALIZE(archive) {
-                archive(uniqueData);
+                if (unique_data != nullptr) {
+                    assert(data::active_unique_data_manager != nullptr);
+                    data::active_unique_data_manager->StoreRelocationEntry(*unique_data);
+                    tiles[index].UniqueDataSlot() = std::move(unique_data);
+                }
             }
-        };
+        }
 
-        struct NonTopLeft
+    private:
+        /// Shared between top left and non top left
+        /// Packs tile prototype id, multi tile index and orientation into one word
+        class Common
         {
-            NonTopLeft() = default;
-
-            NonTopLeft(const NonTopLeft& other);
-            NonTopLeft(NonTopLeft&& other) noexcept = default;
-
-            NonTopLeft& operator=(NonTopLeft other) {
-                using std::swap;
-                swap(*this, other);
-                return *this;
+            static constexpr int kMultiTileIndexShift = 16;
+            static constexpr int kOrientationShift    = 24;
+
+        public:
+            /// Resolved with active_prototype_manager
+            J_NODISCARD PrototypeT* GetPrototype() const noexcept {
+                const auto id = static_cast<TilePrototypeIdT>(packed_);
+                if (id == 0)
+                    return nullptr;
+
+                assert(data::active_prototype_manager != nullptr);
+                return data::active_prototype_manager->TilePrototypeGet(id);
             }
 
-            friend void swap(NonTopLeft& lhs, NonTopLeft& rhs) noexcept {
-                using std::swap;
-                swap(lhs.topLeft, rhs.topLeft);
+            /// \param prototype Must be added to active_prototype_manager
+            void SetPrototype(PrototypeT* prototype) noexcept {
+                const TilePrototypeIdT id = prototype == nullptr ? 0 : prototype->tilePrototypeId;
+                assert(prototype == nullptr ||
+                       (data::active_prototype_manager != nullptr &&
+                        data::active_prototype_manager->TilePrototypeGet(id) == prototype));
+                packed_ = (packed_ & ~uint32_t{0xFFFF}) | id;
             }
 
-            ChunkTile* topLeft = nullptr;
-
-            CEREAL_SERIALIZE(archive) {
-                // topLeft must be manually redetermined
+            /// If the tile is multi-tile, eg: 3 x 2
+            /// 0 1 2
+            /// 3 4 5
+            J_NODISCARD TileDistanceT GetMultiTileIndex() const noexcept {
+                return static_cast<TileDistanceT>(packed_ >> kMultiTileIndexShift);
             }
-        };
-
 
-        /// topLeft when multiTileIndex is 0, otherwise nonTopLeft
-        union TileData
-        {
-            TileData() {
-                ConstructTopLeft();
+            void SetMultiTileIndex(const TileDistanceT multi_tile_index) noexcept {
+                packed_ = (packed_ & ~(uint32_t{0xFF} << kMultiTileIndexShift)) |
+                    (uint32_t{multi_tile_index} << kMultiTileIndexShift);
             }
 
-            // Destruction managed by ChunkTile destructor
-            ~TileData() {}
-
-            void ConstructTopLeft() noexcept {
-                new (&topLeft) TopLeft();
+            J_NODISCARD Orientation GetOrientation() const noexcept {
+                return static_cast<Orientation::Direction>(packed_ >> kOrientationShift);
             }
 
-            void DestructTopLeft() noexcept {
-                topLeft.~TopLeft();
+            void SetOrientation(const Orientation orientation) noexcept {
+                packed_ = (packed_ & ~(uint32_t{0xFF} << kOrientationShift)) |
+                    (uint32_t{static_cast<Orientation::Direction>(orientation)} << kOrientationShift);
             }
 
+            // Serialized as prototype internal id, as tile prototype ids are only valid for this run
+
+            CEREAL_LOAD(archive) {
+                TileDistanceT multi_tile_index;
+                PrototypeContainerT prototype;
+                Orientation orientation;
+                archive(multi_tile_index, prototype, orientation);
 
-            void ConstructNonTopLeft() noexcept {
-                new (&nonTopLeft) NonTopLeft();
+                SetMultiTileIndex(multi_tile_index);
+                SetPrototype(prototype.Get());
+                SetOrientation(orientation);
             }
 
-            void DestructNonTopLeft() noexcept {
-                nonTopLeft.~NonTopLeft();
+            CEREAL_SAVE(archive) {
+                archive(GetMultiTileIndex(), PrototypeContainerT(GetPrototype()), GetOrientation());
             }
 
-            TopLeft topLeft;
-            NonTopLeft nonTopLeft;
+        private:
+            /// Tile prototype id in low 16 bits, multi tile index, then orientation in the high 8 bits
+            uint32_t packed_ = 0;
+        };
+
+        /// Unique data and top left of non top left tiles, held by the chunk for all its tiles
+        /// Sparse, as few tiles have either
+        struct SideTable
+        {
+            std::unordered_map<SideTableKeyT, UniqueDataContainerT> uniqueData;
+            std::unordered_map<SideTableKeyT, ChunkTile*> topLeft;
+
+            /// Tiles which are entities or part of a multi tile, see IsCountedEntity
+            std::size_t entityCount = 0;
         };
 
         Common common_;
-        TileData data_;
 
 
         /// Sets orientation at current tile
@@ -281,18 +339,29 @@ namespace jactorio::game
 
         J_NODISCARD static bool IsTopLeft(TileDistanceT multi_tile_index) noexcept;
 
-        /// Returns data within the union topLeft
-        J_NODISCARD TopLeft& AsTopLeft() noexcept;
-        J_NODISCARD const TopLeft& AsTopLeft() const noexcept;
+        /// Side table of the chunk holding this tile
+        J_NODISCARD SideTable& GetSideTable() noexcept;
+        J_NODISCARD const SideTable& GetSideTable() const noexcept;
+
+        J_NODISCARD SideTableKeyT GetSideTableKey() const noexcept;
+
+        /// Unique data of this tile in side table, created empty if it has none
+        J_NODISCARD UniqueDataContainerT& UniqueDataSlot();
 
-        /// Returns data within the union nonTopLeft
-        J_NODISCARD NonTopLeft& AsNonTopLeft() noexcept;
-        J_NODISCARD const NonTopLeft& AsNonTopLeft() const noexcept;
+        /// Unique data of this tile or its top left
+        J_NODISCARD UniqueDataT* FindUniqueData() const noexcept;
+
+        /// \return true if tile keeps chunk from being standalone: Has an entity or is part of a multi tile
+        J_NODISCARD bool IsCountedEntity() const noexcept;
+
+        /// Updates entity count of chunk after tile was modified
+        /// \param was_counted IsCountedEntity prior to modification
+        void RecountEntity(bool was_counted) noexcept;
     };
 
     template <typename T>
     const T* ChunkTile::GetPrototype() const noexcept {
-        return SafeCast<const T*>(common_.prototype.Get());
+        return SafeCast<const T*>(common_.GetPrototype());
     }
 
 
@@ -303,30 +372,29 @@ namespace jactorio::game
         if (IsMultiTile())
             assert(IsMultiTileTopLeft());
 
-        auto& self = AsTopLeft();
-        assert(self.uniqueData == nullptr); // Trying to create already created uniqueData
+        auto& unique_data = UniqueDataSlot();
+        assert(unique_data == nullptr); // Trying to create already created uniqueData
 
-        self.uniqueData = std::make_unique<TData>(std::forward<Args>(args)...);
+        unique_data = std::make_unique<TData>(std::forward<Args>(args)...);
+
+        assert(unique_data != nullptr);
+        return SafeCast<TData&>(*unique_data.get());
+    }
 
-        assert(self.uniqueData != nullptr);
-        return SafeCast<TData&>(*self.uniqueData.get());
+    template <typename TData, typename... Args>
+    TData& ChunkTile::MakeUniqueData(proto::UniqueDataPool& pool, Args&&... args) {
+        proto::UniqueDataPool::Scope scope(pool);
+        return MakeUniqueData<TData>(std::forward<Args>(args)...);
     }
 
     template <typename T>
     T* ChunkTile::GetUniqueData() noexcept {
-        if (!IsTopLeft()) {
-            auto* tl_layer = AsNonTopLeft().topLeft;
-            assert(tl_layer != nullptr);
-
-            return SafeCast<T*>(tl_layer->AsTopLeft().uniqueData.get());
-        }
-
-        return SafeCast<T*>(AsTopLeft().uniqueData.get());
+        return SafeCast<T*>(FindUniqueData());
     }
 
     template <typename T>
     const T* ChunkTile::GetUniqueData() const noexcept {
-        return const_cast<ChunkTile*>(this)->GetUniqueData<const T>();
+        return SafeCast<const T*>(FindUniqueData());
     }
 
 
@@ -0,0 +1,59 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_WORLD_PERLIN_NOISE_H
+#define JACTORIO_INCLUDE_GAME_WORLD_PERLIN_NOISE_H
+#pragma once
+
+#include "jactorio.h"
+
+#include <array>
+
+#include "game/world/chunk.h"
+
+namespace jactorio::game
+{
+    /// Implementation used to evaluate Perlin noise
+    enum class NoiseKernel
+    {
+        libnoise, // libnoise module::Perlin one sample at a time, other kernels are verified against it
+        scalar,
+        sse2,
+        avx2,
+        count_
+    };
+
+    /// Properties of a libnoise module::Perlin, remaining properties are libnoise defaults
+    struct PerlinParams
+    {
+        int seed           = 0;
+        int octaveCount    = 6;
+        double frequency   = 1.;
+        double persistence = 0.5;
+    };
+
+    /// Noise value for each tile of a chunk, row major
+    using ChunkNoiseMap = std::array<float, Chunk::kChunkArea>;
+
+    /// \return true if kernel can run on this CPU
+    J_NODISCARD bool NoiseKernelSupported(NoiseKernel kernel) noexcept;
+
+    /// \return Kernel used by GenerateChunkNoise, defaults to the fastest supported
+    J_NODISCARD NoiseKernel GetNoiseKernel() noexcept;
+
+    /// Sets kernel used by GenerateChunkNoise, can be called while chunks are generating
+    /// \return false if kernel is unsupported, kernel used is unchanged
+    bool SetNoiseKernel(NoiseKernel kernel) noexcept;
+
+    /// Fills noise_map with the values libnoise module::Perlin gives for chunk at c_coord
+    /// when sampled by utils::NoiseMapBuilderPlane with bounds c_coord -0.5, +0.5
+    void GenerateChunkNoise(const PerlinParams& params, const ChunkCoord& c_coord, ChunkNoiseMap& noise_map);
+
+    /// GenerateChunkNoise using kernel
+    /// \remark kernel must be supported
+    void GenerateChunkNoise(NoiseKernel kernel,
+                            const PerlinParams& params,
+                            const ChunkCoord& c_coord,
+                            ChunkNoiseMap& noise_map);
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_WORLD_PERLIN_NOISE_H
@@ -4,17 +4,35 @@
 #define JACTORIO_INCLUDE_GAME_WORLD_WORLD_H
 #pragma once
 
-#include <set>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "jactorio.h"
 
 #include "core/data_type.h"
 #include "core/dvector.h"
+#include "data/globals.h"
 #include "game/world/chunk.h"
+#include "game/world/chunk_directory.h"
+#include "game/world/chunk_generation_queue.h"
 #include "game/world/logic_group.h"
 #include "game/world/update_dispatcher.h"
+#include "game/world/world_gen_plan.h"
+#include "proto/framework/unique_data_pool.h"
+
+namespace jactorio
+{
+    class ThreadPool;
+} // namespace jactorio
 
 namespace jactorio::proto
 {
@@ -27,6 +45,8 @@ namespace jactorio::proto
 
 namespace jactorio::game
 {
+    struct ConveyorActiveSet;
+
     /// Represents entity registered for logic updates
     struct LogicObject
     {
@@ -54,14 +74,19 @@ namespace jactorio::game
         using LogicListT                 = std::vector<LogicObject>;
         using SerialLogicChunkContainerT = std::vector<ChunkCoord>;
 
-        /// Format: | 0 1 2 | 0 1 2 |
-        ///         <1 tile >
-        /// 0 1 2 are the different layers, layer 0 first
-        /// Kept contiguous for rendering cache locality
-        using TexCoordIdArrayT = std::array<SpriteTexCoordIndexT, Chunk::kChunkArea * kTileLayerCount>;
-
     public:
-        static ChunkCoordAxis WorldCToChunkC(WorldCoordAxis coord);
+        World();
+        ~World();
+
+        World(const World& other)     = delete;
+        World(World&& other) noexcept = default;
+        World& operator=(const World& other) = delete;
+        World& operator=(World&& other) noexcept = default;
+
+        static ChunkCoordAxis WorldCToChunkC(const WorldCoordAxis coord) {
+            // Arithmetic shift rounds towards negative infinity
+            return coord >> Chunk::kChunkWidthShift;
+        }
         static ChunkCoord WorldCToChunkC(const WorldCoord& coord);
         /// Chunk coord -> World coord at first tile of chunk
         static WorldCoordAxis ChunkCToWorldC(ChunkCoordAxis chunk_coord);
@@ -78,30 +103,8 @@ namespace jactorio::game
         /// \return Added chunk
         template <typename... TChunkArgs>
         Chunk& EmplaceChunk(const ChunkCoord& c_coord, TChunkArgs... args) {
-            const auto& [it, success] = worldChunks_.emplace(
-                std::piecewise_construct, std::make_tuple(c_coord.x, c_coord.y), std::make_tuple(c_coord, args...));
-            assert(success); // Attempted to insert at already existent location
-
-            /// Ensures there is an element available for provided coordinate axis
-            auto fill_to_axis = [](auto& dvector, const ChunkCoordAxis coord_axis) {
-                if (coord_axis < 0) {
-                    dvector.reserve(-coord_axis * 2); // Avoid unnecessary resize if short on capacity
-                    while (dvector.size_front() < -coord_axis) {
-                        dvector.emplace_front();
-                    }
-                }
-                else {
-                    dvector.reserve((coord_axis + 1) * 2); // index 0 counts as element
-                    while (dvector.size_back() < coord_axis + 1) {
-                        dvector.emplace_back();
-                    }
-                }
-            };
-
-            fill_to_axis(chunkTexCoordIds_, c_coord.y);
-            fill_to_axis(chunkTexCoordIds_[c_coord.y], c_coord.x);
-
-            return it->second;
+            EraseEncodedChunk(c_coord);
+            return worldChunks_.Emplace(c_coord, args...);
         }
 
         /// Attempts to delete chunk at chunk_x, chunk_y
@@ -113,15 +116,19 @@ namespace jactorio::game
 
 
         /// Retrieves a chunk in game world using chunk coordinates
+        /// Chunk is decoded if it was left encoded when loading
         /// \return nullptr if no chunk exists
         J_NODISCARD Chunk* GetChunkC(const ChunkCoord& c_coord);
 
         /// Retrieves a chunk in game world using chunk coordinates
+        /// Chunk is decoded if it was left encoded when loading, it is kept apart until a non const lookup
+        /// \remark Const lookups may be made concurrently
         /// \return nullptr if no chunk exists
         J_NODISCARD const Chunk* GetChunkC(const ChunkCoord& c_coord) const;
 
 
         /// Gets the chunk at the specified world coordinate
+        /// Chunk is decoded if it was left encoded when loading
         /// \return nullptr if no chunk exists
         J_NODISCARD Chunk* GetChunkW(const WorldCoord& coord);
 
@@ -140,26 +147,124 @@ namespace jactorio::game
         /// \return nullptr if no tile exists
         J_NODISCARD const ChunkTile* GetTile(const WorldCoord& coord, TileLayer tlayer) const;
 
+        /// Gets the resource amount of the resource layer at the specified world coordinate
+        /// \return nullptr if no chunk exists
+        J_NODISCARD ResourceEntityResourceCount* GetResourceAmount(const WorldCoord& coord) noexcept;
+
+        /// Gets the resource amount of the resource layer at the specified world coordinate
+        /// \return nullptr if no chunk exists
+        J_NODISCARD const ResourceEntityResourceCount* GetResourceAmount(const WorldCoord& coord) const noexcept;
+
+
+        // Tile areas
+
+        /// Calls func(const WorldCoord&, ChunkTile&) for each tile in rectangle of dimensions with top left at coord
+        /// Tiles are visited row by row from the top, each row from the left, chunks are looked up once
+        /// \remark Tiles of chunks which do not exist are skipped
+        template <typename TFunc>
+        void ForEachTileInRect(const WorldCoord& coord, const Dimension& dimensions, TileLayer tlayer, TFunc&& func) {
+            VisitTilesInRect(
+                *this, coord, dimensions, [&](const WorldCoord& i_coord, Chunk* chunk, const std::size_t tile_index) {
+                    if (chunk != nullptr) {
+                        func(i_coord, chunk->Tiles(tlayer)[tile_index]);
+                    }
+                    return true;
+                });
+        }
+
+        /// Calls func(const WorldCoord&, const ChunkTile&) for each tile in rectangle of dimensions with top left at
+        /// coord, in the same order as ForEachTileInRect
+        template <typename TFunc>
+        void ForEachTileInRect(const WorldCoord& coord,
+                               const Dimension& dimensions,
+                               TileLayer tlayer,
+                               TFunc&& func) const {
+            VisitTilesInRect(
+                *this,
+                coord,
+                dimensions,
+                [&](const WorldCoord& i_coord, const Chunk* chunk, const std::size_t tile_index) {
+                    if (chunk != nullptr) {
+                        func(i_coord, chunk->Tiles(tlayer)[tile_index]);
+                    }
+                    return true;
+                });
+        }
+
+        /// Visits tiles in the same order as ForEachTileInRect until pred(const WorldCoord&, ChunkTile&) returns true
+        /// \return Tile pred returned true for, nullptr if none
+        template <typename TPred>
+        ChunkTile* FindTileInRect(const WorldCoord& coord,
+                                  const Dimension& dimensions,
+                                  TileLayer tlayer,
+                                  TPred&& pred) {
+            ChunkTile* found = nullptr;
+            VisitTilesInRect(
+                *this, coord, dimensions, [&](const WorldCoord& i_coord, Chunk* chunk, const std::size_t tile_index) {
+                    if (chunk == nullptr)
+                        return true;
+
+                    auto& tile = chunk->Tiles(tlayer)[tile_index];
+                    if (!pred(i_coord, tile))
+                        return true;
+
+                    found = &tile;
+                    return false;
+                });
+            return found;
+        }
+
+        /// Visits tiles in the same order as ForEachTileInRect
+        /// until pred(const WorldCoord&, const ChunkTile&) returns true
+        /// \return Tile pred returned true for, nullptr if none
+        template <typename TPred>
+        const ChunkTile* FindTileInRect(const WorldCoord& coord,
+                                        const Dimension& dimensions,
+                                        TileLayer tlayer,
+                                        TPred&& pred) const {
+            const ChunkTile* found = nullptr;
+            VisitTilesInRect(
+                *this,
+                coord,
+                dimensions,
+                [&](const WorldCoord& i_coord, const Chunk* chunk, const std::size_t tile_index) {
+                    if (chunk == nullptr)
+                        return true;
+
+                    const auto& tile = chunk->Tiles(tlayer)[tile_index];
+                    if (!pred(i_coord, tile))
+                        return true;
+
+                    found = &tile;
+                    return false;
+                });
+            return found;
+        }
+
 
         // Rendering methods
 
 
-        /// \return First: Pointer to contiguous tex coord ids, starting at first tile of requested chunk,
-        /// increments per tile right then down, then next chunk first tile
-        /// \return Second: Number of chunks that can be read from the pointer
-        J_NODISCARD std::pair<SpriteTexCoordIndexT*, int> GetChunkTexCoordIds(const ChunkCoord& c_coord) noexcept;
+        /// \return Tex coord ids of chunk, see Chunk::TexCoordIdArrayT for format, nullptr if no chunk exists
+        J_NODISCARD SpriteTexCoordIndexT* GetChunkTexCoordIds(const ChunkCoord& c_coord) noexcept;
+
+        /// \return Tex coord ids of chunk, see Chunk::TexCoordIdArrayT for format, nullptr if no chunk exists
+        J_NODISCARD const SpriteTexCoordIndexT* GetChunkTexCoordIds(const ChunkCoord& c_coord) const noexcept;
 
-        /// \return First: Pointer to contiguous tex coord ids, starting at first tile of requested chunk,
-        /// increments per tile right then down, then next chunk first tile
-        /// \return Second: Number of chunks that can be read from the pointer
-        J_NODISCARD std::pair<const SpriteTexCoordIndexT*, int> GetChunkTexCoordIds(
-            const ChunkCoord& c_coord) const noexcept;
+        /// Calls func(const ChunkCoord&, const SpriteTexCoordIndexT* tex_ids) for count chunks heading right from
+        /// c_coord, tex_ids is nullptr if the chunk does not exist
+        template <typename TFunc>
+        void ForEachChunkTexCoordIds(const ChunkCoord& c_coord, const int count, TFunc&& func) const {
+            worldChunks_.ForEachInRow(c_coord, count, [&func](const ChunkCoord& coord, const Chunk* chunk) {
+                func(coord, chunk != nullptr ? chunk->TexCoordIds().data() : nullptr);
+            });
+        }
 
 
-        /// \return tex coord id at given coord and layer
+        /// \return tex coord id at given coord and layer, 0 if no chunk exists
         J_NODISCARD SpriteTexCoordIndexT GetTexCoordId(const WorldCoord& coord, TileLayer layer) const noexcept;
 
-        /// Sets tex coord id for given world coord at layer
+        /// Sets tex coord id for given world coord at layer, a chunk must exist at coord
         void SetTexCoordId(const WorldCoord& coord, TileLayer layer, SpriteTexCoordIndexT id) noexcept;
 
         /// Sets tex coord id for given chunk coord, chunk tile coord at layer
@@ -206,11 +311,18 @@ namespace jactorio::game
         void LogicRegister(LogicGroup group, const WorldCoord& coord, TileLayer tlayer);
 
         /// Removes a group at tlayer at coord from being considered for logic updates
+        /// \remark The last object in group takes the place of the removed object
         void LogicRemove(LogicGroup group, const WorldCoord& coord, TileLayer tlayer);
 
+        /// \remark Objects must be added or removed with LogicRegister and LogicRemove
         J_NODISCARD LogicListT& LogicGet(LogicGroup group);
         J_NODISCARD const LogicListT& LogicGet(LogicGroup group) const;
 
+        /// Marked stale whenever conveyors are registered or removed
+        J_NODISCARD ConveyorActiveSet& GetConveyorActiveSet() noexcept {
+            return *conveyorActiveSet_;
+        }
+
         // ======================================================================
         // World generation
 
@@ -223,14 +335,29 @@ namespace jactorio::game
 
 
         /// Queues a chunk to be generated at specified position
-        /// \remark To be called from render thread only
+        /// \remark Can be called from multiple threads, e.g: render threads, but not while the world is modified
         void QueueChunkGeneration(const ChunkCoord& c_coord) const;
 
-        /// Takes first in from chunk generation queue and generates chunk
-        /// Call once per logic loop tick to generate one chunk only, this keeps performance constant
-        /// when generating large amounts of chunks
+        /// Queued chunks nearest to a chunk in focus are generated first, e.g: the chunk each player views
+        void SetGenerationFocus(std::vector<ChunkCoord> focus);
+
+        /// Takes nearest to focus from chunk generation queue and generates chunk
         void GenChunk(const data::PrototypeManager& proto, uint8_t amount = 1);
 
+        /// Adds chunks finished generating on pool to the world until budget is used,
+        /// then takes nearest to focus from chunk generation queue to keep the pool's threads busy
+        /// Generated chunks are identical to those from GenChunk without a pool
+        /// \param budget Time to spend adding chunks to the world, at least one chunk is added if finished
+        /// \remark proto must not be modified while chunks are generating
+        void GenChunk(ThreadPool& pool, const data::PrototypeManager& proto, std::chrono::microseconds budget);
+
+        /// Generates every queued chunk on pool, returns once all are added to the world
+        /// \remark proto must not be modified while chunks are generating
+        void GenChunkAll(ThreadPool& pool, const data::PrototypeManager& proto);
+
+        /// Waits for chunks generating on a pool, then adds them to the world
+        void GenChunkFinish();
+
 
         // ======================================================================
 
@@ -248,33 +375,373 @@ namespace jactorio::game
 
 
         /// To be used after deserializing
+        /// Decodes chunks left encoded neighboring chunks with entities, which logic of the entities may reach into
         /// Steps through all chunks:
         /// Dispatches OnDeserialize(),
         /// Sets the top left tile for all multi tile tiles as its pointer cannot be serialized
         void DeserializePostProcess();
 
 
-        CEREAL_SERIALIZE(archive) {
-            // NOTE: Unique data is only available after deserializing worldChunks_
-            archive(updateDispatcher, chunkTexCoordIds_, worldChunks_, logicLists_, worldGenSeed_);
+        /// Decodes chunks left encoded when loading within radius chunks of center
+        void LoadEncodedChunks(const ChunkCoord& center, ChunkCoordAxis radius);
+
+        /// Pooled unique data of chunks in this world is allocated from here, released by Clear
+        J_NODISCARD proto::UniqueDataPool& GetUniqueDataPool() noexcept {
+            return *uniqueDataPool_;
+        }
+
+        /// \return Number of chunks left encoded when loading, which no non const lookup has decoded
+        J_NODISCARD std::size_t GetEncodedChunkCount() const noexcept {
+            return encodedChunks_.size();
+        }
+
+
+        CEREAL_SAVE(archive) {
+            std::vector<const Chunk*> chunks;
+            chunks.reserve(worldChunks_.Size());
+            worldChunks_.ForEach([&chunks](const Chunk& chunk) { chunks.push_back(&chunk); });
+
+            // NOTE: Unique data is only available after deserializing chunks
+            archive(updateDispatcher);
+            SaveChunks(archive, chunks, encodedChunks_);
+            archive(logicLists_, worldGenSeed_);
+        }
+
+        /// Chunks which nothing outside themselves refer to are left encoded, see LoadEncodedChunks
+        CEREAL_LOAD(archive) {
+            DiscardPendingChunks();
+            encodedChunks_.clear();
+            constDecoded_->chunks.clear();
+
+            proto::UniqueDataPool::Scope scope(*uniqueDataPool_);
+
+            if (data::active_save_version < data::kSaveVersionChunkTexCoords) {
+                DVector<DVector<Chunk::TexCoordIdArrayT>> tex_coord_ids;
+                archive(updateDispatcher, tex_coord_ids, worldChunks_, logicLists_, worldGenSeed_);
+                LoadLegacyTexCoordIds(tex_coord_ids);
+            }
+            else if (data::active_save_version < data::kSaveVersionParallelChunks) {
+                archive(updateDispatcher, worldChunks_, logicLists_, worldGenSeed_);
+            }
+            else {
+                archive(updateDispatcher);
+
+                worldChunks_.Clear();
+                for (auto& chunk : LoadChunks(archive, *uniqueDataPool_, &encodedChunks_)) {
+                    const auto c_coord = chunk->GetPosition();
+                    worldChunks_.Insert(c_coord, std::move(chunk));
+                }
+
+                archive(logicLists_, worldGenSeed_);
+            }
+            LogicRebuildIndex();
+        }
+
+
+        // Incremental saves - Dirty chunks and data outside chunks, appended to a save of the world
+
+        /// Call once world is saved, chunks are left out of increments until modified
+        void MarkSaved();
+
+        /// Saves chunks modified since MarkSaved or holding unique data, chunks deleted since MarkSaved and all data
+        /// outside chunks
+        template <typename TArchive>
+        void SaveIncrement(TArchive& archive) const {
+            std::vector<const Chunk*> dirty_chunks;
+            worldChunks_.ForEach([&dirty_chunks](const Chunk& chunk) {
+                if (chunk.IsDirty()) {
+                    dirty_chunks.push_back(&chunk);
+                }
+            });
+
+            archive(updateDispatcher, deletedChunks_);
+            SaveChunks(archive, dirty_chunks, {});
+            archive(logicLists_, worldGenSeed_);
+        }
+
+        /// Applies increment from SaveIncrement onto world loaded from the save it was appended to
+        template <typename TArchive>
+        void LoadIncrement(TArchive& archive) {
+            DiscardPendingChunks();
+
+            proto::UniqueDataPool::Scope scope(*uniqueDataPool_);
+
+            std::vector<ChunkCoord> deleted_chunks;
+            archive(updateDispatcher, deleted_chunks);
+
+            // Chunks deleted were deleted before chunks in increment were saved
+            for (const auto& c_coord : deleted_chunks) {
+                worldChunks_.Erase(c_coord);
+                EraseEncodedChunk(c_coord);
+            }
+
+            std::vector<std::unique_ptr<Chunk>> chunks;
+            if (data::active_save_version < data::kSaveVersionParallelChunks) {
+                cereal::size_type size;
+                archive(cereal::make_size_tag(size));
+                for (cereal::size_type i = 0; i < size; ++i) {
+                    archive(*chunks.emplace_back(std::make_unique<Chunk>()));
+                }
+            }
+            else {
+                chunks = LoadChunks(archive, *uniqueDataPool_);
+            }
+
+            for (auto& chunk : chunks) {
+                const auto c_coord = chunk->GetPosition();
+                worldChunks_.Erase(c_coord);
+                EraseEncodedChunk(c_coord);
+                worldChunks_.Insert(c_coord, std::move(chunk));
+            }
+
+            archive(logicLists_, worldGenSeed_);
+            LogicRebuildIndex();
         }
 
         UpdateDispatcher updateDispatcher;
 
     private:
-        using ChunkKey    = std::tuple<ChunkCoordAxis, ChunkCoordAxis>;
-        using ChunkHasher = hash<ChunkKey>;
+        using LogicKey    = std::tuple<WorldCoordAxis, WorldCoordAxis>;
+        using LogicIndexT = std::unordered_map<LogicKey, std::size_t, hash<LogicKey>>;
+
+        using ChunkKey = std::tuple<ChunkCoordAxis, ChunkCoordAxis>;
+        /// Serialized chunks, shared with tasks decoding them
+        using EncodedChunksT = std::unordered_map<ChunkKey, std::shared_ptr<const std::string>, hash<ChunkKey>>;
+
+        /// Lists a chunk serialized into its own buffer, buffers follow the directory in the order listed
+        struct ChunkBufferEntry
+        {
+            ChunkCoord coord;
+            /// Bytes in buffer
+            uint64_t size = 0;
+            /// Chunk::IsStandalone, can be decoded after the rest of the save is loaded
+            bool standalone = false;
+
+            CEREAL_SERIALIZE(archive) {
+                archive(coord, size);
+                if (data::active_save_version >= data::kSaveVersionLazyChunks) {
+                    archive(standalone);
+                }
+            }
+        };
+
+        /// Serializes each chunk into its own buffer, in parallel on pool if set
+        /// \param directory Set to entry of each buffer
+        static std::vector<std::string> EncodeChunks(const std::vector<const Chunk*>& chunks,
+                                                     std::vector<ChunkBufferEntry>& directory,
+                                                     ThreadPool* pool = data::active_thread_pool);
+
+        /// Deserializes buffer from EncodeChunks
+        /// \param pool Pooled unique data of the chunk is allocated from here
+        static std::unique_ptr<Chunk> DecodeChunk(const std::string& buffer, proto::UniqueDataPool& pool);
+
+        /// Deserializes each buffer from EncodeChunks, in parallel on data::active_thread_pool if set
+        /// \exception std::runtime_error Chunk does not match its directory entry
+        static std::vector<std::unique_ptr<Chunk>> DecodeChunks(const std::vector<ChunkBufferEntry>& directory,
+                                                                const std::vector<std::string>& buffers,
+                                                                proto::UniqueDataPool& pool);
+
+        /// Writes directory of chunks, then each chunk's buffer
+        /// \param encoded Written as is after chunks
+        template <typename TArchive>
+        static void SaveChunks(TArchive& archive,
+                               const std::vector<const Chunk*>& chunks,
+                               const EncodedChunksT& encoded) {
+            if (DeferSaveChunks(chunks, encoded))
+                return;
+
+            std::vector<ChunkBufferEntry> directory;
+            const auto buffers = EncodeChunks(chunks, directory);
+            WriteChunks(archive, std::move(directory), buffers, encoded);
+        }
+
+        /// Writes what SaveChunks does into data::active_deferred_save
+        /// Standalone chunks are copied and encoded when the save is finished, others have unique data which is
+        /// assigned ids the rest of the save refers to and are encoded now
+        /// \return false if there is no active deferred save, nothing is written
+        static bool DeferSaveChunks(const std::vector<const Chunk*>& chunks, const EncodedChunksT& encoded);
+
+        /// \param buffers Buffer for each entry of directory
+        template <typename TArchive>
+        static void WriteChunks(TArchive& archive,
+                                std::vector<ChunkBufferEntry> directory,
+                                const std::vector<std::string>& buffers,
+                                const EncodedChunksT& encoded) {
+            // Encoded chunks are only kept from saves of the current version, no need to reencode
+            for (const auto& [key, buffer] : encoded) {
+                directory.push_back({{std::get<0>(key), std::get<1>(key)}, buffer->size(), true});
+            }
+
+            archive(directory);
+            for (const auto& buffer : buffers) {
+                archive(cereal::binary_data(buffer.data(), buffer.size()));
+            }
+            for (const auto& [key, buffer] : encoded) {
+                archive(cereal::binary_data(buffer->data(), buffer->size()));
+            }
+        }
+
+        /// Reads chunks written by SaveChunks
+        /// \param pool Pooled unique data of chunks is allocated from here
+        /// \param encoded If not nullptr, standalone chunks are moved here undecoded
+        template <typename TArchive>
+        static std::vector<std::unique_ptr<Chunk>> LoadChunks(TArchive& archive,
+                                                              proto::UniqueDataPool& pool,
+                                                              EncodedChunksT* encoded = nullptr) {
+            std::vector<ChunkBufferEntry> directory;
+            archive(directory);
+
+            std::vector<ChunkBufferEntry> decode_directory;
+            std::vector<std::string> decode_buffers;
+            for (const auto& entry : directory) {
+                std::string buffer(SafeCast<std::size_t>(entry.size), '\0');
+                archive(cereal::binary_data(buffer.data(), buffer.size()));
+
+                // Decoded after loading finishes, when data::active_save_version is kSaveVersion
+                if (encoded != nullptr && entry.standalone && data::active_save_version == data::kSaveVersion) {
+                    (*encoded)[{entry.coord.x, entry.coord.y}] = std::make_shared<const std::string>(std::move(buffer));
+                }
+                else {
+                    decode_directory.push_back(entry);
+                    decode_buffers.push_back(std::move(buffer));
+                }
+            }
+
+            return DecodeChunks(decode_directory, decode_buffers, pool);
+        }
+
+        /// Chunk generated without access to the world, not yet added to the world
+        struct GeneratedChunk
+        {
+            std::unique_ptr<Chunk> chunk;
+            /// Chunk was decoded from encodedChunks_ instead of generated
+            bool decoded = false;
+        };
+
+        struct PendingChunk
+        {
+            ChunkCoord coord;
+            /// Shared with the generating task
+            std::shared_ptr<GeneratedChunk> generated;
+            std::future<void> done;
+        };
+
+        /// Generates chunk at c_coord, depends only on plan and c_coord
+        static void GenerateChunk(const WorldGenPlan& plan, const ChunkCoord& c_coord, GeneratedChunk& generated);
+
+        /// \return Plan for generating chunks with proto and the current seed, built if the seed or proto changed
+        const std::shared_ptr<const WorldGenPlan>& GetGenerationPlan(const data::PrototypeManager& proto);
+
+        /// Adds generated chunk to the world, discarded if a chunk already exists at its position
+        void CommitGeneratedChunk(GeneratedChunk& generated);
+
+        /// Takes nearest to focus from chunk generation queue and submits to pool until enough are generating
+        void SubmitQueuedChunks(ThreadPool& pool, const data::PrototypeManager& proto);
+
+        /// Waits for chunks generating on a pool without adding them to the world
+        void DiscardPendingChunks() noexcept;
+
+        /// Decodes chunks in c_coords left encoded when loading, others are ignored
+        void DecodeEncodedChunks(const std::vector<ChunkCoord>& c_coords);
+
+        /// Erases chunk at c_coord left encoded when loading, and the chunk a const lookup decoded from it
+        void EraseEncodedChunk(const ChunkCoord& c_coord);
+
+        /// Erases chunk left encoded when loading
+        /// \return Chunk decoded from it, taken from constDecoded_ if a const lookup decoded it
+        std::unique_ptr<Chunk> TakeEncodedChunk(EncodedChunksT::const_iterator encoded);
+
+        /// Copies tex coord ids of saves prior to kSaveVersionChunkTexCoords into each chunk
+        /// \param tex_coord_ids Indexed by chunk y, then chunk x
+        void LoadLegacyTexCoordIds(const DVector<DVector<Chunk::TexCoordIdArrayT>>& tex_coord_ids);
+
+        /// Recreates logicIndices_ from logicLists_
+        void LogicRebuildIndex();
+
+        /// Calls func(const WorldCoord&, Chunk*, std::size_t tile_index) for each tile in rectangle of dimensions
+        /// with top left at coord, until func returns false. Chunk is nullptr if it does not exist
+        /// \param world World or const World, chunks are const if world is
+        /// \return false if func returned false
+        template <typename TWorld, typename TFunc>
+        static bool VisitTilesInRect(TWorld& world,
+                                     const WorldCoord& coord,
+                                     const Dimension& dimensions,
+                                     TFunc&& func) {
+            if (dimensions.x == 0 || dimensions.y == 0)
+                return true;
+
+            const WorldCoord end{coord.x + dimensions.x, coord.y + dimensions.y};
+
+            const auto first_chunk_x = WorldCToChunkC(coord.x);
+            const auto chunk_columns = SafeCast<std::size_t>(WorldCToChunkC(end.x - 1) - first_chunk_x + 1);
+
+            // Chunks of the current row of chunks, most rectangles span few chunks
+            constexpr std::size_t kInlineColumns = 4;
+            using ChunkPtrT = decltype(world.GetChunkC(ChunkCoord{}));
+            std::array<ChunkPtrT, kInlineColumns> inline_chunks{};
+            std::vector<ChunkPtrT> large_chunks;
+            ChunkPtrT* chunks = inline_chunks.data();
+            if (chunk_columns > kInlineColumns) {
+                large_chunks.resize(chunk_columns);
+                chunks = large_chunks.data();
+            }
+
+            for (auto chunk_y = WorldCToChunkC(coord.y); chunk_y <= WorldCToChunkC(end.y - 1); ++chunk_y) {
+                for (std::size_t column = 0; column < chunk_columns; ++column) {
+                    chunks[column] = world.GetChunkC({first_chunk_x + SafeCast<ChunkCoordAxis>(column), chunk_y});
+                }
 
-        DVector<DVector<TexCoordIdArrayT>> chunkTexCoordIds_;
+                const auto row_end = std::min(end.y, ChunkCToWorldC(chunk_y + 1));
+                for (auto y = std::max(coord.y, ChunkCToWorldC(chunk_y)); y < row_end; ++y) {
+                    const auto row_index = SafeCast<std::size_t>(Chunk::WorldCToChunkTileC(y)) * Chunk::kChunkWidth;
+
+                    auto x = coord.x;
+                    for (std::size_t column = 0; column < chunk_columns; ++column) {
+                        const auto column_end =
+                            std::min(end.x, ChunkCToWorldC(first_chunk_x + SafeCast<ChunkCoordAxis>(column) + 1));
+
+                        for (; x < column_end; ++x) {
+                            if (!func(WorldCoord{x, y}, chunks[column], row_index + Chunk::WorldCToChunkTileC(x)))
+                                return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
 
+        /// Destroyed after chunks, which hold unique data allocated from it
+        std::unique_ptr<proto::UniqueDataPool> uniqueDataPool_;
         /// Chunks increment heading right and down
-        std::unordered_map<ChunkKey, Chunk, ChunkHasher> worldChunks_;
+        ChunkDirectory worldChunks_;
+        /// Chunks deleted since MarkSaved
+        std::vector<ChunkCoord> deletedChunks_;
+        /// Standalone chunks of the loaded save not yet decoded, not in worldChunks_
+        EncodedChunksT encodedChunks_;
+
+        struct ConstDecodedChunks
+        {
+            /// Held exclusively while decoding
+            std::shared_mutex mutex;
+            std::unordered_map<ChunkKey, std::unique_ptr<Chunk>, hash<ChunkKey>> chunks;
+        };
+        /// Chunks of encodedChunks_ decoded by const lookups, which cannot modify them, so their buffers still match
+        /// Moved to worldChunks_ by non const lookups. Kept on heap as worlds are moved
+        std::unique_ptr<ConstDecodedChunks> constDecoded_;
         std::array<LogicListT, kLogicGroupCount> logicLists_;
+        /// Index of each coord within logicLists_, not serialized
+        std::array<LogicIndexT, kLogicGroupCount> logicIndices_;
+        /// Kept on heap as sleeping conveyors hold a pointer to its wake list
+        std::shared_ptr<ConveyorActiveSet> conveyorActiveSet_;
 
 
         int worldGenSeed_ = 1001;
-        /// Stores whether or not a chunk is being generated, this gets cleared once all world generation is done
-        mutable std::set<ChunkKey> worldGenChunks_;
+        /// Chunks to generate, pushed to by render threads
+        mutable ChunkGenerationQueue worldGenQueue_;
+        /// Shared with chunks generating on a pool
+        std::shared_ptr<const WorldGenPlan> worldGenPlan_;
+        /// Chunks generating on a pool, in order submitted
+        std::deque<PendingChunk> worldGenPending_;
     };
 } // namespace jactorio::game
 
@@ -0,0 +1,100 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_GAME_WORLD_WORLD_GEN_PLAN_H
+#define JACTORIO_INCLUDE_GAME_WORLD_WORLD_GEN_PLAN_H
+#pragma once
+
+#include "jactorio.h"
+
+#include <vector>
+
+#include "core/convert.h"
+#include "core/data_type.h"
+#include "game/world/perlin_noise.h"
+#include "proto/noise_layer.h"
+
+namespace jactorio::data
+{
+    class PrototypeManager;
+}
+
+namespace jactorio::game
+{
+    /// Noise layers sorted and configured for generating chunks, built once for a prototype manager and seed
+    /// \remark Read only once built, shared by threads generating chunks
+    /// \remark Built after sprites are assigned tex coord ids, prototypes must not change while it is used
+    class WorldGenPlan
+    {
+    public:
+        /// Noise layer with its noise properties, ranges flattened into arrays
+        template <typename T>
+        struct Layer
+        {
+            const proto::NoiseLayer<T>* noiseLayer = nullptr;
+            PerlinParams params;
+
+            bool normalize = false;
+            /// Inclusive start of each range, followed by the end of the last range
+            std::vector<float> ranges;
+            /// Prototype of each range, size is 1 less than ranges
+            std::vector<const T*> prototypes;
+            /// Tex coord id of each prototype's sprite, 0 if none
+            std::vector<SpriteTexCoordIndexT> texCoordIds;
+
+            /// Same range as NoiseLayer::Get and NoiseLayer::GetValNoiseRange
+            /// \return Index of range noise_val is within, -1 if none
+            J_NODISCARD int FindRange(float noise_val) const noexcept;
+        };
+
+        WorldGenPlan() = default;
+
+        /// Collects all noise layers in proto
+        WorldGenPlan(const data::PrototypeManager& proto, int seed);
+
+        /// \return true if plan was built from proto and seed
+        J_NODISCARD bool IsBuiltFrom(const data::PrototypeManager& proto, const int seed) const noexcept {
+            return proto_ == &proto && seed_ == seed;
+        }
+
+        /// Tile noise layers, ascending order
+        J_NODISCARD const std::vector<Layer<proto::Tile>>& GetTileLayers() const noexcept {
+            return tileLayers_;
+        }
+
+        /// Entity noise layers, ascending order
+        J_NODISCARD const std::vector<Layer<proto::Entity>>& GetEntityLayers() const noexcept {
+            return entityLayers_;
+        }
+
+    private:
+        const data::PrototypeManager* proto_ = nullptr;
+        int seed_                           = 0;
+
+        std::vector<Layer<proto::Tile>> tileLayers_;
+        std::vector<Layer<proto::Entity>> entityLayers_;
+    };
+
+    template <typename T>
+    int WorldGenPlan::Layer<T>::FindRange(float noise_val) const noexcept {
+        assert(!ranges.empty());
+
+        if (normalize) {
+            if (noise_val > ranges.back())
+                noise_val = ranges.back();
+            if (noise_val < ranges.front())
+                noise_val = ranges.front();
+        }
+
+        // Ending range is inclusive for the last range only
+        for (auto i = ranges.size() - 1; i > 0; --i) {
+            if (i == ranges.size() - 1 ? noise_val > ranges[i] : noise_val >= ranges[i])
+                continue;
+
+            if (noise_val >= ranges[i - 1])
+                return SafeCast<int>(i - 1);
+        }
+        return -1;
+    }
+} // namespace jactorio::game
+
+#endif // JACTORIO_INCLUDE_GAME_WORLD_WORLD_GEN_PLAN_H
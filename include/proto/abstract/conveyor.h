@@ -4,9 +4,12 @@
 #define JACTORIO_INCLUDE_PROTO_ABSTRACT_CONVEYOR_H
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "core/data_type.h"
+#include "data/globals.h"
+#include "data/unique_data_manager.h"
 #include "game/logic/conveyor_struct.h"
 #include "proto/abstract/health_entity.h"
 
@@ -16,6 +19,8 @@ namespace jactorio::proto
 {
     struct ConveyorData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(ConveyorData);
+
         ConveyorData() = default;
 
         explicit ConveyorData(std::shared_ptr<game::ConveyorStruct> line_segment)
@@ -29,16 +34,26 @@ namespace jactorio::proto
         uint8_t structIndex = 0;
 
 
-        CEREAL_SERIALIZE(archive) {
-            archive(structure, structIndex, cereal::base_class<HealthEntityData>(this));
+        CEREAL_SAVE(archive) {
+            // Structure may span chunks serialized separately, its address identifies its copies when loading
+            const auto struct_key = static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(structure.get()));
+            archive(structure, struct_key, structIndex, cereal::base_class<HealthEntityData>(this));
         }
 
-        CEREAL_LOAD_CONSTRUCT(archive, construct, ConveyorData) {
-            std::shared_ptr<game::ConveyorStruct> line_segment;
-            archive(line_segment);
-            construct(line_segment);
+        CEREAL_LOAD(archive) {
+            archive(structure);
+
+            if (data::active_save_version >= data::kSaveVersionParallelChunks) {
+                uint64_t struct_key;
+                archive(struct_key);
+
+                if (structure != nullptr) {
+                    assert(data::active_unique_data_manager != nullptr);
+                    structure = data::active_unique_data_manager->StoreSharedEntry(struct_key, structure);
+                }
+            }
 
-            archive(construct->structIndex, cereal::base_class<HealthEntityData>(construct.ptr()));
+            archive(structIndex, cereal::base_class<HealthEntityData>(this));
         }
     };
 
@@ -16,6 +16,8 @@ namespace jactorio::proto
 
     struct AssemblyMachineData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(AssemblyMachineData);
+
         J_NODISCARD bool HasRecipe() const {
             return recipe_ != nullptr;
         }
@@ -11,6 +11,8 @@ namespace jactorio::proto
 {
     struct ContainerEntityData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(ContainerEntityData);
+
         ContainerEntityData() = default;
 
         explicit ContainerEntityData(const uint16_t inventory_size) {
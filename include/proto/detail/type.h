@@ -15,8 +15,8 @@ namespace jactorio::proto
     // Defines types for prototype classes
 
     /// Conveyor item distance
-    using LineDistT       = Decimal3T;
-    using RotationDegreeT = Decimal3T;
+    using LineDistT       = FixedDecimal3T;
+    using RotationDegreeT = FixedDecimal3T;
 
     /// <Entry direction>_<Exit direction>
     enum class LineOrientation
@@ -15,6 +15,7 @@
 #include "proto/detail/category.h"
 #include "proto/detail/exception.h"
 #include "proto/detail/python_prop.h"
+#include "proto/framework/unique_data_pool.h"
 
 #include <cereal/types/base_class.hpp>
 #include <cereal/types/polymorphic.hpp>
@@ -86,6 +87,19 @@ namespace jactorio::proto
     }                                                                                            \
     static_assert(true)
 
+/// Allocates unique data of data_ty__ from the current UniqueDataPool, keeping the unique data of each type contiguous
+/// \remark Cereal must construct data_ty__ with new, not load_and_construct
+#define UNIQUE_DATA_POOLED(data_ty__)                                                     \
+    static void* operator new(const std::size_t size) {                                   \
+        assert(size == sizeof(data_ty__));                                                \
+        (void)size;                                                                       \
+        return jactorio::proto::UniqueDataPool::Current().Get<data_ty__>().Allocate();    \
+    }                                                                                     \
+    static void operator delete(void* ptr) noexcept {                                     \
+        jactorio::SlabPool<data_ty__>::Deallocate(ptr);                                   \
+    }                                                                                     \
+    static_assert(true)
+
 #define PROTOTYPE_DATA_TRIVIAL_COPY(data_ty__)                                                 \
     std::unique_ptr<UniqueDataBase> CopyUniqueData(const UniqueDataBase* ptr) const override { \
         return std::make_unique<data_ty__>(*SafeCast<const data_ty__*>(ptr));                  \
@@ -0,0 +1,114 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#ifndef JACTORIO_INCLUDE_PROTO_FRAMEWORK_UNIQUE_DATA_POOL_H
+#define JACTORIO_INCLUDE_PROTO_FRAMEWORK_UNIQUE_DATA_POOL_H
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "jactorio.h"
+
+#include "core/slab_pool.h"
+
+namespace jactorio::proto
+{
+    /// Slab pools of each unique data type using UNIQUE_DATA_POOLED, each World has its own
+    /// \remark Thread safe
+    class UniqueDataPool
+    {
+    public:
+        UniqueDataPool()  = default;
+        ~UniqueDataPool() = default;
+
+        UniqueDataPool(const UniqueDataPool& other)     = delete;
+        UniqueDataPool(UniqueDataPool&& other) noexcept = delete;
+        UniqueDataPool& operator=(const UniqueDataPool& other) = delete;
+        UniqueDataPool& operator=(UniqueDataPool&& other) noexcept = delete;
+
+        /// Makes pool the current pool of the calling thread until destroyed
+        class Scope
+        {
+        public:
+            explicit Scope(UniqueDataPool& pool) noexcept : previous_(current_) {
+                current_ = &pool;
+            }
+
+            ~Scope() {
+                current_ = previous_;
+            }
+
+            Scope(const Scope& other)     = delete;
+            Scope(Scope&& other) noexcept = delete;
+            Scope& operator=(const Scope& other) = delete;
+            Scope& operator=(Scope&& other) noexcept = delete;
+
+        private:
+            UniqueDataPool* previous_;
+        };
+
+        /// Pooled unique data is allocated from this
+        /// \return Pool of innermost Scope on the calling thread, otherwise a process wide pool for unique data
+        /// created outside of a world
+        J_NODISCARD static UniqueDataPool& Current() noexcept;
+
+        /// \return Pool of TData, created if it does not exist
+        template <typename TData>
+        J_NODISCARD SlabPool<TData>& Get();
+
+        /// Frees memory of all pooled unique data at once
+        /// \remark All unique data allocated from this must be destroyed
+        void Release() noexcept;
+
+    private:
+        struct PoolBase
+        {
+            virtual ~PoolBase()             = default;
+            virtual void Release() noexcept = 0;
+        };
+
+        template <typename TData>
+        struct Pool final : PoolBase
+        {
+            void Release() noexcept override {
+                slabPool.Release();
+            }
+
+            SlabPool<TData> slabPool;
+        };
+
+        /// \return Index for a type within pools_
+        static std::size_t NextTypeIndex() noexcept;
+
+        template <typename TData>
+        static std::size_t TypeIndex() noexcept {
+            static const std::size_t index = NextTypeIndex();
+            return index;
+        }
+
+        static inline thread_local UniqueDataPool* current_ = nullptr;
+
+        std::mutex poolsMutex_;
+        std::vector<std::unique_ptr<PoolBase>> pools_;
+    };
+
+    template <typename TData>
+    SlabPool<TData>& UniqueDataPool::Get() {
+        const auto index = TypeIndex<TData>();
+
+        std::lock_guard<std::mutex> guard(poolsMutex_);
+        if (index >= pools_.size()) {
+            pools_.resize(index + 1);
+        }
+
+        auto& pool = pools_[index];
+        if (pool == nullptr) {
+            pool = std::make_unique<Pool<TData>>();
+        }
+        return static_cast<Pool<TData>&>(*pool).slabPool;
+    }
+} // namespace jactorio::proto
+
+#endif // JACTORIO_INCLUDE_PROTO_FRAMEWORK_UNIQUE_DATA_POOL_H
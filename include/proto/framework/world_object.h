@@ -21,6 +21,10 @@ namespace jactorio::proto
     class FWorldObject : public FrameworkBase, public IRenderable, public ISerializable
     {
     public:
+        /// Stored by chunk tiles in place of a pointer to this, resolved with PrototypeManager::TilePrototypeGet
+        /// Assigned when added to a prototype manager, 0 indicates invalid id
+        TilePrototypeIdT tilePrototypeId = 0;
+
         /// If true, swaps width and height when orientation is left or right in Getters
         PYTHON_PROP_REF_I(bool, rotateDimensions, true);
 
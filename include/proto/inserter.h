@@ -4,8 +4,7 @@
 #define JACTORIO_INCLUDE_PROTO_INSERTER_H
 #pragma once
 
-#include <decimal.h>
-
+#include "data/cereal/support/fixed_point.h"
 #include "game/logic/inserter_controller.h"
 #include "game/logic/item_logistics.h"
 #include "game/logistic/inventory.h"
@@ -16,6 +15,8 @@ namespace jactorio::proto
     /// Holds the internal structure for inserters
     struct InserterData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(InserterData);
+
         explicit InserterData(const Orientation orientation)
             : orientation(orientation), dropoff(orientation), pickup(orientation) {}
 
@@ -41,20 +42,23 @@ namespace jactorio::proto
         game::InserterPickup pickup;
 
 
-        CEREAL_SERIALIZE(archive) {
+        CEREAL_SAVE(archive) {
             archive(orientation, rotationDegree, status, heldItem, cereal::base_class<HealthEntityData>(this));
         }
 
-        CEREAL_LOAD_CONSTRUCT(archive, construct, InserterData) {
-            Orientation orientation;
+        CEREAL_LOAD(archive) {
             archive(orientation);
-            construct(orientation);
+            dropoff = game::ItemDropOff(orientation);
+            pickup  = game::InserterPickup(orientation);
 
-            archive(construct->rotationDegree,
-                    construct->status,
-                    construct->heldItem,
-                    cereal::base_class<HealthEntityData>(construct.ptr()));
+            archive(rotationDegree, status, heldItem, cereal::base_class<HealthEntityData>(this));
         }
+
+    private:
+        friend class cereal::access;
+
+        /// Cereal allocates unique data with new so it is pooled, orientation is set when loading
+        InserterData() : InserterData(Orientation::up) {}
     };
 
 
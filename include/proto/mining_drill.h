@@ -4,6 +4,8 @@
 #define JACTORIO_INCLUDE_PROTO_MINING_DRILL_H
 #pragma once
 
+#include <vector>
+
 #include "game/logic/deferral_timer.h"
 #include "game/logic/item_logistics.h"
 #include "proto/abstract/health_entity.h"
@@ -13,6 +15,8 @@ namespace jactorio::proto
 {
     struct MiningDrillData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(MiningDrillData);
+
         explicit MiningDrillData(const Orientation orientation) : output(orientation) {}
 
         game::ItemDropOff output;
@@ -25,6 +29,9 @@ namespace jactorio::proto
         WorldCoord resourceCoord;
         /// Resource to mine offset to the right wrapping down (wrap on miningRadius)
         uint16_t resourceOffset = 0;
+        /// Offsets of resources in mining area to mine after resourceOffset, mined from the back
+        /// \remark Not serialized, rebuilt in OnDeserialize
+        std::vector<uint16_t> resourceOffsets;
 
 
         /// Base number of ticks to mine resource with no modifiers applied (mining speed, boosts, ...)
@@ -33,7 +40,7 @@ namespace jactorio::proto
         game::DeferralTimer::DeferralEntry deferralEntry;
 
 
-        CEREAL_SERIALIZE(archive) {
+        CEREAL_SAVE(archive) {
             archive(output.GetOrientation(),
                     outputTile,
                     outputItem,
@@ -44,19 +51,25 @@ namespace jactorio::proto
                     cereal::base_class<HealthEntityData>(this));
         }
 
-        CEREAL_LOAD_CONSTRUCT(archive, construct, MiningDrillData) {
+        CEREAL_LOAD(archive) {
             Orientation orientation;
             archive(orientation);
-            construct(orientation);
-
-            archive(construct->outputTile,
-                    construct->outputItem,
-                    construct->resourceCoord,
-                    construct->resourceOffset,
-                    construct->miningTicks,
-                    construct->deferralEntry,
-                    cereal::base_class<HealthEntityData>(construct.ptr()));
+            output = game::ItemDropOff(orientation);
+
+            archive(outputTile,
+                    outputItem,
+                    resourceCoord,
+                    resourceOffset,
+                    miningTicks,
+                    deferralEntry,
+                    cereal::base_class<HealthEntityData>(this));
         }
+
+    private:
+        friend class cereal::access;
+
+        /// For cereal, output orientation is set when loading
+        MiningDrillData() : MiningDrillData(Orientation::up) {}
     };
 
 
@@ -128,11 +141,25 @@ namespace jactorio::proto
         J_NODISCARD int GetMiningAreaX(Orientation orien) const;
         /// \param orien Orientation of drill
         J_NODISCARD int GetMiningAreaY(Orientation orien) const;
+        /// \param orien Orientation of drill
+        J_NODISCARD Dimension GetMiningArea(Orientation orien) const;
 
         /// Sets up drill data such that resources can be deducted from the ground
         /// \return true if a resource was found, otherwise false
         bool SetupResourceDeduction(const game::World& world, MiningDrillData& drill_data, Orientation orien) const;
 
+        /// Fills resourceOffsets of drill_data with every resource in mining area
+        void FindResources(const game::World& world, MiningDrillData& drill_data, Orientation orien) const;
+
+        /// Takes the next resource from resourceOffsets of drill_data which has not been depleted
+        /// \return true if a resource was taken, otherwise false
+        bool TakeNextResource(const game::World& world, MiningDrillData& drill_data, Orientation orien) const;
+
+        /// \return World coord of resource at resource_offset in mining area
+        J_NODISCARD WorldCoord GetResourceCoord(const MiningDrillData& drill_data,
+                                                uint16_t resource_offset,
+                                                Orientation orien) const;
+
         /// Removes resource using resourceCoord + resourceOffset in drill_data, searches for another resource if
         /// depleted
         /// \param orien Orientation of drill
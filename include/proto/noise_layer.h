@@ -123,6 +123,16 @@ namespace jactorio::proto
             return prototypes_[upper_bound - 1];
         }
 
+        /// \return Inclusive start of each range, followed by the end of the last range
+        J_NODISCARD const std::vector<NoiseValT>& GetNoiseRanges() const noexcept {
+            return noiseRanges_;
+        }
+
+        /// \return Prototype of each range, size is 1 less than GetNoiseRanges
+        J_NODISCARD const std::vector<T*>& GetPrototypes() const noexcept {
+            return prototypes_;
+        }
+
         /// Gets start end range for a noise value
         /// \return inclusive start, exclusive end range unless it is last item, {0, 0} if invalid
         J_NODISCARD std::pair<NoiseValT, NoiseValT> GetValNoiseRange(NoiseValT val) const {
@@ -9,7 +9,8 @@
 
 namespace jactorio::proto
 {
-    // Unique per resource entity placed
+    /// Resource amount of a resource tile in older saves
+    /// \remark For loading saves prior to data::kSaveVersionResourceAmounts only, see game::Chunk::ResourceAmounts
     struct ResourceEntityData final : EntityData
     {
         using ResourceCount = ResourceEntityResourceCount;
@@ -37,7 +38,6 @@ namespace jactorio::proto
     {
     public:
         PROTOTYPE_CATEGORY(resource_entity);
-        PROTOTYPE_DATA_TRIVIAL_COPY(ResourceEntityData);
 
         /// Seconds to pickup entity
         PYTHON_PROP_REF_I(float, pickupTime, 1);
@@ -10,6 +10,8 @@ namespace jactorio::proto
 {
     struct SplitterData final : HealthEntityData
     {
+        UNIQUE_DATA_POOLED(SplitterData);
+
         explicit SplitterData(const Orientation orien) : orientation(orien) {}
 
 
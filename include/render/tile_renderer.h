@@ -146,7 +146,6 @@ namespace jactorio::render
         /// \param render_tile_offset Offset drawn tiles on screen by this tile amount
         void PrepareChunkRow(TRenderBuffer& r_layer,
                              const game::World& world,
-                             std::mutex& world_gen_mutex,
                              Position2<int> row_start,
                              int chunk_span,
                              Position2<int> render_tile_offset) const noexcept;
@@ -0,0 +1,135 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "core/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace jactorio;
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        const auto hardware_threads = std::thread::hardware_concurrency();
+        thread_count                = hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    threads_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard guard(queueMutex_);
+        stopping_ = true;
+    }
+    queueCv_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> func) {
+    std::packaged_task<void()> task(std::move(func));
+    auto future = task.get_future();
+
+    // No workers, run immediately
+    if (threads_.empty()) {
+        task();
+        return future;
+    }
+
+    {
+        std::lock_guard guard(queueMutex_);
+        queue_.push_back(std::move(task));
+    }
+    queueCv_.notify_one();
+
+    return future;
+}
+
+void ThreadPool::ParallelFor(const std::size_t count, const std::function<void(std::size_t)>& func) {
+    if (count == 0)
+        return;
+
+    // Helpers may start after ParallelFor returns if workers are busy with other tasks, they share ownership of the
+    // state and only call func for indices not yet claimed
+    struct State
+    {
+        std::atomic<std::size_t> nextIndex           = 0;
+        std::size_t count                            = 0;
+        const std::function<void(std::size_t)>* func = nullptr;
+
+        std::mutex mutex;
+        std::condition_variable doneCv;
+        std::size_t doneCount = 0;
+        std::exception_ptr exception;
+    };
+
+    auto state   = std::make_shared<State>();
+    state->count = count;
+    state->func  = &func;
+
+    auto run = [state]() {
+        for (auto i = state->nextIndex++; i < state->count; i = state->nextIndex++) {
+            std::exception_ptr exception;
+            try {
+                (*state->func)(i);
+            }
+            catch (...) {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard guard(state->mutex);
+            if (exception && !state->exception) {
+                state->exception = exception;
+            }
+            if (++state->doneCount == state->count) {
+                state->doneCv.notify_all();
+            }
+        }
+    };
+
+    const auto helper_count = std::min(threads_.size(), count - 1);
+    if (helper_count > 0) {
+        // Ahead of queued tasks, the calling thread is waiting
+        {
+            std::lock_guard guard(queueMutex_);
+            for (std::size_t i = 0; i < helper_count; ++i) {
+                queue_.emplace_front(run);
+            }
+        }
+        queueCv_.notify_all();
+    }
+
+    run();
+
+    std::unique_lock lock(state->mutex);
+    state->doneCv.wait(lock, [&state]() { return state->doneCount == state->count; });
+
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock lock(queueMutex_);
+            queueCv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+            // Remaining tasks are completed before stopping
+            if (queue_.empty())
+                return;
+
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
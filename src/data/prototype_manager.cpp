@@ -3,12 +3,14 @@
 #include "data/prototype_manager.h"
 
 #include <filesystem>
+#include <limits>
 #include <sstream>
 
 #include "core/filesystem.h"
 #include "core/resource_guard.h"
 #include "data/local_parser.h"
 #include "data/pybind_manager.h"
+#include "proto/framework/world_object.h"
 #include "proto/label.h"
 
 using namespace jactorio;
@@ -53,6 +55,8 @@ void data::PrototypeManager::Add(const std::string& iname, proto::FrameworkBase*
                           formatted_iname.c_str(),
                           static_cast<int>(data_category));
             // Free the previous prototype
+            if (const auto* overridden = dynamic_cast<proto::FWorldObject*>(it->second); overridden != nullptr)
+                tilePrototypeTable_[overridden->tilePrototypeId] = nullptr;
             delete it->second;
         }
     }
@@ -68,6 +72,15 @@ void data::PrototypeManager::Add(const std::string& iname, proto::FrameworkBase*
 
     prototype->internalId = internalIdNew_++;
 
+    if (auto* world_object = dynamic_cast<proto::FWorldObject*>(prototype); world_object != nullptr) {
+        // Id 0 is reserved for nullptr
+        if (tilePrototypeTable_.size() > std::numeric_limits<TilePrototypeIdT>::max())
+            throw std::runtime_error("Exceeded maximum number of world object prototypes");
+
+        world_object->tilePrototypeId = SafeCast<TilePrototypeIdT>(tilePrototypeTable_.size());
+        tilePrototypeTable_.push_back(world_object);
+    }
+
 
     dataRaw_[static_cast<uint16_t>(data_category)][formatted_iname] = prototype;
     LOG_MESSAGE_F(debug, "Added prototype %d %s", data_category, formatted_iname.c_str());
@@ -170,6 +183,7 @@ void data::PrototypeManager::Clear() {
     }
 
     internalIdNew_ = kInternalIdStart_;
+    tilePrototypeTable_.assign(1, nullptr);
 }
 
 
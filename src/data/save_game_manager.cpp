@@ -2,11 +2,21 @@
 
 #include "data/save_game_manager.h"
 
+#include <array>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#include "core/convert.h"
+
 using namespace jactorio;
 
 static constexpr auto kSaveGameFolder  = "saves";
 static constexpr auto kSaveGameFileExt = "dat";
 
+/// Identifies saves with a header, saves without it begin with the archive's endianness byte
+static constexpr std::array<char, 8> kSaveHeaderMagic{'J', 'A', 'C', 'T', 'S', 'A', 'V', 'E'};
+
 bool data::IsValidSaveName(const std::string& save_name) {
     const auto path = std::filesystem::path(save_name);
 
@@ -53,3 +63,125 @@ std::filesystem::directory_iterator data::GetSaveDirIt() {
     CheckExistsSaveDirectory();
     return std::filesystem::directory_iterator(kSaveGameFolder);
 }
+
+void data::WriteSaveHeader(std::ostream& os) {
+    os.write(kSaveHeaderMagic.data(), kSaveHeaderMagic.size());
+
+    // Little endian regardless of platform
+    std::array<char, sizeof(SaveVersionT)> version_bytes{};
+    for (std::size_t i = 0; i < version_bytes.size(); ++i) {
+        version_bytes[i] = static_cast<char>((kSaveVersion >> (i * 8)) & 0xFF);
+    }
+    os.write(version_bytes.data(), version_bytes.size());
+}
+
+data::SaveVersionT data::ReadSaveHeader(std::istream& is) {
+    const auto start_pos = is.tellg();
+
+    std::array<char, kSaveHeaderMagic.size()> magic{};
+    is.read(magic.data(), magic.size());
+
+    if (!is || magic != kSaveHeaderMagic) {
+        is.clear();
+        is.seekg(start_pos);
+        return kSaveVersionLegacy;
+    }
+
+    std::array<char, sizeof(SaveVersionT)> version_bytes{};
+    is.read(version_bytes.data(), version_bytes.size());
+    if (!is) {
+        throw std::runtime_error("Save header is incomplete");
+    }
+
+    SaveVersionT version = 0;
+    for (std::size_t i = 0; i < version_bytes.size(); ++i) {
+        version |= static_cast<SaveVersionT>(static_cast<unsigned char>(version_bytes[i])) << (i * 8);
+    }
+
+    if (version > kSaveVersion) {
+        throw std::runtime_error("Save was made by a newer version of the game");
+    }
+    return version;
+}
+
+/// FNV-1a, detects increments partially written
+static uint64_t IncrementChecksum(const std::string& increment) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto c : increment) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/// Little endian regardless of platform
+static void WriteUint64(std::ostream& os, const uint64_t val) {
+    std::array<char, sizeof(val)> bytes{};
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>((val >> (i * 8)) & 0xFF);
+    }
+    os.write(bytes.data(), bytes.size());
+}
+
+/// \return false if stream ended
+static bool ReadUint64(std::istream& is, uint64_t& val) {
+    std::array<char, sizeof(val)> bytes{};
+    is.read(bytes.data(), bytes.size());
+    if (!is)
+        return false;
+
+    val = 0;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        val |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (i * 8);
+    }
+    return true;
+}
+
+void data::WriteSaveIncrement(std::ostream& os, const std::string& increment) {
+    WriteUint64(os, increment.size());
+    os.write(increment.data(), SafeCast<std::streamsize>(increment.size()));
+    WriteUint64(os, IncrementChecksum(increment));
+}
+
+bool data::ReadSaveIncrement(std::istream& is, std::string& increment, const SaveVersionT version) {
+    uint64_t size = 0;
+    if (!ReadUint64(is, size))
+        return false;
+
+    // Size itself may be cut off or corrupt, do not trust it for allocating
+    const auto start = is.tellg();
+    is.seekg(0, std::ios_base::end);
+    const auto remaining = static_cast<uint64_t>(is.tellg() - start);
+    is.seekg(start);
+    if (size > remaining)
+        return false;
+
+    increment.resize(SafeCast<std::size_t>(size));
+    is.read(increment.data(), SafeCast<std::streamsize>(size));
+    if (!is)
+        return false;
+
+    if (version < kSaveVersionIncrementChecksums)
+        return true;
+
+    uint64_t checksum = 0;
+    return ReadUint64(is, checksum) && checksum == IncrementChecksum(increment);
+}
+
+void data::DeferredSave::Defer(std::function<std::string()> encode) {
+    deferred_.emplace_back(SafeCast<std::size_t>(static_cast<std::streamoff>(stream_.tellp())), std::move(encode));
+}
+
+std::string data::DeferredSave::Finish() {
+    const auto written = stream_.str();
+
+    std::string save;
+    std::size_t written_pos = 0;
+    for (auto& [pos, encode] : deferred_) {
+        save.append(written, written_pos, pos - written_pos);
+        save.append(encode());
+        written_pos = pos;
+    }
+    save.append(written, written_pos, std::string::npos);
+    return save;
+}
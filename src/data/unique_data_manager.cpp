@@ -5,8 +5,7 @@
 using namespace jactorio;
 
 void data::UniqueDataManager::AssignId(proto::UniqueDataBase& unique_data) noexcept {
-    unique_data.internalId = nextId_;
-    nextId_++;
+    unique_data.internalId = nextId_++;
 }
 
 // ======================================================================
@@ -14,6 +13,7 @@ void data::UniqueDataManager::AssignId(proto::UniqueDataBase& unique_data) noexc
 void data::UniqueDataManager::StoreRelocationEntry(proto::UniqueDataBase& unique_data) {
     assert(unique_data.internalId > 0);
 
+    std::lock_guard<std::mutex> guard(entriesMutex_);
     if (dataEntries_.size() < unique_data.internalId) {
         dataEntries_.resize(unique_data.internalId);
     }
@@ -32,7 +32,10 @@ proto::UniqueDataBase& data::UniqueDataManager::RelocationTableGet(const UniqueD
 
 void data::UniqueDataManager::Clear() noexcept {
     nextId_ = kDefaultId;
+
+    std::lock_guard<std::mutex> guard(entriesMutex_);
     dataEntries_.clear();
+    sharedEntries_.clear();
 }
 
 data::UniqueDataManager::DebugInfo data::UniqueDataManager::GetDebugInfo() {
@@ -8,8 +8,12 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <sstream>
 
+#include "core/convert.h"
 #include "core/execution_timer.h"
+#include "core/resource_guard.h"
 #include "data/cereal/register_type.h"
 #include "data/save_game_manager.h"
 #include "game/event/game_events.h"
@@ -19,6 +23,8 @@
 using namespace jactorio;
 
 void game::GameController::ResetGame() {
+    incrementalSave_.clear();
+
     worlds.~GameWorlds();
     logic.~Logic();
     player.~Player();
@@ -62,19 +68,36 @@ bool game::GameController::Init() {
 void game::GameController::LogicUpdate() {
     // World
 
-    for (auto& world : worlds) {
+    for (WorldId world_id = 0; world_id < worlds.size(); ++world_id) {
+        auto& world = worlds[world_id];
+
         logic.GameTickAdvance();
-        logic.DeferralUpdate(world, logic.GameTick());
+        {
+            EXECUTION_PROFILE_SCOPE(deferral_timer, "Deferral update");
 
+            logic.DeferralUpdate(world, logic.GameTick());
+        }
+        {
+            EXECUTION_PROFILE_SCOPE(chunk_gen_timer, "Chunk generation");
+
+            // Chunks around the player are generated first
+            std::vector<ChunkCoord> gen_focus;
+            if (player.world.GetId() == world_id) {
+                const auto position = player.world.GetPosition();
+                gen_focus.push_back(World::WorldCToChunkC(
+                    WorldCoord{LossyCast<WorldCoordAxis>(position.x), LossyCast<WorldCoordAxis>(position.y)}));
+            }
+            world.SetGenerationFocus(std::move(gen_focus));
 
-        world.GenChunk(proto, 30);
+            world.GenChunk(threadPool, proto, kChunkGenBudget);
+        }
 
 
         // Logistics logic
         {
             EXECUTION_PROFILE_SCOPE(belt_timer, "Belt update");
 
-            ConveyorLogicUpdate(world);
+            ConveyorLogicUpdate(world, threadPool);
         }
         {
             EXECUTION_PROFILE_SCOPE(inserter_timer, "Inserter update");
@@ -126,13 +149,97 @@ void game::GameController::SaveGame(const char* save_name) const {
     LOG_MESSAGE_F(info, "Saving game to '%s'", save_path.c_str());
 
     std::ofstream ofs(save_path.c_str(), std::ios_base::binary);
-    cereal::PortableBinaryOutputArchive archive(ofs);
+    WriteGame(ofs);
+}
 
-    // Output archive guaranteed to not modify
-    const_cast<GameController*>(this)->SerializeGame(archive);
+void game::GameController::SaveGameAsync(const char* save_name) {
+    WaitSaveGame();
+
+    const auto save_path = data::ResolveSavePath(save_name);
+
+    const bool append = incrementalSave_ == save_name && saveIncrements_ < kMaxSaveIncrements &&
+        std::filesystem::exists(save_path);
+
+    // Game state at this tick, later updates do not affect the save
+    auto save = std::make_shared<data::DeferredSave>();
+    {
+        data::active_deferred_save = save.get();
+        CapturingGuard<void()> save_guard([]() { data::active_deferred_save = nullptr; });
+
+        if (append) {
+            LOG_MESSAGE_F(
+                info, "Saving game increment to '%s', standalone chunks encoded in background", save_path.c_str());
+            WriteGameIncrement(save->Stream());
+        }
+        else {
+            LOG_MESSAGE_F(info, "Saving game to '%s', standalone chunks encoded in background", save_path.c_str());
+            WriteGame(save->Stream());
+        }
+    }
+
+    for (auto& world : worlds) {
+        world.MarkSaved();
+    }
+    incrementalSave_ = save_name;
+    saveIncrements_  = append ? saveIncrements_ + 1 : 0;
+
+    if (append) {
+        pendingSave_ = std::async(std::launch::async, [save_path, save]() {
+            const auto increment = save->Finish();
+
+            std::ofstream ofs(save_path.c_str(), std::ios_base::binary | std::ios_base::app);
+            data::WriteSaveIncrement(ofs, increment);
+
+            if (!ofs) {
+                LOG_MESSAGE_F(error, "Failed to append to save '%s'", save_path.c_str());
+                throw std::runtime_error("Failed to write save");
+            }
+            LOG_MESSAGE_F(info, "Saved game increment to '%s'", save_path.c_str());
+        });
+        return;
+    }
+
+    pendingSave_ = std::async(std::launch::async, [save_path, save]() {
+        const auto bytes = save->Finish();
+
+        // Written to a temporary file first so the existing save is intact if writing fails
+        const auto temp_path = save_path + ".tmp";
+        {
+            std::ofstream ofs(temp_path.c_str(), std::ios_base::binary);
+            ofs.write(bytes.data(), SafeCast<std::streamsize>(bytes.size()));
+
+            if (!ofs) {
+                LOG_MESSAGE_F(error, "Failed to write save '%s'", temp_path.c_str());
+                throw std::runtime_error("Failed to write save");
+            }
+        }
+        std::filesystem::rename(temp_path, save_path);
+
+        LOG_MESSAGE_F(info, "Saved game to '%s'", save_path.c_str());
+    });
+}
+
+bool game::GameController::IsSaving() const {
+    return pendingSave_.valid() && pendingSave_.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void game::GameController::WaitSaveGame() {
+    if (!pendingSave_.valid())
+        return;
+
+    try {
+        pendingSave_.get();
+    }
+    catch (std::exception&) {
+        // Save does not have what was marked saved
+        incrementalSave_.clear();
+        throw;
+    }
 }
 
 void game::GameController::LoadGame(const char* save_name) {
+    WaitSaveGame();
+
     const auto save_path = data::ResolveSavePath(save_name);
     LOG_MESSAGE_F(info, "Loading save from '%s'", save_path.c_str());
 
@@ -141,18 +248,36 @@ void game::GameController::LoadGame(const char* save_name) {
     }
 
     const std::vector<std::function<void()>> pre_load_hooks{
+        // Remove any dangling pointers (activatedTile)
+        // Waits for chunks decoding on worker threads, which read the relocation table
+        [&]() { ResetGame(); },
         [&]() {
             proto.GenerateRelocationTable();
             data::active_prototype_manager = &proto;
         },
-        [&]() { ResetGame(); }, // Remove any dangling pointers (activatedTile)
     };
     const std::vector<std::function<void()>> post_load_hooks{
+        // Chunks are decoded before entities deserialize, which may read them
+        [&]() {
+            if (player.world.GetId() >= worlds.size())
+                return;
+
+            const auto position = player.world.GetPosition();
+            worlds[player.world.GetId()].LoadEncodedChunks(
+                World::WorldCToChunkC(
+                    WorldCoord{LossyCast<WorldCoordAxis>(position.x), LossyCast<WorldCoordAxis>(position.y)}),
+                kLoadChunkRadius);
+        },
         [&]() {
             for (auto& world : worlds) {
                 world.DeserializePostProcess();
             }
         },
+        [&]() {
+            for (auto& world : worlds) {
+                world.MarkSaved();
+            }
+        },
         [&]() { unique.Clear(); },
     };
 
@@ -174,9 +299,47 @@ void game::GameController::LoadGame(const char* save_name) {
     run_hooks(pre_load_hooks, "Pre load hook");
 
     std::ifstream ifs(save_path.c_str(), std::ios_base::binary);
-    cereal::PortableBinaryInputArchive archive(ifs);
 
-    SerializeGame(archive);
+    data::active_save_version = data::ReadSaveHeader(ifs);
+    LOG_MESSAGE_F(debug, "Save version %d", data::active_save_version);
+    CapturingGuard<void()> version_guard([]() { data::active_save_version = data::kSaveVersion; });
+
+    data::active_thread_pool = &threadPool;
+    CapturingGuard<void()> pool_guard([]() { data::active_thread_pool = nullptr; });
+
+    {
+        cereal::PortableBinaryInputArchive archive(ifs);
+        SerializeGame(archive);
+    }
+
+    saveIncrements_ = 0;
+    if (data::active_save_version >= data::kSaveVersionIncremental) {
+        std::string increment;
+        auto increments_end = ifs.tellg();
+        while (data::ReadSaveIncrement(ifs, increment, data::active_save_version)) {
+            // Unique data ids restart in each increment
+            unique.Clear();
+
+            std::istringstream iss(increment, std::ios_base::binary);
+            ReadGameIncrement(iss);
+            ++saveIncrements_;
+
+            increments_end = ifs.tellg();
+        }
+        LOG_MESSAGE_F(debug, "Loaded %d save increments", saveIncrements_);
+
+        // Increment torn by a crash while appending it, later increments must be appended after the last one read
+        ifs.clear();
+        ifs.seekg(0, std::ios_base::end);
+        if (ifs.tellg() != increments_end) {
+            LOG_MESSAGE_F(warning, "Removing incomplete save increment from '%s'", save_path.c_str());
+            ifs.close();
+            std::filesystem::resize_file(save_path, SafeCast<std::uintmax_t>(std::streamoff(increments_end)));
+        }
+    }
+
+    // Increments are only appended to saves of the current version
+    incrementalSave_ = data::active_save_version == data::kSaveVersion ? save_name : "";
 
     run_hooks(post_load_hooks, "Post load hook");
 }
@@ -198,3 +361,54 @@ bool game::GameController::InitPrototypes() {
         return false;
     }
 }
+
+void game::GameController::WriteGame(std::ostream& os) const {
+    data::WriteSaveHeader(os);
+    cereal::PortableBinaryOutputArchive archive(os);
+
+    // Chunks are serialized on the logic workers, idle while saving
+    data::active_thread_pool = &const_cast<GameController*>(this)->threadPool;
+    CapturingGuard<void()> pool_guard([]() { data::active_thread_pool = nullptr; });
+
+    // Output archive guaranteed to not modify
+    const_cast<GameController*>(this)->SerializeGame(archive);
+}
+
+void game::GameController::WriteGameIncrement(std::ostream& os) const {
+    cereal::PortableBinaryOutputArchive archive(os);
+
+    data::active_thread_pool = &const_cast<GameController*>(this)->threadPool;
+    CapturingGuard<void()> pool_guard([]() { data::active_thread_pool = nullptr; });
+
+    archive(cereal::make_size_tag(static_cast<cereal::size_type>(worlds.size())));
+    for (const auto& world : worlds) {
+        world.SaveIncrement(archive);
+    }
+
+    // Output archive guaranteed to not modify
+    archive(const_cast<GameController*>(this)->logic);
+    archive(const_cast<GameController*>(this)->player);
+}
+
+void game::GameController::ReadGameIncrement(std::istream& is) {
+    cereal::PortableBinaryInputArchive archive(is);
+
+    cereal::size_type world_count;
+    archive(cereal::make_size_tag(world_count));
+    if (world_count != worlds.size()) {
+        throw std::runtime_error("Save increment has a different number of worlds");
+    }
+
+    for (auto& world : worlds) {
+        world.LoadIncrement(archive);
+    }
+
+    // Replaced entirely by increment
+    logic.~Logic();
+    player.~Player();
+    new (&logic) Logic();
+    new (&player) Player();
+
+    archive(logic);
+    archive(player);
+}
@@ -2,19 +2,25 @@
 
 #include "game/logic/conveyor_controller.h"
 
-#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
+#include "core/thread_pool.h"
+#include "game/logic/conveyor_active_set.h"
 #include "game/logic/conveyor_struct.h"
 #include "game/world/world.h"
 #include "proto/abstract/conveyor.h"
 
 using namespace jactorio;
 
+static constexpr auto kNoNode = static_cast<std::size_t>(-1);
+
 /// Sets index to the next item with a distance greater than item_width and decrement it
 /// If there is no item AND has_target_segment == false, index is set as size of conveyor
 /// \return true if an item was decremented
 J_NODISCARD bool MoveNextItem(const proto::LineDistT& tiles_moved,
-                              std::deque<game::ConveyorItem>& line_side,
+                              game::ConveyorItemBuffer& line_side,
                               uint16_t& index,
                               const bool has_target_segment) {
     for (size_t i = SafeCast<size_t>(index) + 1; i < line_side.size(); ++i) {
@@ -45,8 +51,9 @@ J_NODISCARD bool MoveNextItem(const proto::LineDistT& tiles_moved,
     return false;
 }
 
+/// \return true if no items in the lane can move until the lane or its target changes
 template <bool IsLeft>
-void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segment) {
+bool UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segment) {
     using namespace jactorio;
     auto& side      = segment.GetSide(IsLeft);
     uint16_t& index = side.index;
@@ -58,14 +65,14 @@ void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segme
     if (index == 0) {
         // Front item does not need to be moved
         if (offset >= proto::LineDistT(0))
-            return;
+            return false;
 
         if (segment.target) {
             game::ConveyorStruct& target_segment = *segment.target;
             // Offset to insert at target segment from head
             proto::LineDistT target_offset;
             {
-                double length;
+                proto::LineDistT length;
                 switch (segment.terminationType) {
                     // Since segments terminating with side only can target the middle of a grouped segment, it uses
                     // its own member for head offset
@@ -74,14 +81,14 @@ void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segme
                     // |   |   |   |
                     // 3   2   1   0
                     // targetOffset of 0: Length is 1
-                    length = SafeCast<double>(1) + segment.sideInsertIndex;
+                    length = proto::LineDistT(1 + segment.sideInsertIndex);
                     break;
 
                 default:
-                    length = target_segment.length;
+                    length = proto::LineDistT(target_segment.length);
                     break;
                 }
-                target_offset = proto::LineDistT(length - fabs(offset.getAsDouble()));
+                target_offset = length - offset.Abs();
             }
 
             game::ConveyorStruct::ApplyTerminationDeduction<IsLeft>(
@@ -91,35 +98,41 @@ void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segme
             // Decides how the items will be fed into the target segment (if at all)
             switch (segment.terminationType) {
             default:
-                moved_item = target_segment.TryInsertItem(IsLeft, target_offset.getAsDouble(), *side.lane[index].item);
+                moved_item = target_segment.TryInsertItem(IsLeft, target_offset, *side.lane[index].item);
                 break;
 
                 // Side insertion
             case game::ConveyorStruct::TerminationType::left_only:
                 moved_item = target_segment.left.TryInsertItem(
-                    target_offset.getAsDouble(), *side.lane[index].item, target_segment.headOffset);
+                    target_offset, *side.lane[index].item, target_segment.headOffset);
                 break;
             case game::ConveyorStruct::TerminationType::right_only:
                 moved_item = target_segment.right.TryInsertItem(
-                    target_offset.getAsDouble(), *side.lane[index].item, target_segment.headOffset);
+                    target_offset, *side.lane[index].item, target_segment.headOffset);
                 break;
             }
 
+            if (moved_item) {
+                // Lane insertion does not wake the target as struct insertion does
+                target_segment.Wake();
+            }
+
 
             // Handle transition if the item has been added to another conveyor
             if (moved_item) {
+                const auto front_offset = offset;
                 side.lane.pop_front(); // Remove item in current segment now moved away
 
                 // Move the next item forwards to preserve spacing & update back_item_distance
                 if (!side.lane.empty()) { // This will not work with speeds greater than item_spacing
                     // Offset is always negative
-                    side.lane.front().dist += offset;
+                    side.lane.front().dist += front_offset;
                 }
                 else {
                     // No items left in segment
                     back_item_distance = 0;
                 }
-                return;
+                return false;
             }
         }
         // No target segment or cannot move to the target segment
@@ -131,7 +144,10 @@ void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segme
 
         if (MoveNextItem(tiles_moved, side.lane, index, segment.target != nullptr)) {
             back_item_distance -= tiles_moved;
+            return false;
         }
+        // Front item blocked, all following items are compressed behind it
+        return true;
         /*
             // Disable conveyor since it does not feed anywhere
         else {
@@ -153,13 +169,15 @@ void UpdateSide(const proto::LineDistT& tiles_moved, game::ConveyorStruct& segme
 
         // Items following the first item will leave a gap of item_width
         if (offset > proto::LineDistT(game::ConveyorProp::kItemSpacing))
-            return;
+            return false;
 
         // Item has reached its end, set the offset to item_spacing since it was decremented 1 too many times
         offset = game::ConveyorProp::kItemSpacing;
         if (MoveNextItem(tiles_moved, side.lane, index, segment.target != nullptr)) {
             back_item_distance -= tiles_moved;
         }
+        // Front item is checked again on the next update
+        return false;
     }
 }
 
@@ -191,40 +209,362 @@ static void LogicUpdateMoveItems(const proto::Conveyor& line_proto, proto::Conve
 }
 
 /// Transitions items on conveyors to other lines and modifies whether of not the line is active
-static void LogicUpdateTransitionItems(const proto::Conveyor& line_proto, proto::ConveyorData& conveyor_data) {
+/// \return true if no items on the conveyor can move until woken
+static bool LogicUpdateTransitionItems(const proto::Conveyor& line_proto, proto::ConveyorData& conveyor_data) {
     auto& line_segment = *conveyor_data.structure;
 
     const auto tiles_moved = line_proto.speed;
 
+    bool left_blocked = true;
     if (line_segment.left.IsActive())
-        UpdateSide<true>(tiles_moved, line_segment);
+        left_blocked = UpdateSide<true>(tiles_moved, line_segment);
 
+    bool right_blocked = true;
     if (line_segment.right.IsActive())
-        UpdateSide<false>(tiles_moved, line_segment);
+        right_blocked = UpdateSide<false>(tiles_moved, line_segment);
+
+    return left_blocked && right_blocked;
+}
+
+/// \param blocked No items on the conveyor can move
+/// \return true if conveyor can sleep, waking when items are added or removed from itself or its target
+static bool CanSleep(game::ConveyorStruct& con_struct, const bool blocked) {
+    if (!blocked)
+        return false;
+
+    if (con_struct.target == nullptr)
+        return true;
+
+    // Empty conveyors do not depend on the target
+    if (con_struct.left.lane.empty() && con_struct.right.lane.empty())
+        return true;
+
+    // Items waiting to enter the target can move only after the target changes, which wakes the target
+    if (con_struct.target->IsSleeping()) {
+        con_struct.target->AddSleepingFeeder(con_struct);
+        return true;
+    }
+    return false;
+}
+
+static proto::ConveyorData& GetConveyorData(const game::LogicObject& logic_object) {
+    auto* con_data = SafeCast<proto::ConveyorData*>(logic_object.uniqueData.Get());
+    assert(con_data != nullptr);
+    assert(con_data->structure != nullptr);
+    return *con_data;
+}
+
+/// \return true if conveyor at logic_index of logic group is con_struct, con_struct is not dereferenced
+static bool IsLogicConveyor(const std::vector<game::LogicObject>& logic_list,
+                            const std::size_t logic_index,
+                            const game::ConveyorStruct* con_struct) {
+    return logic_index < logic_list.size() && GetConveyorData(logic_list[logic_index]).structure.get() == con_struct;
+}
+
+/// Drops conveyors removed or moved from active, schedules conveyors registered or moved
+static void UpdateChangedConveyors(std::vector<game::LogicObject>& logic_list, game::ConveyorActiveSet& active_set) {
+    auto& active = active_set.active;
+    auto& marked = active_set.componentNode; // Conveyors in active, unused entries are kNoNode
+    marked.resize(logic_list.size(), kNoNode);
+
+    std::size_t kept = 0;
+    for (const auto logic_index : active) {
+        if (logic_index >= logic_list.size())
+            continue;
+
+        // Conveyor at logic index was moved there, it is added again below
+        auto& con_struct = *GetConveyorData(logic_list[logic_index]).structure;
+        if (con_struct.GetLogicIndex() != logic_index || marked[logic_index] != kNoNode)
+            continue;
+
+        marked[logic_index] = logic_index;
+        active[kept++]      = logic_index;
+    }
+    active.resize(kept);
+
+    for (const auto logic_index : active_set.changed) {
+        if (logic_index >= logic_list.size())
+            continue;
+
+        auto& con_struct = *GetConveyorData(logic_list[logic_index]).structure;
+        con_struct.SetLogicIndex(logic_index);
+
+        // Registered conveyors may have been lengthened, wake them
+        // Sleeping conveyors are appended to active once taken from the wake list
+        if (con_struct.IsSleeping()) {
+            con_struct.Wake();
+        }
+        else if (marked[logic_index] == kNoNode) {
+            con_struct.LeaveSleepingFeeders();
+
+            marked[logic_index] = logic_index;
+            active.push_back(logic_index);
+        }
+    }
+    active_set.changed.clear();
+}
+
+/// Reschedules all conveyors if the logic group was replaced, otherwise adds changed and woken conveyors to active
+static void UpdateActiveSet(game::World& world, game::ConveyorActiveSet& active_set) {
+    auto& logic_list = world.LogicGet(game::LogicGroup::conveyor);
+
+    if (active_set.stale) {
+        active_set.stale = false;
+
+        // Woken conveyors may no longer exist
+        active_set.woken.Clear();
+        active_set.changed.clear();
+        active_set.active.clear();
+        for (std::size_t i = 0; i < logic_list.size(); ++i) {
+            GetConveyorData(logic_list[i]).structure->ResetSleep(i);
+            active_set.active.push_back(i);
+        }
+        active_set.componentNode.assign(logic_list.size(), kNoNode);
+        return;
+    }
+
+    // Only conveyors changed since the last update are visited, building does not wake every conveyor
+    const bool changed = !active_set.changed.empty();
+    if (changed) {
+        UpdateChangedConveyors(logic_list, active_set);
+    }
+
+    // Woken feeders are appended to woken, visited in the next iteration
+    for (auto woken = active_set.woken.Take(); !woken.empty(); woken = active_set.woken.Take()) {
+        for (const auto& entry : woken) {
+            // Conveyor removed or moved within logic group while sleeping, moved conveyors were scheduled above
+            if (!IsLogicConveyor(logic_list, entry.logicIndex, entry.conveyor))
+                continue;
+            if (changed) {
+                auto& marked = active_set.componentNode[entry.logicIndex];
+                if (marked != kNoNode)
+                    continue;
+                marked = entry.logicIndex;
+            }
+
+            entry.conveyor->LeaveSleepingFeeders();
+            active_set.active.push_back(entry.logicIndex);
+            entry.conveyor->WakeFeeders();
+        }
+    }
+
+    if (changed) {
+        for (const auto logic_index : active_set.active) {
+            active_set.componentNode[logic_index] = kNoNode;
+        }
+    }
+}
+
+static void LogicUpdateMoveItems(const game::LogicObject& logic_object) {
+    const auto* line_proto = SafeCast<const proto::Conveyor*>(logic_object.prototype.Get());
+    assert(line_proto != nullptr);
+
+    LogicUpdateMoveItems(*line_proto, GetConveyorData(logic_object));
+}
+
+/// Transitions items, putting the conveyor to sleep if it cannot move any items
+/// \return true if conveyor went to sleep
+static bool LogicUpdateTransitionItems(const game::LogicObject& logic_object, game::ConveyorWakeList& wake_list) {
+    const auto* line_proto = SafeCast<const proto::Conveyor*>(logic_object.prototype.Get());
+    assert(line_proto != nullptr);
+
+    auto& con_data     = GetConveyorData(logic_object);
+    const bool blocked = LogicUpdateTransitionItems(*line_proto, con_data);
+
+    if (CanSleep(*con_data.structure, blocked)) {
+        con_data.structure->Sleep(wake_list);
+        return true;
+    }
+    return false;
 }
 
 void game::ConveyorLogicUpdate(World& world) {
     // The logic update of conveyor items occur in 2 stages:
     // 		1. Move items on their conveyors
     //		2. Check if any items have reached the end of their lines, and need to be moved to another one
+    //
+    // Conveyors which are empty or blocked are put to sleep in stage 2 and skipped until woken
+
+    auto& logic_list = world.LogicGet(LogicGroup::conveyor);
+    auto& active_set = world.GetConveyorActiveSet();
+
+    UpdateActiveSet(world, active_set);
+
+    for (const auto logic_index : active_set.active) {
+        LogicUpdateMoveItems(logic_list[logic_index]);
+    }
+
+    // Conveyors which sleep are removed from active, preserving update order of the remaining
+    std::size_t awake_count = 0;
+    for (const auto logic_index : active_set.active) {
+        if (!LogicUpdateTransitionItems(logic_list[logic_index], active_set.woken)) {
+            active_set.active[awake_count++] = logic_index;
+        }
+    }
+    active_set.active.resize(awake_count);
+}
+
+// ======================================================================
+// Parallel update
+
+/// Conveyors of active grouped by the conveyors they feed into
+struct ConveyorComponents
+{
+    /// Positions in active of each component, components stored one after another
+    std::vector<std::size_t> positions;
+    /// Component i occupies [start[i], start[i + 1]) of positions
+    std::vector<std::size_t> start;
+
+    J_NODISCARD std::size_t Count() const noexcept {
+        return start.size() - 1;
+    }
+};
+
+static std::size_t FindRoot(std::vector<std::size_t>& parent, std::size_t node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node         = parent[node];
+    }
+    return node;
+}
+
+/// Active conveyors and the conveyors they feed into are in the same component
+/// Components are ordered by their first conveyor in active, conveyors within a component keep their order in active
+static ConveyorComponents FindComponents(game::World& world, game::ConveyorActiveSet& active_set) {
+    auto& logic_list   = world.LogicGet(game::LogicGroup::conveyor);
+    const auto& active = active_set.active;
+    auto& logic_node   = active_set.componentNode;
+    assert(logic_node.size() == logic_list.size());
+
+    // Nodes [0, active.size()) are active conveyors, followed by sleeping targets and targets outside the logic group
+    std::vector<std::size_t> parent(active.size());
+    for (std::size_t i = 0; i < active.size(); ++i) {
+        parent[i]             = i;
+        logic_node[active[i]] = i;
+    }
+
+    std::vector<std::size_t> touched_logic; // Sleeping targets, logic_node reset afterwards
+    std::unordered_map<const game::ConveyorStruct*, std::size_t> external_node;
+
+    auto get_target_node = [&](const game::ConveyorStruct& target) {
+        const auto logic_index = target.GetLogicIndex();
+        if (logic_index < logic_list.size() && GetConveyorData(logic_list[logic_index]).structure.get() == &target) {
+            auto& node = logic_node[logic_index];
+            if (node == kNoNode) {
+                node = parent.size();
+                parent.push_back(node);
+                touched_logic.push_back(logic_index);
+            }
+            return node;
+        }
+
+        // Conveyors such as splitters are not in the conveyor logic group
+        const auto [it, inserted] = external_node.try_emplace(&target, parent.size());
+        if (inserted) {
+            parent.push_back(it->second);
+        }
+        return it->second;
+    };
+
+    for (std::size_t i = 0; i < active.size(); ++i) {
+        const auto* target = GetConveyorData(logic_list[active[i]]).structure->target;
+        if (target == nullptr)
+            continue;
+
+        const auto root_a = FindRoot(parent, i);
+        const auto root_b = FindRoot(parent, get_target_node(*target));
+        if (root_a != root_b) {
+            parent[std::max(root_a, root_b)] = std::min(root_a, root_b);
+        }
+    }
 
-    for (auto [prototype, unique_data, coord] : world.LogicGet(LogicGroup::conveyor)) {
-        const auto* line_proto = SafeCast<const proto::Conveyor*>(prototype.Get());
-        auto* con_data         = SafeCast<proto::ConveyorData*>(unique_data.Get());
+    for (const auto logic_index : active) {
+        logic_node[logic_index] = kNoNode;
+    }
+    for (const auto logic_index : touched_logic) {
+        logic_node[logic_index] = kNoNode;
+    }
 
-        assert(line_proto != nullptr);
-        assert(con_data != nullptr);
+    // Number components by first appearance in active, then count sort positions into components
+    std::vector<std::size_t> root_component(parent.size(), kNoNode);
+    std::vector<std::size_t> position_component(active.size());
+
+    ConveyorComponents components;
+    components.start.push_back(0);
+    for (std::size_t i = 0; i < active.size(); ++i) {
+        auto& component = root_component[FindRoot(parent, i)];
+        if (component == kNoNode) {
+            component = components.start.size() - 1;
+            components.start.push_back(0);
+        }
+        position_component[i] = component;
+        ++components.start[component + 1];
+    }
 
-        LogicUpdateMoveItems(*line_proto, *con_data);
+    for (std::size_t i = 1; i < components.start.size(); ++i) {
+        components.start[i] += components.start[i - 1];
     }
 
-    for (auto [prototype, unique_data, coord] : world.LogicGet(LogicGroup::conveyor)) {
-        const auto* line_proto = SafeCast<const proto::Conveyor*>(prototype.Get());
-        auto* con_data         = SafeCast<proto::ConveyorData*>(unique_data.Get());
+    components.positions.resize(active.size());
+    std::vector<std::size_t> next(components.start.begin(), components.start.end() - 1);
+    for (std::size_t i = 0; i < active.size(); ++i) {
+        components.positions[next[position_component[i]]++] = i;
+    }
+
+    return components;
+}
+
+void game::ConveyorLogicUpdate(World& world, ThreadPool& pool, const std::size_t min_parallel) {
+    auto& active_set = world.GetConveyorActiveSet();
+
+    // Woken conveyors must be added to active before finding components
+    UpdateActiveSet(world, active_set);
+
+    if (pool.GetThreadCount() == 0 || active_set.active.size() < min_parallel) {
+        ConveyorLogicUpdate(world);
+        return;
+    }
 
-        assert(line_proto != nullptr);
-        assert(con_data != nullptr);
+    // Conveyors only modify themselves and the conveyor they feed into, components share no conveyors
+    // Each component is updated on one thread in the same order as ConveyorLogicUpdate(World&), thus results are
+    // identical regardless of thread count
+    auto& logic_list      = world.LogicGet(LogicGroup::conveyor);
+    const auto components = FindComponents(world, active_set);
 
-        LogicUpdateTransitionItems(*line_proto, *con_data);
+    // Few large batches of components to limit scheduling overhead, enough batches to balance uneven components
+    const auto batch_target = std::max<std::size_t>(1, active_set.active.size() / ((pool.GetThreadCount() + 1) * 4));
+
+    std::vector<std::size_t> batch_start{0};
+    for (std::size_t i = 0; i < components.Count(); ++i) {
+        if (components.start[i + 1] - components.start[batch_start.back()] >= batch_target) {
+            batch_start.push_back(i + 1);
+        }
+    }
+    if (batch_start.back() != components.Count()) {
+        batch_start.push_back(components.Count());
+    }
+
+    std::vector<uint8_t> slept(active_set.active.size(), 0);
+
+    pool.ParallelFor(batch_start.size() - 1, [&](const std::size_t batch) {
+        for (auto component = batch_start[batch]; component < batch_start[batch + 1]; ++component) {
+            const auto first = components.positions.begin() + components.start[component];
+            const auto last  = components.positions.begin() + components.start[component + 1];
+
+            for (auto it = first; it != last; ++it) {
+                LogicUpdateMoveItems(logic_list[active_set.active[*it]]);
+            }
+            for (auto it = first; it != last; ++it) {
+                slept[*it] = LogicUpdateTransitionItems(logic_list[active_set.active[*it]], active_set.woken);
+            }
+        }
+    });
+
+    std::size_t awake_count = 0;
+    for (std::size_t i = 0; i < active_set.active.size(); ++i) {
+        if (slept[i] == 0) {
+            active_set.active[awake_count++] = active_set.active[i];
+        }
     }
+    active_set.active.resize(awake_count);
 }
@@ -0,0 +1,100 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "game/logic/conveyor_item_buffer.h"
+
+#include <algorithm>
+
+using namespace jactorio;
+
+void game::ConveyorItemBuffer::reserve(const size_type new_cap) {
+    if (new_cap <= capacity())
+        return;
+
+    size_type rounded_cap = kMinCapacity;
+    while (rounded_cap < new_cap) {
+        rounded_cap *= 2;
+    }
+
+    // Unwrap into new arrays, front item at index 0
+    std::vector<proto::LineDistT> new_dist(rounded_cap);
+    std::vector<ItemPtrT> new_item(rounded_cap);
+    for (size_type i = 0; i < size_; ++i) {
+        const auto from = PhysicalIndex(i);
+        new_dist[i]     = dist_[from];
+        new_item[i]     = item_[from];
+    }
+
+    dist_ = std::move(new_dist);
+    item_ = std::move(new_item);
+    head_ = 0;
+}
+
+void game::ConveyorItemBuffer::emplace_back(const proto::LineDistT& dist, const proto::Item* item) {
+    GrowIfFull();
+
+    const auto i = PhysicalIndex(size_);
+    dist_[i]     = dist;
+    item_[i]     = ItemPtrT(item);
+    ++size_;
+}
+
+void game::ConveyorItemBuffer::emplace_front(const proto::LineDistT& dist, const proto::Item* item) {
+    GrowIfFull();
+
+    head_ = PhysicalIndex(capacity() - 1);
+    ++size_;
+
+    dist_[head_] = dist;
+    item_[head_] = ItemPtrT(item);
+}
+
+void game::ConveyorItemBuffer::insert(const size_type index, const proto::LineDistT& dist, const proto::Item* item) {
+    assert(index <= size_);
+    GrowIfFull();
+
+    // Shift whichever side has fewer items
+    if (index < size_ / 2) {
+        head_ = PhysicalIndex(capacity() - 1);
+        for (size_type i = 0; i < index; ++i) {
+            MoveItem(PhysicalIndex(i + 1), PhysicalIndex(i));
+        }
+    }
+    else {
+        for (size_type i = size_; i > index; --i) {
+            MoveItem(PhysicalIndex(i - 1), PhysicalIndex(i));
+        }
+    }
+    ++size_;
+
+    const auto i = PhysicalIndex(index);
+    dist_[i]     = dist;
+    item_[i]     = ItemPtrT(item);
+}
+
+void game::ConveyorItemBuffer::erase(const size_type index) noexcept {
+    assert(index < size_);
+
+    if (index < size_ / 2) {
+        for (size_type i = index; i > 0; --i) {
+            MoveItem(PhysicalIndex(i - 1), PhysicalIndex(i));
+        }
+        head_ = PhysicalIndex(1);
+    }
+    else {
+        for (size_type i = index; i + 1 < size_; ++i) {
+            MoveItem(PhysicalIndex(i + 1), PhysicalIndex(i));
+        }
+    }
+    --size_;
+}
+
+void game::ConveyorItemBuffer::GrowIfFull() {
+    if (size_ == capacity()) {
+        reserve(std::max(kMinCapacity, capacity() * 2));
+    }
+}
+
+void game::ConveyorItemBuffer::MoveItem(const size_type from, const size_type to) noexcept {
+    dist_[to] = dist_[from];
+    item_[to] = item_[from];
+}
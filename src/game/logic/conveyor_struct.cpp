@@ -2,7 +2,10 @@
 
 #include "game/logic/conveyor_struct.h"
 
-#include <decimal.h>
+#include <algorithm>
+#include <cassert>
+
+#include "game/logic/conveyor_active_set.h"
 
 using namespace jactorio;
 
@@ -12,7 +15,7 @@ bool game::ConveyorLane::IsActive() const {
 
 bool game::ConveyorLane::CanInsert(proto::LineDistT start_offset, const IntOffsetT item_offset) {
     start_offset += proto::LineDistT(item_offset);
-    assert(start_offset.getAsDouble() >= 0);
+    assert(start_offset.AsDouble() >= 0);
 
     proto::LineDistT offset(0);
 
@@ -43,23 +46,24 @@ bool game::ConveyorLane::CanInsert(proto::LineDistT start_offset, const IntOffse
     return offset <= start_offset;
 }
 
-void game::ConveyorLane::AppendItem(FloatOffsetT offset, const proto::Item& item) {
+void game::ConveyorLane::AppendItem(proto::LineDistT offset, const proto::Item& item) {
+    constexpr proto::LineDistT item_spacing(ConveyorProp::kItemSpacing);
+
     // A minimum distance of item_spacing is maintained between items (AFTER the initial item)
-    if (offset < ConveyorProp::kItemSpacing && !lane.empty())
-        offset = ConveyorProp::kItemSpacing;
+    if (offset < item_spacing && !lane.empty())
+        offset = item_spacing;
 
-    lane.emplace_back(proto::LineDistT(offset), &item);
-    backItemDistance += proto::LineDistT{offset};
+    lane.emplace_back(offset, &item);
+    backItemDistance += offset;
 }
 
-void game::ConveyorLane::InsertItem(FloatOffsetT offset, const proto::Item& item, const IntOffsetT item_offset) {
-    offset += item_offset;
-    assert(offset >= 0);
+void game::ConveyorLane::InsertItem(proto::LineDistT offset, const proto::Item& item, const IntOffsetT item_offset) {
+    offset += proto::LineDistT(item_offset);
+    assert(offset >= proto::LineDistT(0));
 
-    proto::LineDistT target_offset{offset}; // Location where item will be inserted
-    proto::LineDistT counter_offset;        // Running tally of offset from beginning
+    proto::LineDistT target_offset = offset; // Location where item will be inserted
+    proto::LineDistT counter_offset;         // Running tally of offset from beginning
 
-    std::deque<ConveyorItem>::iterator it;
     for (auto i = 0u; i < lane.size(); ++i) {
         counter_offset += lane[i].dist;
 
@@ -68,8 +72,6 @@ void game::ConveyorLane::InsertItem(FloatOffsetT offset, const proto::Item& item
         // 0.3   0.2(0.5)
         //     ^ Ends here
         if (counter_offset > target_offset) {
-            it = lane.begin() + i;
-
             // Modify offset of next item to be relative to what will be the newly inserted item
             counter_offset -= lane[i].dist; // Back to distance to previous item
 
@@ -77,24 +79,25 @@ void game::ConveyorLane::InsertItem(FloatOffsetT offset, const proto::Item& item
             // item
             target_offset -= counter_offset;
             lane[i].dist -= target_offset;
-            goto loop_exit;
+
+            assert(target_offset.AsDouble() >= 0);
+            lane.insert(i, target_offset, &item);
+            return;
         }
     }
     // Failed to find a greater item, insert at back
     backItemDistance = target_offset;
 
-    it = lane.end();
     target_offset -= counter_offset;
 
-loop_exit:
-    assert(target_offset.getAsDouble() >= 0);
-    lane.emplace(it, target_offset, &item);
+    assert(target_offset.AsDouble() >= 0);
+    lane.emplace_back(target_offset, &item);
 }
 
-bool game::ConveyorLane::TryInsertItem(const FloatOffsetT offset,
+bool game::ConveyorLane::TryInsertItem(const proto::LineDistT& offset,
                                        const proto::Item& item,
                                        const IntOffsetT item_offset) {
-    if (!CanInsert(proto::LineDistT(offset), item_offset))
+    if (!CanInsert(offset, item_offset))
         return false;
 
     // Reenable conveyor segment if disabled
@@ -105,10 +108,10 @@ bool game::ConveyorLane::TryInsertItem(const FloatOffsetT offset,
     return true;
 }
 
-std::pair<size_t, game::ConveyorItem> game::ConveyorLane::GetItem(const FloatOffsetT offset,
-                                                                  const FloatOffsetT epsilon) const {
-    const proto::LineDistT lower_bound{offset - epsilon};
-    const proto::LineDistT upper_bound{offset + epsilon};
+std::pair<size_t, game::ConveyorItem> game::ConveyorLane::GetItem(const proto::LineDistT& offset,
+                                                                  const proto::LineDistT& epsilon) const {
+    const proto::LineDistT lower_bound = offset - epsilon;
+    const proto::LineDistT upper_bound = offset + epsilon;
 
     proto::LineDistT offset_counter{0};
 
@@ -131,7 +134,7 @@ std::pair<size_t, game::ConveyorItem> game::ConveyorLane::GetItem(const FloatOff
     return {0, {}};
 }
 
-const proto::Item* game::ConveyorLane::TryPopItem(const FloatOffsetT offset, const FloatOffsetT epsilon) {
+const proto::Item* game::ConveyorLane::TryPopItem(const proto::LineDistT& offset, const proto::LineDistT& epsilon) {
     const auto result = GetItem(offset, epsilon);
 
     if (result.second.item == nullptr)
@@ -145,7 +148,7 @@ const proto::Item* game::ConveyorLane::TryPopItem(const FloatOffsetT offset, con
         lane[iteration + 1].dist += item_pair.dist;
     }
 
-    lane.erase(lane.begin() + iteration);
+    lane.erase(iteration);
     return item_pair.item.Get();
 }
 
@@ -284,28 +287,44 @@ void game::ConveyorStruct::ApplyRightTerminationDeduction(const TerminationType
         ApplyTargetTerminationDeductionR(target_segment_ttype, offset);
 }
 
-void game::ConveyorStruct::AppendItem(const bool left_side, const FloatOffsetT offset, const proto::Item& item) {
+void game::ConveyorStruct::AppendItem(const bool left_side,
+                                      const proto::LineDistT& offset,
+                                      const proto::Item& item) {
     left_side ? left.AppendItem(offset, item) : right.AppendItem(offset, item);
+    Wake();
 }
 
-void game::ConveyorStruct::InsertItem(const bool left_side, const FloatOffsetT offset, const proto::Item& item) {
+void game::ConveyorStruct::InsertItem(const bool left_side,
+                                      const proto::LineDistT& offset,
+                                      const proto::Item& item) {
     left_side ? left.InsertItem(offset, item, 0) : right.InsertItem(offset, item, 0);
+    Wake();
 }
 
-bool game::ConveyorStruct::TryInsertItem(const bool left_side, const FloatOffsetT offset, const proto::Item& item) {
-    return left_side ? left.TryInsertItem(offset, item, 0) : right.TryInsertItem(offset, item, 0);
+bool game::ConveyorStruct::TryInsertItem(const bool left_side,
+                                         const proto::LineDistT& offset,
+                                         const proto::Item& item) {
+    const bool inserted = left_side ? left.TryInsertItem(offset, item, 0) : right.TryInsertItem(offset, item, 0);
+    if (inserted) {
+        Wake();
+    }
+    return inserted;
 }
 
 std::pair<size_t, game::ConveyorItem> game::ConveyorStruct::GetItem(const bool left_side,
-                                                                    const FloatOffsetT offset,
-                                                                    const FloatOffsetT epsilon) const {
+                                                                    const proto::LineDistT& offset,
+                                                                    const proto::LineDistT& epsilon) const {
     return left_side ? left.GetItem(offset, epsilon) : right.GetItem(offset, epsilon);
 }
 
 const proto::Item* game::ConveyorStruct::TryPopItem(const bool left_side,
-                                                    const FloatOffsetT offset,
-                                                    const FloatOffsetT epsilon) {
-    return left_side ? left.TryPopItem(offset, epsilon) : right.TryPopItem(offset, epsilon);
+                                                    const proto::LineDistT& offset,
+                                                    const proto::LineDistT& epsilon) {
+    const auto* item = left_side ? left.TryPopItem(offset, epsilon) : right.TryPopItem(offset, epsilon);
+    if (item != nullptr) {
+        Wake();
+    }
+    return item;
 }
 
 // With itemOffset applied
@@ -314,18 +333,90 @@ bool game::ConveyorStruct::CanInsertAbs(const bool left_side, const proto::LineD
     return left_side ? left.CanInsert(start_offset, headOffset) : right.CanInsert(start_offset, headOffset);
 }
 
-void game::ConveyorStruct::InsertItemAbs(const bool left_side, const FloatOffsetT offset, const proto::Item& item) {
+void game::ConveyorStruct::InsertItemAbs(const bool left_side,
+                                         const proto::LineDistT& offset,
+                                         const proto::Item& item) {
     left_side ? left.InsertItem(offset, item, headOffset) : right.InsertItem(offset, item, headOffset);
+    Wake();
 }
 
-bool game::ConveyorStruct::TryInsertItemAbs(const bool left_side, const FloatOffsetT offset, const proto::Item& item) {
-    return left_side ? left.TryInsertItem(offset, item, headOffset) : right.TryInsertItem(offset, item, headOffset);
+bool game::ConveyorStruct::TryInsertItemAbs(const bool left_side,
+                                            const proto::LineDistT& offset,
+                                            const proto::Item& item) {
+    const bool inserted =
+        left_side ? left.TryInsertItem(offset, item, headOffset) : right.TryInsertItem(offset, item, headOffset);
+    if (inserted) {
+        Wake();
+    }
+    return inserted;
 }
 
 void game::ConveyorStruct::GetOffsetAbs(IntOffsetT& val) const {
     val -= headOffset;
 }
 
-void game::ConveyorStruct::GetOffsetAbs(FloatOffsetT& val) const {
-    val -= headOffset;
+void game::ConveyorStruct::GetOffsetAbs(proto::LineDistT& val) const {
+    val -= proto::LineDistT(headOffset);
+}
+
+// ======================================================================
+
+game::ConveyorStruct::~ConveyorStruct() {
+    LeaveSleepingFeeders();
+    for (auto* feeder : sleepingFeeders_) {
+        feeder->sleptOn_ = nullptr;
+    }
+}
+
+void game::ConveyorStruct::Sleep(ConveyorWakeList& wake_list) noexcept {
+    sleeping_ = true;
+    wakeList_ = &wake_list;
+}
+
+void game::ConveyorStruct::Wake() {
+    if (!sleeping_)
+        return;
+
+    assert(wakeList_ != nullptr);
+    sleeping_ = false;
+    wakeList_->Push(*this);
+}
+
+void game::ConveyorStruct::WakeFeeders() {
+    // Feeders are not woken recursively, they append themselves to the wake list which is processed in order
+    for (auto* feeder : sleepingFeeders_) {
+        feeder->sleptOn_ = nullptr;
+        feeder->Wake();
+    }
+    sleepingFeeders_.clear();
+}
+
+void game::ConveyorStruct::AddSleepingFeeder(ConveyorStruct& feeder) {
+    if (feeder.sleptOn_ == this)
+        return;
+
+    assert(feeder.sleptOn_ == nullptr);
+    sleepingFeeders_.push_back(&feeder);
+    feeder.sleptOn_ = this;
+}
+
+void game::ConveyorStruct::LeaveSleepingFeeders() noexcept {
+    if (sleptOn_ == nullptr)
+        return;
+
+    auto& feeders = sleptOn_->sleepingFeeders_;
+    feeders.erase(std::find(feeders.begin(), feeders.end(), this));
+    sleptOn_ = nullptr;
+}
+
+void game::ConveyorStruct::ResetSleep(const std::size_t logic_index) noexcept {
+    sleeping_   = false;
+    logicIndex_ = logic_index;
+    wakeList_   = nullptr;
+
+    LeaveSleepingFeeders();
+    for (auto* feeder : sleepingFeeders_) {
+        feeder->sleptOn_ = nullptr;
+    }
+    sleepingFeeders_.clear();
 }
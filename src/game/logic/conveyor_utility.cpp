@@ -109,6 +109,9 @@ static void CalculateTargets(proto::ConveyorData& origin, proto::ConveyorData& n
         // Insert at the correct offset for targets spanning > 1 tiles
         from.sideInsertIndex = to.structIndex;
         to.structure->GetOffsetAbs(from.sideInsertIndex);
+
+        // Items blocked at the end of from may now move into the new target
+        from.Wake();
     };
 
 
@@ -178,6 +181,7 @@ void DisconnectSegment(game::World& world, const WorldCoord& coord) {
         auto& neighbor_struct = *neighbor_data->structure;
 
         neighbor_struct.target = nullptr;
+        neighbor_struct.Wake();
 
 
         switch (neighbor_struct.terminationType) {
@@ -283,6 +287,7 @@ void game::ConveyorCreate(World& world,
             conveyor.structure = con_ahead->structure;
 
             con_ahead_struct.length++;
+            con_ahead_struct.Wake();
             conveyor.structIndex = con_ahead->structIndex + 1;
             return;
         }
@@ -402,6 +407,7 @@ void ChangeTargetSingle(game::World& world,
 
     if (con_data != nullptr && con_data->structure->target == &old_con_struct) {
         con_data->structure->target = &new_con_struct;
+        con_data->structure->Wake();
     }
 }
 
@@ -576,6 +582,7 @@ void game::ConveyorUpdateNeighborTermination(World& world, const WorldCoord& coo
             }
 
             con_data->structure->terminationType = new_ttype;
+            con_data->structure->Wake();
             ConveyorRenumber(world, neighbor_coord, 1);
         }
     };
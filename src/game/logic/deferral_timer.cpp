@@ -2,6 +2,8 @@
 
 #include "game/logic/deferral_timer.h"
 
+#include <algorithm>
+
 #include "game/world/world.h"
 
 using namespace jactorio;
@@ -12,15 +14,22 @@ void game::DeferralTimer::DeferralUpdate(Logic& logic, World& world, const GameT
     else
         assert(game_tick >= lastGameTick_);
 
-    lastGameTick_ = game_tick;
+    while (lastGameTick_ < game_tick) {
+        // Buckets are only ever non empty with registered callbacks
+        if (registeredCount_ == 0) {
+            lastGameTick_ = game_tick;
+            break;
+        }
 
-    // Call callbacks
-    for (auto& pair : callbacks_[game_tick]) {
-        pair.prototype->OnDeferTimeElapsed(world, logic, pair.uniqueData.Get());
-    }
+        const auto next_tick = GetNextEventTick();
+        if (next_tick > game_tick) {
+            lastGameTick_ = game_tick;
+            break;
+        }
 
-    // Remove used callbacks
-    callbacks_.erase(game_tick);
+        lastGameTick_ = next_tick;
+        DispatchTick(logic, world);
+    }
 }
 
 game::DeferralTimer::DeferralEntry game::DeferralTimer::RegisterAtTick(const DeferPrototypeT& deferred,
@@ -28,10 +37,8 @@ game::DeferralTimer::DeferralEntry game::DeferralTimer::RegisterAtTick(const Def
                                                                        const GameTickT due_game_tick) {
     assert(due_game_tick > lastGameTick_);
 
-    auto& due_tick_callback = callbacks_[due_game_tick];
-    due_tick_callback.emplace_back(CallbackContainerEntry{&deferred, unique_data});
-
-    return {due_game_tick, due_tick_callback.size()};
+    const auto slot = AllocateSlot(&deferred, unique_data, due_game_tick);
+    return {due_game_tick, MakeCallbackIndex(slot, slots_[slot].generation)};
 }
 
 game::DeferralTimer::DeferralEntry game::DeferralTimer::RegisterFromTick(const DeferPrototypeT& deferred,
@@ -42,21 +49,18 @@ game::DeferralTimer::DeferralEntry game::DeferralTimer::RegisterFromTick(const D
     return RegisterAtTick(deferred, unique_data, lastGameTick_ + elapse_game_tick);
 }
 
-void game::DeferralTimer::RemoveDeferral(DeferralEntry entry) {
+void game::DeferralTimer::RemoveDeferral(const DeferralEntry entry) {
     assert(entry.callbackIndex != 0); // Invalid callback index
 
-    // due_game_tick does not exist
-    if (callbacks_.find(entry.dueTick) == callbacks_.end())
+    const auto slot = FindSlot(entry);
+    if (slot == kNoSlot)
         return;
 
-    auto& due_tick_callback = callbacks_[entry.dueTick];
-
-    // Index is +1 than actual index
-    entry.callbackIndex -= 1;
-    assert(entry.callbackIndex <= due_tick_callback.size()); // Index out of range
-
-    // Instead of erasing, make the callback a blank function so that future remove calls do not go out of range
-    due_tick_callback[entry.callbackIndex].prototype = &blankCallback_;
+    // Slots awaiting dispatch are no longer in a bucket
+    if (slots_[slot].bucket != kDispatchBucket) {
+        UnlinkSlot(slot);
+    }
+    FreeSlot(slot);
 }
 
 void game::DeferralTimer::RemoveDeferralEntry(DeferralEntry& entry) {
@@ -68,5 +72,260 @@ void game::DeferralTimer::RemoveDeferralEntry(DeferralEntry& entry) {
 }
 
 game::DeferralTimer::DebugInfo game::DeferralTimer::GetDebugInfo() const {
-    return {callbacks_};
+    DebugInfo info;
+    for (const auto& slot : slots_) {
+        if (slot.prototype != nullptr) {
+            info.callbacks[slot.dueTick].push_back({slot.prototype, slot.uniqueData});
+        }
+    }
+    return info;
+}
+
+// ======================================================================
+
+game::DeferralTimer::SlotIndexT game::DeferralTimer::FindSlot(const DeferralEntry& entry) const {
+    auto callback_index = entry.callbackIndex;
+
+    if ((callback_index & kLegacyIndexFlag) != 0) {
+        const auto it = legacySlots_.find(entry.dueTick);
+        if (it == legacySlots_.end())
+            return kNoSlot;
+
+        const auto position = (callback_index & ~kLegacyIndexFlag) - 1;
+        if (position >= it->second.size())
+            return kNoSlot;
+
+        callback_index = it->second[position];
+        if (callback_index == 0)
+            return kNoSlot;
+    }
+
+    const auto slot       = static_cast<SlotIndexT>((callback_index & UINT32_MAX) - 1);
+    const auto generation = static_cast<uint32_t>(callback_index >> 32);
+
+    if (slot >= slots_.size())
+        return kNoSlot;
+
+    const auto& callback_slot = slots_[slot];
+    if (callback_slot.prototype == nullptr || callback_slot.generation != generation ||
+        callback_slot.dueTick != entry.dueTick)
+        return kNoSlot;
+
+    return slot;
+}
+
+game::DeferralTimer::SlotIndexT game::DeferralTimer::AllocateSlot(const DeferPrototypeT* prototype,
+                                                                  proto::UniqueDataBase* unique_data,
+                                                                  const GameTickT due_game_tick) {
+    SlotIndexT slot;
+    if (freeSlot_ != kNoSlot) {
+        slot      = freeSlot_;
+        freeSlot_ = slots_[slot].next;
+    }
+    else {
+        assert(slots_.size() < kNoSlot);
+        slot = SafeCast<SlotIndexT>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    auto& callback_slot      = slots_[slot];
+    callback_slot.prototype  = prototype;
+    callback_slot.uniqueData = unique_data;
+    callback_slot.dueTick    = due_game_tick;
+
+    LinkSlot(slot);
+    ++registeredCount_;
+    return slot;
+}
+
+void game::DeferralTimer::FreeSlot(const SlotIndexT slot) noexcept {
+    auto& callback_slot = slots_[slot];
+    assert(callback_slot.prototype != nullptr);
+
+    callback_slot.prototype  = nullptr;
+    callback_slot.uniqueData = nullptr;
+    callback_slot.generation = (callback_slot.generation + 1) & kGenerationMask;
+    callback_slot.bucket     = kNoBucket;
+    callback_slot.prev       = kNoSlot;
+    callback_slot.next       = freeSlot_;
+    freeSlot_                = slot;
+
+    --registeredCount_;
+}
+
+game::DeferralTimer::SlotIndexT game::DeferralTimer::GetBucket(const GameTickT due_tick) const noexcept {
+    assert(due_tick >= lastGameTick_);
+    const auto ticks_until_due = due_tick - lastGameTick_;
+
+    for (int level = 0; level < kLevelCount; ++level) {
+        const auto level_shift = kBucketBits * level;
+
+        if (ticks_until_due < GameTickT(1) << (level_shift + kBucketBits)) {
+            return SafeCast<SlotIndexT>(level * kBucketCount + ((due_tick >> level_shift) & kBucketMask));
+        }
+    }
+    return kOverflowBucket;
+}
+
+GameTickT game::DeferralTimer::GetNextEventTick() const noexcept {
+    auto next_tick = lastGameTick_ + 1;
+
+    // Empty levels have nothing to cascade until the level above them cascades
+    for (int level = 0; level < kLevelCount && levelSizes_[level] == 0; ++level) {
+        const auto level_span = GameTickT(1) << (kBucketBits * (level + 1));
+        next_tick             = (lastGameTick_ | (level_span - 1)) + 1;
+    }
+    return next_tick;
+}
+
+void game::DeferralTimer::LinkSlot(const SlotIndexT slot) noexcept {
+    auto& callback_slot  = slots_[slot];
+    callback_slot.bucket = GetBucket(callback_slot.dueTick);
+
+    auto& head         = buckets_[callback_slot.bucket];
+    callback_slot.prev = kNoSlot;
+    callback_slot.next = head;
+    if (head != kNoSlot) {
+        slots_[head].prev = slot;
+    }
+    head = slot;
+
+    ++levelSizes_[GetBucketLevel(callback_slot.bucket)];
+}
+
+void game::DeferralTimer::UnlinkSlot(const SlotIndexT slot) noexcept {
+    auto& callback_slot = slots_[slot];
+    assert(callback_slot.bucket < kNoBucket);
+
+    if (callback_slot.prev != kNoSlot) {
+        slots_[callback_slot.prev].next = callback_slot.next;
+    }
+    else {
+        buckets_[callback_slot.bucket] = callback_slot.next;
+    }
+
+    if (callback_slot.next != kNoSlot) {
+        slots_[callback_slot.next].prev = callback_slot.prev;
+    }
+
+    --levelSizes_[GetBucketLevel(callback_slot.bucket)];
+    callback_slot.bucket = kNoBucket;
+}
+
+void game::DeferralTimer::CascadeBucket(const SlotIndexT bucket) noexcept {
+    auto slot        = buckets_[bucket];
+    buckets_[bucket] = kNoSlot;
+
+    while (slot != kNoSlot) {
+        const auto next = slots_[slot].next;
+        --levelSizes_[GetBucketLevel(bucket)];
+        LinkSlot(slot);
+        slot = next;
+    }
+}
+
+void game::DeferralTimer::DispatchTick(Logic& logic, World& world) {
+    const auto tick = lastGameTick_;
+
+    // Level 0 has wrapped around, the next bucket of level 1 now fits in level 0, likewise for higher levels
+    if ((tick & kBucketMask) == 0) {
+        for (int level = 1; level < kLevelCount; ++level) {
+            const auto index = (tick >> (kBucketBits * level)) & kBucketMask;
+            CascadeBucket(SafeCast<SlotIndexT>(level * kBucketCount + index));
+
+            if (index != 0)
+                break;
+
+            if (level == kLevelCount - 1) {
+                CascadeBucket(kOverflowBucket);
+            }
+        }
+    }
+
+    // Detach due slots, callbacks may register or remove other callbacks
+    auto& due_bucket = buckets_[tick & kBucketMask];
+
+    dispatchSlots_.clear();
+    for (auto slot = due_bucket; slot != kNoSlot; slot = slots_[slot].next) {
+        auto& callback_slot = slots_[slot];
+        assert(callback_slot.dueTick == tick);
+
+        callback_slot.bucket = kDispatchBucket;
+        --levelSizes_[0];
+        dispatchSlots_.emplace_back(callback_slot.prototype->internalId, slot);
+    }
+    due_bucket = kNoSlot;
+
+    // Callbacks of the same prototype are called together
+    std::sort(dispatchSlots_.begin(), dispatchSlots_.end());
+
+    for (const auto& [prototype_id, slot] : dispatchSlots_) {
+        auto& callback_slot = slots_[slot];
+        // Removed by an earlier callback
+        if (callback_slot.bucket != kDispatchBucket)
+            continue;
+
+        const auto* prototype = callback_slot.prototype.Get();
+        auto* unique_data     = callback_slot.uniqueData.Get();
+        FreeSlot(slot);
+
+        prototype->OnDeferTimeElapsed(world, logic, unique_data);
+    }
+
+    if (!legacySlots_.empty()) {
+        legacySlots_.erase(tick);
+    }
+}
+
+void game::DeferralTimer::RebuildWheel() {
+    buckets_         = MakeEmptyBuckets();
+    freeSlot_        = kNoSlot;
+    registeredCount_ = 0;
+    levelSizes_      = {};
+
+    // Lowest free slots are reused first
+    for (auto slot = SafeCast<SlotIndexT>(slots_.size()); slot-- > 0;) {
+        auto& callback_slot = slots_[slot];
+
+        if (callback_slot.prototype == nullptr) {
+            callback_slot.bucket = kNoBucket;
+            callback_slot.prev   = kNoSlot;
+            callback_slot.next   = freeSlot_;
+            freeSlot_            = slot;
+            continue;
+        }
+
+        LinkSlot(slot);
+        ++registeredCount_;
+    }
+}
+
+void game::DeferralTimer::LoadLegacyCallbacks(
+    const std::unordered_map<GameTickT, std::vector<CallbackContainerEntry>>& callbacks) {
+    slots_.clear();
+    legacySlots_.clear();
+    RebuildWheel();
+
+    // Registered in order of due tick for consistent slots
+    std::vector<GameTickT> due_ticks;
+    due_ticks.reserve(callbacks.size());
+    for (const auto& [due_tick, tick_callbacks] : callbacks) {
+        due_ticks.push_back(due_tick);
+    }
+    std::sort(due_ticks.begin(), due_ticks.end());
+
+    for (const auto due_tick : due_ticks) {
+        auto& tick_slots = legacySlots_[due_tick];
+
+        for (const auto& callback : callbacks.at(due_tick)) {
+            // Removed callbacks were saved as nullptr, callbacks at or before the last tick were never called
+            if (callback.prototype == nullptr || due_tick <= lastGameTick_) {
+                tick_slots.push_back(0);
+                continue;
+            }
+
+            const auto slot = AllocateSlot(callback.prototype.Get(), callback.uniqueData.Get(), due_tick);
+            tick_slots.push_back(MakeCallbackIndex(slot, slots_[slot].generation));
+        }
+    }
 }
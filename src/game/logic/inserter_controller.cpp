@@ -48,7 +48,7 @@ using PickupQueue  = std::vector<InserterUpdateProps>;
 void RotateInserters(DropoffQueue& dropoff_queue, PickupQueue& pickup_queue, const InserterUpdateProps& props) {
     using namespace game;
 
-    assert(props.proto.rotationSpeed.getAsDouble() != 0);
+    assert(props.proto.rotationSpeed.AsDouble() != 0);
 
     switch (props.data.status) {
 
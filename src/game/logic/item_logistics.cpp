@@ -158,11 +158,11 @@ bool game::ItemDropOff::InsertTransportBelt(const DropOffParams& params) const {
         break;
     }
 
-    constexpr double insertion_offset_base = 0.5;
-    auto offset                            = proto::LineDistT(line_data.structIndex + insertion_offset_base);
+    constexpr proto::LineDistT insertion_offset_base(0.5);
+    auto offset = proto::LineDistT(line_data.structIndex) + insertion_offset_base;
 
     GetAdjustedLineOffset(use_line_left, offset, line_data);
-    return line_data.structure->TryInsertItem(use_line_left, offset.getAsDouble(), *params.itemStack.item);
+    return line_data.structure->TryInsertItem(use_line_left, offset, *params.itemStack.item);
 }
 
 bool game::ItemDropOff::CanInsertAssemblyMachine(const DropOffParams& params) const {
@@ -279,7 +279,7 @@ game::InserterPickup::GetPickupReturn game::InserterPickup::GetPickupTransportBe
 
         GetAdjustedLineOffset(left_lane, adjusted_pickup_offset, line_data);
 
-        auto [dq_index, line_item] = line_data.structure->GetItem(left_lane, adjusted_pickup_offset.getAsDouble());
+        auto [dq_index, line_item] = line_data.structure->GetItem(left_lane, adjusted_pickup_offset);
         return line_item.item.Get();
     };
 
@@ -304,7 +304,7 @@ game::InserterPickup::PickupReturn game::InserterPickup::PickupTransportBelt(con
         auto adjusted_pickup_offset = pickup_offset;
 
         GetAdjustedLineOffset(left_lane, adjusted_pickup_offset, line_data);
-        return line_data.structure->TryPopItem(left_lane, adjusted_pickup_offset.getAsDouble());
+        return line_data.structure->TryPopItem(left_lane, adjusted_pickup_offset);
     };
 
 
@@ -430,7 +430,7 @@ std::pair<bool, proto::LineDistT> game::InserterPickup::GetBeltPickupProps(const
 
     auto pickup_offset = proto::LineDistT(
         line_data.structIndex +
-        GetInserterArmOffset(SafeCast<TIntDegree>(params.degree.getAsInteger()), params.inserterTileReach));
+        GetInserterArmOffset(SafeCast<TIntDegree>(params.degree.AsInteger()), params.inserterTileReach));
 
     return {use_line_left, pickup_offset};
 }
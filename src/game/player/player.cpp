@@ -329,11 +329,15 @@ void game::Player::Placement::TryPickup(game::World& world,
         pickupTickTarget_ = LossyCast<uint16_t>(SafeCast<const proto::ResourceEntity*>(chosen_ptr)->pickupTime *
                                                 kGameHertz); // Seconds to ticks
         if (pickupTickCounter_ >= pickupTickTarget_) {
-            auto* resource_data = resource_tile->GetUniqueData<proto::ResourceEntityData>();
-            assert(resource_data != nullptr); // Resource tiles should have valid data
+            auto* chunk = world.GetChunkW(coord);
+            assert(chunk != nullptr);
+            chunk->MarkDirty();
+
+            auto& resource_amount = chunk->GetResourceAmount(Chunk::WorldCToChunkTileC(coord));
+            assert(resource_amount > 0); // Resource tiles should have resources remaining
 
             // Delete resource tile if it is empty after extracting
-            if (--resource_data->resourceAmount == 0) {
+            if (--resource_amount == 0) {
                 resource_tile->Clear();
                 world.SetTexCoordId(coord, TileLayer::resource, 0);
             }
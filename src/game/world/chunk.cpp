@@ -2,24 +2,52 @@
 
 #include "game/world/chunk.h"
 
+#include <algorithm>
+#include <new>
+
+#include "proto/resource_entity.h"
+
 using namespace jactorio;
 
-ChunkTileCoordAxis game::Chunk::WorldCToChunkTileC(const WorldCoordAxis coord) {
-    if (coord < 0) {
-        return (kChunkWidth - 1) - (-coord - 1) % kChunkWidth;
+game::Chunk::Chunk(const Chunk& other)
+    : overlays(other.overlays),
+      position_(other.position_),
+      tiles_(MakeTileBlock()),
+      texCoordIds_(other.texCoordIds_),
+      resourceAmounts_(other.resourceAmounts_),
+      dirty_(other.dirty_) {
+
+    for (std::size_t layer = 0; layer < kTileLayerCount; ++layer) {
+        for (std::size_t i = 0; i < kChunkArea; ++i) {
+            tiles_->layers[layer][i].common_ = other.tiles_->layers[layer][i].common_;
+        }
+    }
+    tiles_->sideTable.entityCount = other.tiles_->sideTable.entityCount;
+
+    const auto& other_tiles = other.tiles_->layers;
+    for (const auto& [key, unique_data] : other.tiles_->sideTable.uniqueData) {
+        const auto& tile = other_tiles[key / kChunkArea][key % kChunkArea];
+
+        // Use prototype defined method for copying unique data
+        const auto* prototype = tile.GetPrototype();
+        assert(prototype != nullptr); // No prototype available for copying unique data
+
+        auto copied_unique = prototype->CopyUniqueData(unique_data.get());
+        tiles_->sideTable.uniqueData[key] =
+            std::unique_ptr<ChunkTile::UniqueDataT>(SafeCast<ChunkTile::UniqueDataT*>(copied_unique.release()));
     }
-    return coord % kChunkWidth;
 }
+
 ChunkTileCoord game::Chunk::WorldCToChunkTileC(const WorldCoord& coord) {
     return {WorldCToChunkTileC(coord.x), WorldCToChunkTileC(coord.y)};
 }
 
 game::Chunk::TileArrayT& game::Chunk::Tiles(TileLayer tlayer) noexcept {
-    return layers_[static_cast<int>(tlayer)];
+    return tiles_->layers[static_cast<int>(tlayer)];
 }
 
 const game::Chunk::TileArrayT& game::Chunk::Tiles(TileLayer tlayer) const noexcept {
-    return layers_[static_cast<int>(tlayer)];
+    return tiles_->layers[static_cast<int>(tlayer)];
 }
 
 game::ChunkTile& game::Chunk::GetCTile(const ChunkTileCoord& coord, const TileLayer tlayer) noexcept {
@@ -36,6 +64,25 @@ const game::ChunkTile& game::Chunk::GetCTile(const ChunkTileCoord& coord, const
     return Tiles(tlayer)[SafeCast<IndexT>(coord.y) * kChunkWidth + coord.x];
 }
 
+ResourceEntityResourceCount& game::Chunk::GetResourceAmount(const ChunkTileCoord& coord) noexcept {
+    return const_cast<ResourceEntityResourceCount&>(static_cast<const Chunk*>(this)->GetResourceAmount(coord));
+}
+
+const ResourceEntityResourceCount& game::Chunk::GetResourceAmount(const ChunkTileCoord& coord) const noexcept {
+    assert(coord.x < kChunkWidth);
+    assert(coord.y < kChunkWidth);
+
+    return resourceAmounts_[static_cast<std::size_t>(coord.y) * kChunkWidth + coord.x];
+}
+
+bool game::Chunk::IsDirty() const noexcept {
+    return dirty_ || !tiles_->sideTable.uniqueData.empty();
+}
+
+bool game::Chunk::IsStandalone() const noexcept {
+    return tiles_->sideTable.entityCount == 0 && tiles_->sideTable.uniqueData.empty();
+}
+
 game::Chunk::OverlayContainerT& game::Chunk::GetOverlay(const OverlayLayer layer) {
     return const_cast<OverlayContainerT&>(static_cast<const Chunk*>(this)->GetOverlay(layer));
 }
@@ -43,3 +90,50 @@ game::Chunk::OverlayContainerT& game::Chunk::GetOverlay(const OverlayLayer layer
 const game::Chunk::OverlayContainerT& game::Chunk::GetOverlay(OverlayLayer layer) const {
     return overlays[static_cast<OverlayArrayT::size_type>(layer)];
 }
+
+void game::Chunk::CountEntities() noexcept {
+    std::size_t entity_count = 0;
+    for (const auto& layer : tiles_->layers) {
+        entity_count += std::count_if(
+            layer.begin(), layer.end(), [](const ChunkTile& tile) { return tile.IsCountedEntity(); });
+    }
+    tiles_->sideTable.entityCount = entity_count;
+}
+
+void game::Chunk::LoadLegacyResourceAmounts() noexcept {
+    auto& tiles = Tiles(TileLayer::resource);
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        auto& tile = tiles[i];
+
+        const auto* resource_data = tile.GetUniqueData<proto::ResourceEntityData>();
+        if (resource_data == nullptr)
+            continue;
+
+        resourceAmounts_[i] = resource_data->resourceAmount;
+
+        // Clearing is the only way to release unique data, prototype and orientation are kept
+        const auto orientation = tile.GetOrientation();
+        const auto* prototype  = tile.GetPrototype();
+        tile.Clear();
+        tile.SetPrototype(orientation, prototype);
+    }
+}
+
+std::unique_ptr<game::Chunk::TileBlock, game::Chunk::TileBlockDeleter> game::Chunk::MakeTileBlock() {
+    auto* memory = ::operator new(TileBlockBytes(), std::align_val_t{TileBlockBytes()});
+    return std::unique_ptr<TileBlock, TileBlockDeleter>(new (memory) TileBlock());
+}
+
+void game::Chunk::TileBlockDeleter::operator()(TileBlock* block) const noexcept {
+    block->~TileBlock();
+    ::operator delete(block, std::align_val_t{TileBlockBytes()});
+}
+
+game::Chunk::TileBlock& game::Chunk::GetTileBlock(ChunkTile& tile) noexcept {
+    return const_cast<TileBlock&>(GetTileBlock(static_cast<const ChunkTile&>(tile)));
+}
+
+const game::Chunk::TileBlock& game::Chunk::GetTileBlock(const ChunkTile& tile) noexcept {
+    const auto address = reinterpret_cast<std::uintptr_t>(&tile);
+    return *reinterpret_cast<const TileBlock*>(address & ~(TileBlockBytes() - 1));
+}
@@ -0,0 +1,98 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "game/world/chunk_directory.h"
+
+#include <algorithm>
+
+using namespace jactorio;
+
+bool game::ChunkDirectory::Erase(const ChunkCoord& c_coord) {
+    const auto page_x = c_coord.x >> kPageWidthShift;
+    const auto page_y = c_coord.y >> kPageWidthShift;
+
+    auto* page = const_cast<Page*>(FindPage(page_x, page_y));
+    if (page == nullptr)
+        return false;
+
+    auto& chunk = page->chunks[GetPageIndex(c_coord)];
+    if (chunk == nullptr)
+        return false;
+
+    chunk.reset();
+    --page->size;
+    --size_;
+
+    if (page->size == 0) {
+        const auto x = SafeCast<std::size_t>(page_x - pageOriginX_);
+        const auto y = SafeCast<std::size_t>(page_y - pageOriginY_);
+        pages_[y * pagesWidth_ + x].reset();
+    }
+    return true;
+}
+
+void game::ChunkDirectory::Clear() noexcept {
+    pages_.clear();
+    pageOriginX_ = 0;
+    pageOriginY_ = 0;
+    pagesWidth_  = 0;
+    pagesHeight_ = 0;
+    size_        = 0;
+}
+
+game::Chunk& game::ChunkDirectory::Insert(const ChunkCoord& c_coord, std::unique_ptr<Chunk> chunk) {
+    assert(chunk != nullptr);
+
+    auto& page = MakePage(c_coord.x >> kPageWidthShift, c_coord.y >> kPageWidthShift);
+    auto& slot = page.chunks[GetPageIndex(c_coord)];
+    assert(slot == nullptr); // Attempted to insert at already existent location
+
+    slot = std::move(chunk);
+    ++page.size;
+    ++size_;
+    return *slot;
+}
+
+game::ChunkDirectory::Page& game::ChunkDirectory::MakePage(const ChunkCoordAxis page_x, const ChunkCoordAxis page_y) {
+    if (pages_.empty()) {
+        pages_.resize(1);
+        pageOriginX_ = page_x;
+        pageOriginY_ = page_y;
+        pagesWidth_  = 1;
+        pagesHeight_ = 1;
+    }
+    else if (FindPage(page_x, page_y) == nullptr) {
+        const auto end_x = pageOriginX_ + SafeCast<ChunkCoordAxis>(pagesWidth_);
+        const auto end_y = pageOriginY_ + SafeCast<ChunkCoordAxis>(pagesHeight_);
+
+        const auto new_origin_x = std::min(pageOriginX_, page_x);
+        const auto new_origin_y = std::min(pageOriginY_, page_y);
+        const auto new_width    = SafeCast<std::size_t>(std::max(end_x, page_x + 1) - new_origin_x);
+        const auto new_height   = SafeCast<std::size_t>(std::max(end_y, page_y + 1) - new_origin_y);
+
+        // Grid only changes when a page outside it is needed
+        if (new_width != pagesWidth_ || new_height != pagesHeight_) {
+            std::vector<std::unique_ptr<Page>> new_pages(new_width * new_height);
+
+            const auto offset_x = SafeCast<std::size_t>(pageOriginX_ - new_origin_x);
+            const auto offset_y = SafeCast<std::size_t>(pageOriginY_ - new_origin_y);
+            for (std::size_t y = 0; y < pagesHeight_; ++y) {
+                for (std::size_t x = 0; x < pagesWidth_; ++x) {
+                    new_pages[(y + offset_y) * new_width + x + offset_x] = std::move(pages_[y * pagesWidth_ + x]);
+                }
+            }
+
+            pages_       = std::move(new_pages);
+            pageOriginX_ = new_origin_x;
+            pageOriginY_ = new_origin_y;
+            pagesWidth_  = new_width;
+            pagesHeight_ = new_height;
+        }
+    }
+
+    auto& page = pages_[SafeCast<std::size_t>(page_y - pageOriginY_) * pagesWidth_ +
+                        SafeCast<std::size_t>(page_x - pageOriginX_)];
+    if (page == nullptr) {
+        page = std::make_unique<Page>();
+    }
+    return *page;
+}
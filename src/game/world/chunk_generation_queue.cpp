@@ -0,0 +1,96 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "game/world/chunk_generation_queue.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace jactorio;
+
+game::ChunkGenerationQueue::ChunkGenerationQueue(ChunkGenerationQueue&& other) noexcept {
+    std::lock_guard guard{other.mutex_};
+    heap_   = std::move(other.heap_);
+    queued_ = std::move(other.queued_);
+    focus_  = std::move(other.focus_);
+}
+
+game::ChunkGenerationQueue& game::ChunkGenerationQueue::operator=(ChunkGenerationQueue&& other) noexcept {
+    if (this != &other) {
+        std::scoped_lock guard{mutex_, other.mutex_};
+        heap_   = std::move(other.heap_);
+        queued_ = std::move(other.queued_);
+        focus_  = std::move(other.focus_);
+    }
+    return *this;
+}
+
+void game::ChunkGenerationQueue::Push(const ChunkCoord& c_coord) {
+    std::lock_guard guard{mutex_};
+
+    if (!queued_.emplace(c_coord.x, c_coord.y).second)
+        return;
+
+    heap_.push_back({c_coord, GetDistance(c_coord)});
+    std::push_heap(heap_.begin(), heap_.end(), &TakenAfter);
+}
+
+bool game::ChunkGenerationQueue::Pop(ChunkCoord& c_coord) {
+    std::lock_guard guard{mutex_};
+
+    if (heap_.empty())
+        return false;
+
+    std::pop_heap(heap_.begin(), heap_.end(), &TakenAfter);
+    c_coord = heap_.back().coord;
+    heap_.pop_back();
+
+    queued_.erase({c_coord.x, c_coord.y});
+    return true;
+}
+
+void game::ChunkGenerationQueue::SetFocus(std::vector<ChunkCoord> focus) {
+    std::lock_guard guard{mutex_};
+
+    if (focus == focus_)
+        return;
+
+    // Distances are only recalculated when the focus moves, usually once every few seconds
+    focus_ = std::move(focus);
+    for (auto& entry : heap_) {
+        entry.distance = GetDistance(entry.coord);
+    }
+    std::make_heap(heap_.begin(), heap_.end(), &TakenAfter);
+}
+
+void game::ChunkGenerationQueue::Clear() noexcept {
+    std::lock_guard guard{mutex_};
+    heap_.clear();
+    queued_.clear();
+}
+
+std::size_t game::ChunkGenerationQueue::Size() const {
+    std::lock_guard guard{mutex_};
+    return heap_.size();
+}
+
+bool game::ChunkGenerationQueue::TakenAfter(const Entry& a, const Entry& b) noexcept {
+    // Coordinate breaks ties so chunks are taken in the same order every run
+    return std::tie(a.distance, a.coord.y, a.coord.x) > std::tie(b.distance, b.coord.y, b.coord.x);
+}
+
+uint64_t game::ChunkGenerationQueue::GetDistance(const ChunkCoord& c_coord) const noexcept {
+    auto distance_to = [&c_coord](const ChunkCoord& focus) {
+        const auto x = static_cast<int64_t>(c_coord.x) - focus.x;
+        const auto y = static_cast<int64_t>(c_coord.y) - focus.y;
+        return static_cast<uint64_t>(x * x + y * y);
+    };
+
+    if (focus_.empty())
+        return distance_to({0, 0});
+
+    auto distance = std::numeric_limits<uint64_t>::max();
+    for (const auto& focus : focus_) {
+        distance = std::min(distance, distance_to(focus));
+    }
+    return distance;
+}
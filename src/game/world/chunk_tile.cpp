@@ -3,58 +3,32 @@
 #include "game/world/chunk_tile.h"
 
 #include "core/coordinate_tuple.h"
+#include "game/world/chunk.h"
 
 using namespace jactorio;
 
-game::ChunkTile::~ChunkTile() {
-    if (IsTopLeft()) {
-        data_.DestructTopLeft();
-    }
-    else {
-        data_.DestructNonTopLeft();
-    }
-}
-
-game::ChunkTile::ChunkTile(const ChunkTile& other) : common_(other.common_) {
-    if (other.IsTopLeft()) {
-        AsTopLeft() = other.AsTopLeft();
-        other.AsTopLeft().CopyUniqueData(AsTopLeft(), GetPrototype());
-    }
-    else {
-        AsNonTopLeft() = other.AsNonTopLeft();
-    }
-}
-
-game::ChunkTile::ChunkTile(ChunkTile&& other) noexcept : common_(other.common_) {
-    if (IsTopLeft()) {
-        AsTopLeft() = std::move(other.AsTopLeft());
-    }
-    else {
-        AsNonTopLeft() = std::move(other.AsNonTopLeft());
-    }
-}
-
+// Chunks hold kChunkArea tiles for each layer, unique data and top left are kept in the side table of the chunk
+static_assert(sizeof(game::ChunkTile) == sizeof(uint32_t));
 
 void game::ChunkTile::Clear() noexcept {
-    if (IsTopLeft()) {
-        data_.DestructTopLeft();
-    }
-    else {
-        data_.DestructNonTopLeft();
-    }
+    const bool was_counted = IsCountedEntity();
 
-    data_.ConstructTopLeft();
+    auto& side_table = GetSideTable();
+    const auto key   = GetSideTableKey();
 
-    common_.~Common();
-    new (&common_) Common();
+    side_table.uniqueData.erase(key);
+    side_table.topLeft.erase(key);
+
+    common_ = Common();
+    RecountEntity(was_counted);
 }
 
 void game::ChunkTile::SetOrientation(const Orientation orientation) noexcept {
-    common_.orientation = orientation;
+    common_.SetOrientation(orientation);
 }
 
 Orientation game::ChunkTile::GetOrientation() const noexcept {
-    return common_.orientation;
+    return common_.GetOrientation();
 }
 
 void game::ChunkTile::SetPrototype(const Orientation orientation, PrototypeT& prototype) noexcept {
@@ -62,18 +36,24 @@ void game::ChunkTile::SetPrototype(const Orientation orientation, PrototypeT& pr
 }
 
 void game::ChunkTile::SetPrototype(const Orientation orientation, PrototypeT* prototype) noexcept {
+    const bool was_counted = IsCountedEntity();
+
     SetOrientation(orientation);
-    common_.prototype = prototype;
+    common_.SetPrototype(prototype);
+    RecountEntity(was_counted);
 }
 
 void game::ChunkTile::SetPrototype(std::nullptr_t) noexcept {
-    common_.prototype = nullptr;
+    const bool was_counted = IsCountedEntity();
+
+    common_.SetPrototype(nullptr);
+    RecountEntity(was_counted);
 }
 
 // ======================================================================
 
 bool game::ChunkTile::IsTopLeft() const noexcept {
-    return IsTopLeft(common_.multiTileIndex);
+    return IsTopLeft(common_.GetMultiTileIndex());
 }
 
 bool game::ChunkTile::IsMultiTile() const noexcept {
@@ -96,20 +76,26 @@ Dimension game::ChunkTile::GetDimension() const noexcept {
 
 void game::ChunkTile::SetupMultiTile(const TileDistanceT multi_tile_index, ChunkTile& top_left) noexcept {
     assert(multi_tile_index > 0);
+    assert(&top_left != this);
+
+    const bool was_counted = IsCountedEntity();
 
-    data_.DestructTopLeft();
-    data_.ConstructNonTopLeft();
+    auto& side_table = GetSideTable();
+    const auto key   = GetSideTableKey();
 
-    common_.multiTileIndex = multi_tile_index;
+    // Only top left tiles hold unique data
+    side_table.uniqueData.erase(key);
+    side_table.topLeft[key] = &top_left;
 
+    common_.SetMultiTileIndex(multi_tile_index);
     assert(!IsTopLeft());
-    assert(&top_left != this);
-    AsNonTopLeft().topLeft = &top_left;
+
+    RecountEntity(was_counted);
 }
 
 
 game::ChunkTile::TileDistanceT game::ChunkTile::GetMultiTileIndex() const noexcept {
-    return common_.multiTileIndex;
+    return common_.GetMultiTileIndex();
 }
 
 game::ChunkTile* game::ChunkTile::GetTopLeft() noexcept {
@@ -120,8 +106,13 @@ const game::ChunkTile* game::ChunkTile::GetTopLeft() const noexcept {
     if (IsTopLeft())
         return this;
 
-    assert(!IsTopLeft());
-    return AsNonTopLeft().topLeft;
+    const auto& side_table = GetSideTable();
+
+    const auto it = side_table.topLeft.find(GetSideTableKey());
+    if (it == side_table.topLeft.end())
+        return nullptr;
+
+    return it->second;
 }
 
 
@@ -142,38 +133,59 @@ bool game::ChunkTile::IsTopLeft(const TileDistanceT multi_tile_index) noexcept {
     return multi_tile_index == 0;
 }
 
-game::ChunkTile::TopLeft& game::ChunkTile::AsTopLeft() noexcept {
-    assert(IsTopLeft());
-    return data_.topLeft;
+game::ChunkTile::SideTable& game::ChunkTile::GetSideTable() noexcept {
+    return Chunk::GetTileBlock(*this).sideTable;
 }
 
-const game::ChunkTile::TopLeft& game::ChunkTile::AsTopLeft() const noexcept {
-    assert(IsTopLeft());
-    return data_.topLeft;
+const game::ChunkTile::SideTable& game::ChunkTile::GetSideTable() const noexcept {
+    return Chunk::GetTileBlock(*this).sideTable;
 }
 
-game::ChunkTile::NonTopLeft& game::ChunkTile::AsNonTopLeft() noexcept {
-    assert(!IsTopLeft());
-    return data_.nonTopLeft;
+game::ChunkTile::SideTableKeyT game::ChunkTile::GetSideTableKey() const noexcept {
+    const auto& block = Chunk::GetTileBlock(*this);
+    const auto offset = reinterpret_cast<std::uintptr_t>(this) - reinterpret_cast<std::uintptr_t>(&block);
+
+    assert(offset < sizeof(block.layers));
+    return SafeCast<SideTableKeyT>(offset / sizeof(ChunkTile));
 }
 
-const game::ChunkTile::NonTopLeft& game::ChunkTile::AsNonTopLeft() const noexcept {
-    assert(!IsTopLeft());
-    return data_.nonTopLeft;
+game::ChunkTile::UniqueDataContainerT& game::ChunkTile::UniqueDataSlot() {
+    assert(IsTopLeft());
+    return GetSideTable().uniqueData[GetSideTableKey()];
 }
 
-// ======================================================================
+game::ChunkTile::UniqueDataT* game::ChunkTile::FindUniqueData() const noexcept {
+    const auto* top_left = GetTopLeft();
+    assert(top_left != nullptr);
 
-game::ChunkTile::TopLeft::TopLeft(const TopLeft& /*other*/) noexcept {}
+    const auto& side_table = top_left->GetSideTable();
 
-void game::ChunkTile::TopLeft::CopyUniqueData(TopLeft& to, PrototypeT* prototype) const {
-    // Use prototype defined method for copying uniqueData_ if other has data to copy
-    if (uniqueData != nullptr) {
-        assert(prototype != nullptr); // No prototype available for copying unique data
+    const auto it = side_table.uniqueData.find(top_left->GetSideTableKey());
+    if (it == side_table.uniqueData.end())
+        return nullptr;
 
-        auto copied_unique = prototype->CopyUniqueData(uniqueData.get());
-        to.uniqueData      = std::unique_ptr<UniqueDataT>(SafeCast<UniqueDataT*>(copied_unique.release()));
-    }
+    return it->second.get();
+}
+
+bool game::ChunkTile::IsCountedEntity() const noexcept {
+    if (IsMultiTile())
+        return true;
+
+    return GetPrototype() != nullptr &&
+        GetSideTableKey() / Chunk::kChunkArea == static_cast<SideTableKeyT>(TileLayer::entity);
 }
 
-game::ChunkTile::NonTopLeft::NonTopLeft(const NonTopLeft& /*other*/) : topLeft(nullptr) {}
+void game::ChunkTile::RecountEntity(const bool was_counted) noexcept {
+    const bool counted = IsCountedEntity();
+    if (counted == was_counted)
+        return;
+
+    auto& entity_count = GetSideTable().entityCount;
+    if (counted) {
+        ++entity_count;
+    }
+    else {
+        assert(entity_count > 0);
+        --entity_count;
+    }
+}
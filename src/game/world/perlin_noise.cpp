@@ -0,0 +1,528 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "game/world/perlin_noise.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <noise/noise.h>
+#include <noise/noiseutils.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define JACTORIO_NOISE_X86
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Kernels for instruction sets beyond what the compiler targets are enabled per function
+#if defined(__GNUC__) || defined(__clang__)
+#define JACTORIO_TARGET_SSE2 __attribute__((target("sse2")))
+#define JACTORIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define JACTORIO_TARGET_SSE2
+#define JACTORIO_TARGET_AVX2
+#endif
+
+using namespace jactorio;
+
+namespace
+{
+    // Constants of libnoise noisegen.cpp and module::Perlin
+
+    constexpr uint32_t kXNoiseGen    = 1619;
+    constexpr uint32_t kZNoiseGen    = 6971;
+    constexpr uint32_t kSeedNoiseGen = 1013;
+    constexpr int kShiftNoiseGen     = 8;
+
+    constexpr double kLacunarity = 2.;
+    /// libnoise wraps coordinates at or beyond this
+    constexpr double kInt32Range = 1073741824.;
+
+    constexpr int kWidth = game::Chunk::kChunkWidth;
+
+    /// x and z components of libnoise's gradient vectors, multiplied by libnoise's gradient scale
+    ///
+    /// Plane samples are at y 0, where the y component of each gradient contributes nothing
+    struct GradientTable
+    {
+        alignas(32) double x[256];
+        alignas(32) double z[256];
+    };
+
+    /// Coordinates sampled by utils::NoiseMapBuilderPlane for a chunk, accumulated the same way
+    struct ChunkSamples
+    {
+        alignas(32) double x[kWidth];
+        double z[kWidth];
+    };
+
+    FORCEINLINE uint32_t HashToIndex(uint32_t hash) {
+        hash ^= hash >> kShiftNoiseGen;
+        return hash & 0xff;
+    }
+
+    /// \return Index into GradientTable for lattice point ix, 0, iz
+    FORCEINLINE uint32_t LatticeIndex(const int32_t ix, const int32_t iz, const uint32_t seed) {
+        return HashToIndex(kXNoiseGen * static_cast<uint32_t>(ix) + kZNoiseGen * static_cast<uint32_t>(iz) +
+                           kSeedNoiseGen * seed);
+    }
+
+    const GradientTable& GetGradientTable() {
+        static const GradientTable table = [] {
+            GradientTable t{};
+
+            // libnoise keeps its vector table internal, a vector is recovered by evaluating the gradient
+            // at unit offsets from a lattice point which hashes to its index
+            std::array<bool, 256> found{};
+            int remaining = 256;
+            for (int32_t ix = 0; remaining > 0; ++ix) {
+                const auto index = LatticeIndex(ix, 0, 0);
+                if (found[index])
+                    continue;
+
+                found[index] = true;
+                --remaining;
+
+                t.x[index] = noise::GradientNoise3D(ix + 1., 0., 0., ix, 0, 0, 0);
+                t.z[index] = noise::GradientNoise3D(ix, 0., 1., ix, 0, 0, 0);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    ChunkSamples GetChunkSamples(const ChunkCoord& c_coord) {
+        // Since x, y represents the center of the chunk, +- 0.5 to get the edges
+        const double lower_x = c_coord.x - 0.5;
+        const double lower_z = c_coord.y - 0.5;
+        const double x_delta = (c_coord.x + 0.5 - lower_x) / kWidth;
+        const double z_delta = (c_coord.y + 0.5 - lower_z) / kWidth;
+
+        ChunkSamples samples;
+        double x_cur = lower_x;
+        double z_cur = lower_z;
+        for (int i = 0; i < kWidth; ++i) {
+            samples.x[i] = x_cur;
+            samples.z[i] = z_cur;
+            x_cur += x_delta;
+            z_cur += z_delta;
+        }
+        return samples;
+    }
+
+    /// \return true if libnoise wraps any coordinate sampled, only the scalar kernel wraps coordinates
+    bool ExceedsInt32Range(const game::PerlinParams& params, const ChunkSamples& samples) {
+        double max_coord = 0;
+        for (int i = 0; i < kWidth; ++i) {
+            max_coord = std::max({max_coord, std::abs(samples.x[i]), std::abs(samples.z[i])});
+        }
+
+        max_coord *= std::abs(params.frequency);
+        for (int octave = 1; octave < params.octaveCount; ++octave) {
+            max_coord *= kLacunarity;
+        }
+        return !(max_coord < kInt32Range); // NaN included
+    }
+
+    // ======================================================================
+    // Scalar
+
+    FORCEINLINE double MakeInt32Range(const double n) {
+        if (n >= kInt32Range)
+            return 2. * std::fmod(n, kInt32Range) - kInt32Range;
+        if (n <= -kInt32Range)
+            return 2. * std::fmod(n, kInt32Range) + kInt32Range;
+        return n;
+    }
+
+    /// \return Lattice point below n, as libnoise does: n on a lattice point at or below 0 gives the one below
+    FORCEINLINE int32_t LatticeFloor(const double n) {
+        return n > 0. ? static_cast<int32_t>(n) : static_cast<int32_t>(n) - 1;
+    }
+
+    FORCEINLINE double SCurve3(const double a) {
+        return a * a * (3. - 2. * a);
+    }
+
+    FORCEINLINE double LinearInterp(const double n0, const double n1, const double a) {
+        return (1. - a) * n0 + a * n1;
+    }
+
+    FORCEINLINE double GradientNoise(const GradientTable& table,
+                                     const double fx,
+                                     const double fz,
+                                     const int32_t ix,
+                                     const int32_t iz,
+                                     const uint32_t seed) {
+        const auto index = LatticeIndex(ix, iz, seed);
+        return table.x[index] * (fx - ix) + table.z[index] * (fz - iz);
+    }
+
+    double PerlinScalar(const GradientTable& table, const game::PerlinParams& params, double x, double z) {
+        double value       = 0.;
+        double persistence = 1.;
+
+        x *= params.frequency;
+        z *= params.frequency;
+        for (int octave = 0; octave < params.octaveCount; ++octave) {
+            const double nx = MakeInt32Range(x);
+            const double nz = MakeInt32Range(z);
+            const auto seed = static_cast<uint32_t>(params.seed) + static_cast<uint32_t>(octave);
+
+            const auto x0   = LatticeFloor(nx);
+            const auto z0   = LatticeFloor(nz);
+            const double xs = SCurve3(nx - x0);
+            const double zs = SCurve3(nz - z0);
+
+            const double ix0 = LinearInterp(GradientNoise(table, nx, nz, x0, z0, seed),
+                                            GradientNoise(table, nx, nz, x0 + 1, z0, seed),
+                                            xs);
+            const double ix1 = LinearInterp(GradientNoise(table, nx, nz, x0, z0 + 1, seed),
+                                            GradientNoise(table, nx, nz, x0 + 1, z0 + 1, seed),
+                                            xs);
+            value += LinearInterp(ix0, ix1, zs) * persistence;
+
+            x *= kLacunarity;
+            z *= kLacunarity;
+            persistence *= params.persistence;
+        }
+        return value;
+    }
+
+    void ChunkNoiseScalar(const GradientTable& table,
+                          const game::PerlinParams& params,
+                          const ChunkSamples& samples,
+                          game::ChunkNoiseMap& noise_map) {
+        for (int z = 0; z < kWidth; ++z) {
+            for (int x = 0; x < kWidth; ++x) {
+                noise_map[z * kWidth + x] = static_cast<float>(PerlinScalar(table, params, samples.x[x], samples.z[z]));
+            }
+        }
+    }
+
+    // ======================================================================
+    // SIMD
+    //
+    // Each row of the chunk shares its z lattice points, the x coordinates of a row are evaluated together
+    // Operations are performed in the same order as the scalar kernel without fused multiply add,
+    // so results match libnoise as closely as the scalar kernel
+
+#if defined(JACTORIO_NOISE_X86)
+
+    JACTORIO_TARGET_SSE2 FORCEINLINE __m128d LinearInterpSse2(const __m128d n0, const __m128d n1, const __m128d a) {
+        return _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_set1_pd(1.), a), n0), _mm_mul_pd(a, n1));
+    }
+
+    JACTORIO_TARGET_SSE2 FORCEINLINE __m128d GradientNoiseSse2(const GradientTable& table,
+                                                               const uint32_t x_hash_a,
+                                                               const uint32_t x_hash_b,
+                                                               const uint32_t z_hash,
+                                                               const __m128d dx,
+                                                               const __m128d dz) {
+        const auto index_a = HashToIndex(x_hash_a + z_hash);
+        const auto index_b = HashToIndex(x_hash_b + z_hash);
+
+        const __m128d gx = _mm_set_pd(table.x[index_b], table.x[index_a]);
+        const __m128d gz = _mm_set_pd(table.z[index_b], table.z[index_a]);
+        return _mm_add_pd(_mm_mul_pd(gx, dx), _mm_mul_pd(gz, dz));
+    }
+
+    JACTORIO_TARGET_SSE2 void ChunkNoiseSse2(const GradientTable& table,
+                                             const game::PerlinParams& params,
+                                             const ChunkSamples& samples,
+                                             game::ChunkNoiseMap& noise_map) {
+        const __m128d zero       = _mm_setzero_pd();
+        const __m128d one        = _mm_set1_pd(1.);
+        const __m128d two        = _mm_set1_pd(2.);
+        const __m128d three      = _mm_set1_pd(3.);
+        const __m128d lacunarity = _mm_set1_pd(kLacunarity);
+
+        for (int row = 0; row < kWidth; ++row) {
+            alignas(16) double x[kWidth];
+            alignas(16) double value[kWidth] = {};
+            for (int i = 0; i < kWidth; ++i) {
+                x[i] = samples.x[i] * params.frequency;
+            }
+            double z           = samples.z[row] * params.frequency;
+            double persistence = 1.;
+
+            for (int octave = 0; octave < params.octaveCount; ++octave) {
+                const auto seed = static_cast<uint32_t>(params.seed) + static_cast<uint32_t>(octave);
+
+                const auto z0       = LatticeFloor(z);
+                const __m128d zs    = _mm_set1_pd(SCurve3(z - z0));
+                const __m128d dz0   = _mm_set1_pd(z - z0);
+                const __m128d dz1   = _mm_set1_pd(z - (z0 + 1));
+                const auto z_hash0  = kZNoiseGen * static_cast<uint32_t>(z0) + kSeedNoiseGen * seed;
+                const auto z_hash1  = z_hash0 + kZNoiseGen;
+                const __m128d scale = _mm_set1_pd(persistence);
+
+                for (int i = 0; i < kWidth; i += 2) {
+                    const __m128d nx = _mm_load_pd(x + i);
+
+                    // Truncate, then one lower if at or below 0
+                    __m128d x0 = _mm_cvtepi32_pd(_mm_cvttpd_epi32(nx));
+                    x0         = _mm_sub_pd(x0, _mm_and_pd(_mm_cmple_pd(nx, zero), one));
+
+                    const __m128d dx0 = _mm_sub_pd(nx, x0);
+                    const __m128d dx1 = _mm_sub_pd(nx, _mm_add_pd(x0, one));
+                    const __m128d xs  = _mm_mul_pd(_mm_mul_pd(dx0, dx0), _mm_sub_pd(three, _mm_mul_pd(two, dx0)));
+
+                    // No 32 bit multiply in SSE2, lattice points are hashed one at a time
+                    const __m128i x0_i   = _mm_cvttpd_epi32(x0);
+                    const auto x0_a      = _mm_cvtsi128_si32(x0_i);
+                    const auto x0_b      = _mm_cvtsi128_si32(_mm_srli_si128(x0_i, 4));
+                    const auto x_hash0_a = kXNoiseGen * static_cast<uint32_t>(x0_a);
+                    const auto x_hash0_b = kXNoiseGen * static_cast<uint32_t>(x0_b);
+                    const auto x_hash1_a = x_hash0_a + kXNoiseGen;
+                    const auto x_hash1_b = x_hash0_b + kXNoiseGen;
+
+                    const __m128d ix0 =
+                        LinearInterpSse2(GradientNoiseSse2(table, x_hash0_a, x_hash0_b, z_hash0, dx0, dz0),
+                                         GradientNoiseSse2(table, x_hash1_a, x_hash1_b, z_hash0, dx1, dz0),
+                                         xs);
+                    const __m128d ix1 =
+                        LinearInterpSse2(GradientNoiseSse2(table, x_hash0_a, x_hash0_b, z_hash1, dx0, dz1),
+                                         GradientNoiseSse2(table, x_hash1_a, x_hash1_b, z_hash1, dx1, dz1),
+                                         xs);
+
+                    const __m128d signal = LinearInterpSse2(ix0, ix1, zs);
+                    _mm_store_pd(value + i, _mm_add_pd(_mm_load_pd(value + i), _mm_mul_pd(signal, scale)));
+                    _mm_store_pd(x + i, _mm_mul_pd(nx, lacunarity));
+                }
+
+                z *= kLacunarity;
+                persistence *= params.persistence;
+            }
+
+            for (int i = 0; i < kWidth; i += 4) {
+                const __m128 low  = _mm_cvtpd_ps(_mm_load_pd(value + i));
+                const __m128 high = _mm_cvtpd_ps(_mm_load_pd(value + i + 2));
+                _mm_storeu_ps(noise_map.data() + row * kWidth + i, _mm_movelh_ps(low, high));
+            }
+        }
+    }
+
+    JACTORIO_TARGET_AVX2 FORCEINLINE __m256d LinearInterpAvx2(const __m256d n0, const __m256d n1, const __m256d a) {
+        return _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_set1_pd(1.), a), n0), _mm256_mul_pd(a, n1));
+    }
+
+    JACTORIO_TARGET_AVX2 FORCEINLINE __m256d GradientNoiseAvx2(
+        const GradientTable& table, const __m128i x_hash, const uint32_t z_hash, const __m256d dx, const __m256d dz) {
+
+        __m128i index = _mm_add_epi32(x_hash, _mm_set1_epi32(static_cast<int>(z_hash)));
+        index         = _mm_xor_si128(index, _mm_srli_epi32(index, kShiftNoiseGen));
+        index         = _mm_and_si128(index, _mm_set1_epi32(0xff));
+
+        const __m256d gx = _mm256_i32gather_pd(table.x, index, sizeof(double));
+        const __m256d gz = _mm256_i32gather_pd(table.z, index, sizeof(double));
+        return _mm256_add_pd(_mm256_mul_pd(gx, dx), _mm256_mul_pd(gz, dz));
+    }
+
+    JACTORIO_TARGET_AVX2 void ChunkNoiseAvx2(const GradientTable& table,
+                                             const game::PerlinParams& params,
+                                             const ChunkSamples& samples,
+                                             game::ChunkNoiseMap& noise_map) {
+        const __m256d zero       = _mm256_setzero_pd();
+        const __m256d one        = _mm256_set1_pd(1.);
+        const __m256d two        = _mm256_set1_pd(2.);
+        const __m256d three      = _mm256_set1_pd(3.);
+        const __m256d lacunarity = _mm256_set1_pd(kLacunarity);
+        const __m128i x_gen      = _mm_set1_epi32(static_cast<int>(kXNoiseGen));
+
+        for (int row = 0; row < kWidth; ++row) {
+            alignas(32) double x[kWidth];
+            alignas(32) double value[kWidth] = {};
+            for (int i = 0; i < kWidth; ++i) {
+                x[i] = samples.x[i] * params.frequency;
+            }
+            double z           = samples.z[row] * params.frequency;
+            double persistence = 1.;
+
+            for (int octave = 0; octave < params.octaveCount; ++octave) {
+                const auto seed = static_cast<uint32_t>(params.seed) + static_cast<uint32_t>(octave);
+
+                const auto z0       = LatticeFloor(z);
+                const __m256d zs    = _mm256_set1_pd(SCurve3(z - z0));
+                const __m256d dz0   = _mm256_set1_pd(z - z0);
+                const __m256d dz1   = _mm256_set1_pd(z - (z0 + 1));
+                const auto z_hash0  = kZNoiseGen * static_cast<uint32_t>(z0) + kSeedNoiseGen * seed;
+                const auto z_hash1  = z_hash0 + kZNoiseGen;
+                const __m256d scale = _mm256_set1_pd(persistence);
+
+                for (int i = 0; i < kWidth; i += 4) {
+                    const __m256d nx = _mm256_load_pd(x + i);
+
+                    // Truncate, then one lower if at or below 0
+                    __m256d x0 = _mm256_round_pd(nx, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    x0         = _mm256_sub_pd(x0, _mm256_and_pd(_mm256_cmp_pd(nx, zero, _CMP_LE_OQ), one));
+
+                    const __m256d dx0 = _mm256_sub_pd(nx, x0);
+                    const __m256d dx1 = _mm256_sub_pd(nx, _mm256_add_pd(x0, one));
+                    const __m256d xs =
+                        _mm256_mul_pd(_mm256_mul_pd(dx0, dx0), _mm256_sub_pd(three, _mm256_mul_pd(two, dx0)));
+
+                    const __m128i x_hash0 = _mm_mullo_epi32(_mm256_cvttpd_epi32(x0), x_gen);
+                    const __m128i x_hash1 = _mm_add_epi32(x_hash0, x_gen);
+
+                    const __m256d ix0 = LinearInterpAvx2(GradientNoiseAvx2(table, x_hash0, z_hash0, dx0, dz0),
+                                                         GradientNoiseAvx2(table, x_hash1, z_hash0, dx1, dz0),
+                                                         xs);
+                    const __m256d ix1 = LinearInterpAvx2(GradientNoiseAvx2(table, x_hash0, z_hash1, dx0, dz1),
+                                                         GradientNoiseAvx2(table, x_hash1, z_hash1, dx1, dz1),
+                                                         xs);
+
+                    const __m256d signal = LinearInterpAvx2(ix0, ix1, zs);
+                    _mm256_store_pd(value + i, _mm256_add_pd(_mm256_load_pd(value + i), _mm256_mul_pd(signal, scale)));
+                    _mm256_store_pd(x + i, _mm256_mul_pd(nx, lacunarity));
+                }
+
+                z *= kLacunarity;
+                persistence *= params.persistence;
+            }
+
+            for (int i = 0; i < kWidth; i += 4) {
+                _mm_storeu_ps(noise_map.data() + row * kWidth + i, _mm256_cvtpd_ps(_mm256_load_pd(value + i)));
+            }
+        }
+    }
+
+#endif
+
+    // ======================================================================
+
+    void ChunkNoiseLibnoise(const game::PerlinParams& params,
+                            const ChunkCoord& c_coord,
+                            game::ChunkNoiseMap& noise_map) {
+        // The Y axis for libnoise is inverted. It causes no issues as of right now. I am leaving this here
+        // In case something happens in the future
+
+        noise::module::Perlin noise_module;
+        noise_module.SetSeed(params.seed);
+        noise_module.SetOctaveCount(params.octaveCount);
+        noise_module.SetFrequency(params.frequency);
+        noise_module.SetPersistence(params.persistence);
+
+        noise::utils::NoiseMap height_map;
+        noise::utils::NoiseMapBuilderPlane height_map_builder;
+        height_map_builder.SetSourceModule(noise_module);
+        height_map_builder.SetDestNoiseMap(height_map);
+        height_map_builder.SetDestSize(kWidth, kWidth);
+
+        // Since x, y represents the center of the chunk, +- 0.5 to get the edges
+        height_map_builder.SetBounds(c_coord.x - 0.5, c_coord.x + 0.5, c_coord.y - 0.5, c_coord.y + 0.5);
+        height_map_builder.Build();
+
+        for (int y = 0; y < kWidth; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                noise_map[y * kWidth + x] = height_map.GetValue(x, y);
+            }
+        }
+    }
+
+    bool CpuSupports(const game::NoiseKernel kernel) noexcept {
+#if defined(JACTORIO_NOISE_X86)
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int max_leaf = info[0];
+
+        __cpuid(info, 1);
+        if (kernel == game::NoiseKernel::sse2)
+            return (info[3] & (1 << 26)) != 0;
+
+        // The OS must also save the AVX registers
+        const bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        if (!avx || max_leaf < 7)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        if (kernel == game::NoiseKernel::sse2)
+            return __builtin_cpu_supports("sse2");
+        return __builtin_cpu_supports("avx2");
+#endif
+#else
+        return false;
+#endif
+    }
+
+    game::NoiseKernel FastestKernel() noexcept {
+        if (CpuSupports(game::NoiseKernel::avx2))
+            return game::NoiseKernel::avx2;
+        if (CpuSupports(game::NoiseKernel::sse2))
+            return game::NoiseKernel::sse2;
+        return game::NoiseKernel::scalar;
+    }
+
+    std::atomic<game::NoiseKernel> active_kernel{FastestKernel()};
+} // namespace
+
+
+bool game::NoiseKernelSupported(const NoiseKernel kernel) noexcept {
+    switch (kernel) {
+    case NoiseKernel::libnoise:
+    case NoiseKernel::scalar:
+        return true;
+    case NoiseKernel::sse2:
+    case NoiseKernel::avx2:
+        return CpuSupports(kernel);
+
+    default:
+        return false;
+    }
+}
+
+game::NoiseKernel game::GetNoiseKernel() noexcept {
+    return active_kernel.load(std::memory_order_relaxed);
+}
+
+bool game::SetNoiseKernel(const NoiseKernel kernel) noexcept {
+    if (!NoiseKernelSupported(kernel))
+        return false;
+
+    active_kernel.store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+void game::GenerateChunkNoise(const PerlinParams& params, const ChunkCoord& c_coord, ChunkNoiseMap& noise_map) {
+    GenerateChunkNoise(GetNoiseKernel(), params, c_coord, noise_map);
+}
+
+void game::GenerateChunkNoise(NoiseKernel kernel,
+                              const PerlinParams& params,
+                              const ChunkCoord& c_coord,
+                              ChunkNoiseMap& noise_map) {
+    assert(NoiseKernelSupported(kernel));
+
+    if (kernel == NoiseKernel::libnoise) {
+        ChunkNoiseLibnoise(params, c_coord, noise_map);
+        return;
+    }
+
+    const auto& table   = GetGradientTable();
+    const auto samples = GetChunkSamples(c_coord);
+
+    if (ExceedsInt32Range(params, samples)) {
+        kernel = NoiseKernel::scalar;
+    }
+
+    switch (kernel) {
+#if defined(JACTORIO_NOISE_X86)
+    case NoiseKernel::sse2:
+        ChunkNoiseSse2(table, params, samples, noise_map);
+        break;
+    case NoiseKernel::avx2:
+        ChunkNoiseAvx2(table, params, samples, noise_map);
+        break;
+#endif
+
+    default:
+        ChunkNoiseScalar(table, params, samples, noise_map);
+        break;
+    }
+}
@@ -3,27 +3,31 @@
 #include "game/world/world.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <future>
-#include <noise/noise.h>
-#include <noise/noiseutils.h>
-#include <set>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 
+#include <cereal/archives/portable_binary.hpp>
+
+#include "core/thread_pool.h"
+#include "game/logic/conveyor_active_set.h"
+#include "game/world/perlin_noise.h"
 #include "proto/noise_layer.h"
 #include "proto/sprite.h"
 #include "render/tile_renderer.h"
 
 using namespace jactorio;
 
-ChunkCoordAxis game::World::WorldCToChunkC(WorldCoordAxis coord) {
-    ChunkCoordAxis chunk_coord = 0;
-
-    if (coord < 0) {
-        chunk_coord -= 1;
-        coord += 1;
-    }
+game::World::World()
+    : uniqueDataPool_(std::make_unique<proto::UniqueDataPool>()),
+      constDecoded_(std::make_unique<ConstDecodedChunks>()),
+      conveyorActiveSet_(std::make_shared<ConveyorActiveSet>()) {}
 
-    chunk_coord += LossyCast<ChunkCoordAxis>(LossyCast<float>(coord) / Chunk::kChunkWidth);
-    return chunk_coord;
+game::World::~World() {
+    DiscardPendingChunks();
 }
 
 ChunkCoord game::World::WorldCToChunkC(const WorldCoord& coord) {
@@ -60,43 +64,80 @@ Position2<OverlayOffsetAxis> game::World::WorldCToOverlayC(const WorldCoord& coo
 // ======================================================================
 
 void game::World::DeleteChunk(const ChunkCoord& c_coord) {
-    worldChunks_.erase(std::make_tuple(c_coord.x, c_coord.y));
-
-    auto [tex_ids, readable_chunks] = GetChunkTexCoordIds(c_coord);
-    if (readable_chunks > 0) {
-        for (std::size_t i = 0; i < SafeCast<std::size_t>(Chunk::kChunkArea) * kTileLayerCount; ++i) {
-            tex_ids[i] = 0;
-        }
+    const bool erased_encoded = encodedChunks_.count({c_coord.x, c_coord.y}) > 0;
+    EraseEncodedChunk(c_coord);
+    if (worldChunks_.Erase(c_coord) || erased_encoded) {
+        deletedChunks_.push_back(c_coord);
     }
 }
 
 void game::World::Clear() {
-    worldChunks_.clear();
-    chunkTexCoordIds_.clear();
+    DiscardPendingChunks();
+
+    worldChunks_.ForEach([this](const Chunk& chunk) { deletedChunks_.push_back(chunk.GetPosition()); });
+    worldChunks_.Clear();
+    for (const auto& [key, buffer] : encodedChunks_) {
+        deletedChunks_.push_back({std::get<0>(key), std::get<1>(key)});
+    }
+    encodedChunks_.clear();
+    constDecoded_->chunks.clear();
     for (auto& list : logicLists_) {
         list.clear();
     }
-    worldGenChunks_.clear();
+    for (auto& index : logicIndices_) {
+        index.clear();
+    }
+    conveyorActiveSet_->stale = true;
+    worldGenQueue_.Clear();
+
+    // Unique data of the world was destroyed with its chunks
+    uniqueDataPool_->Release();
 }
 
 // ======================================================================
 
 game::Chunk* game::World::GetChunkC(const ChunkCoord& c_coord) {
-    return const_cast<Chunk*>(static_cast<const World*>(this)->GetChunkC(c_coord));
+    auto* chunk = worldChunks_.Find(c_coord);
+    if (chunk != nullptr || encodedChunks_.empty())
+        return chunk;
+
+    const auto encoded = encodedChunks_.find({c_coord.x, c_coord.y});
+    if (encoded == encodedChunks_.end())
+        return nullptr;
+
+    return &worldChunks_.Insert(c_coord, TakeEncodedChunk(encoded));
 }
 
 const game::Chunk* game::World::GetChunkC(const ChunkCoord& c_coord) const {
-    const auto key = std::tuple<int, int>{c_coord.x, c_coord.y};
+    const auto* chunk = worldChunks_.Find(c_coord);
+    if (chunk != nullptr || encodedChunks_.empty())
+        return chunk;
 
-    if (worldChunks_.find(key) == worldChunks_.end())
+    const auto encoded = encodedChunks_.find({c_coord.x, c_coord.y});
+    if (encoded == encodedChunks_.end())
         return nullptr;
 
-    return &worldChunks_.at(key);
-}
+    auto& decoded = *constDecoded_;
+    {
+        std::shared_lock<std::shared_mutex> guard(decoded.mutex);
+
+        const auto found = decoded.chunks.find(encoded->first);
+        if (found != decoded.chunks.end())
+            return found->second.get();
+    }
+
+    std::lock_guard<std::shared_mutex> guard(decoded.mutex);
 
+    auto& decoded_chunk = decoded.chunks[encoded->first];
+    if (decoded_chunk == nullptr) { // Not decoded by another lookup while unlocked
+        decoded_chunk = DecodeChunk(*encoded->second, *uniqueDataPool_);
+        decoded_chunk->MarkSaved();
+    }
+    return decoded_chunk.get();
+}
 
 game::Chunk* game::World::GetChunkW(const WorldCoord& coord) {
-    return const_cast<Chunk*>(static_cast<const World*>(this)->GetChunkW(coord));
+    return GetChunkC(WorldCToChunkC(coord));
 }
 
 const game::Chunk* game::World::GetChunkW(const WorldCoord& coord) const {
@@ -106,7 +147,13 @@ const game::Chunk* game::World::GetChunkW(const WorldCoord& coord) const {
 // ======================================================================
 
 game::ChunkTile* game::World::GetTile(const WorldCoord& coord, const TileLayer tlayer) {
-    return const_cast<ChunkTile*>(static_cast<const World*>(this)->GetTile(coord, tlayer));
+    auto* chunk = GetChunkW(coord);
+
+    if (chunk != nullptr) {
+        return &chunk->GetCTile(Chunk::WorldCToChunkTileC(coord), tlayer);
+    }
+
+    return nullptr;
 }
 const game::ChunkTile* game::World::GetTile(const WorldCoord& coord, const TileLayer tlayer) const {
     const auto* chunk = GetChunkC(WorldCToChunkC(coord));
@@ -118,45 +165,43 @@ const game::ChunkTile* game::World::GetTile(const WorldCoord& coord, const TileL
     return nullptr;
 }
 
-std::pair<SpriteTexCoordIndexT*, int> game::World::GetChunkTexCoordIds(const ChunkCoord& c_coord) noexcept {
-    const auto pair = const_cast<const World*>(this)->GetChunkTexCoordIds(c_coord);
-    return {const_cast<SpriteTexCoordIndexT*>(pair.first), pair.second};
-}
+ResourceEntityResourceCount* game::World::GetResourceAmount(const WorldCoord& coord) noexcept {
+    auto* chunk = GetChunkW(coord);
+    if (chunk == nullptr)
+        return nullptr;
 
+    return &chunk->GetResourceAmount(Chunk::WorldCToChunkTileC(coord));
+}
+const ResourceEntityResourceCount* game::World::GetResourceAmount(const WorldCoord& coord) const noexcept {
+    const auto* chunk = GetChunkW(coord);
+    if (chunk == nullptr)
+        return nullptr;
 
-std::pair<const SpriteTexCoordIndexT*, int> game::World::GetChunkTexCoordIds(const ChunkCoord& c_coord) const noexcept {
-    const auto& x_dvector = chunkTexCoordIds_[c_coord.y];
+    return &chunk->GetResourceAmount(Chunk::WorldCToChunkTileC(coord));
+}
 
-    // Check y dvector in range
-    if (-c_coord.y > SafeCast<ChunkCoordAxis>(chunkTexCoordIds_.size_front()) ||
-        c_coord.y >= SafeCast<ChunkCoordAxis>(chunkTexCoordIds_.size_back())) {
-        return {nullptr, 0};
-    }
+SpriteTexCoordIndexT* game::World::GetChunkTexCoordIds(const ChunkCoord& c_coord) noexcept {
+    auto* chunk = GetChunkC(c_coord);
+    if (chunk == nullptr)
+        return nullptr;
 
-    const auto size_front = SafeCast<ChunkCoordAxis>(x_dvector.size_front());
-    const auto size_back  = SafeCast<ChunkCoordAxis>(x_dvector.size_back());
+    return chunk->TexCoordIds().data();
+}
 
-    int readable_amount = 0;
-    // Check x dvector in range
-    if (c_coord.x < 0) {
-        if (-c_coord.x <= size_front) {
-            readable_amount = -c_coord.x + size_back;
-        }
-    }
-    else if (c_coord.x >= 0) {
-        if (c_coord.x < size_back) {
-            readable_amount = size_back - c_coord.x;
-        }
-    }
+const SpriteTexCoordIndexT* game::World::GetChunkTexCoordIds(const ChunkCoord& c_coord) const noexcept {
+    const auto* chunk = GetChunkC(c_coord);
+    if (chunk == nullptr)
+        return nullptr;
 
-    return {x_dvector[c_coord.x].data(), readable_amount};
+    return chunk->TexCoordIds().data();
 }
 
 SpriteTexCoordIndexT game::World::GetTexCoordId(const WorldCoord& coord, const TileLayer layer) const noexcept {
-    const auto c_coord  = WorldCToChunkC(coord);
-    const auto ct_coord = Chunk::WorldCToChunkTileC(coord);
-    return chunkTexCoordIds_[c_coord.y][c_coord.x][(ct_coord.y * Chunk::kChunkWidth + ct_coord.x) * kTileLayerCount +
-                                                   static_cast<int>(layer)];
+    const auto* chunk = GetChunkW(coord);
+    if (chunk == nullptr)
+        return 0;
+
+    return chunk->TexCoordIds()[Chunk::GetTexCoordIndex(Chunk::WorldCToChunkTileC(coord), layer)];
 }
 
 void game::World::SetTexCoordId(const WorldCoord& coord,
@@ -169,8 +214,11 @@ void game::World::SetTexCoordId(const ChunkCoord& c_coord,
                                 const ChunkTileCoord& ct_coord,
                                 TileLayer layer,
                                 const SpriteTexCoordIndexT id) noexcept {
-    chunkTexCoordIds_[c_coord.y][c_coord.x]
-                     [(ct_coord.y * Chunk::kChunkWidth + ct_coord.x) * kTileLayerCount + static_cast<int>(layer)] = id;
+    auto* chunk = GetChunkC(c_coord);
+    assert(chunk != nullptr);
+
+    chunk->TexCoordIds()[Chunk::GetTexCoordIndex(ct_coord, layer)] = id;
+    chunk->MarkDirty();
 }
 
 void game::World::EnableAnimation(const WorldCoord& coord, const TileLayer tlayer) noexcept {
@@ -228,23 +276,17 @@ void game::World::DisableAnimation(WorldCoord coord,
 // Placement
 
 bool game::World::PlaceLocationValid(const WorldCoord& coord, const Dimension dimensions) const {
-    for (int offset_y = 0; offset_y < dimensions.y; ++offset_y) {
-        for (int offset_x = 0; offset_x < dimensions.x; ++offset_x) {
-
-            const WorldCoord i_coord(coord.x + offset_x, coord.y + offset_y);
-
+    return VisitTilesInRect(
+        *this, coord, dimensions, [](const WorldCoord& /*i_coord*/, const Chunk* chunk, const std::size_t tile_index) {
             // If the tile proto does not exist, or base tile prototype is water, NOT VALID placement
-
-            const auto* tile_proto   = GetTile(i_coord, TileLayer::base)->GetPrototype<proto::Tile>();
-            const auto* entity_proto = GetTile(i_coord, TileLayer::entity)->GetPrototype<proto::Entity>();
-
-            if (entity_proto != nullptr || tile_proto == nullptr || tile_proto->isWater) {
+            if (chunk == nullptr)
                 return false;
-            }
-        }
-    }
 
-    return true;
+            const auto* tile_proto   = chunk->Tiles(TileLayer::base)[tile_index].GetPrototype<proto::Tile>();
+            const auto* entity_proto = chunk->Tiles(TileLayer::entity)[tile_index].GetPrototype<proto::Entity>();
+
+            return entity_proto == nullptr && tile_proto != nullptr && !tile_proto->isWater;
+        });
 }
 
 bool game::World::Place(const WorldCoord& coord, const Orientation orien, const proto::Entity& entity) {
@@ -267,24 +309,17 @@ bool game::World::Place(const WorldCoord& coord, const Orientation orien, const
     if (dimension.x != 1 || dimension.y != 1) {
         // Multi tile
 
-        int entity_index = 1;
-        int offset_x     = 1;
-
-        for (int offset_y = 0; offset_y < dimension.y; ++offset_y) {
-            for (; offset_x < dimension.x; ++offset_x) {
-                const auto current_coord = WorldCoord(coord.x + offset_x, coord.y + offset_y);
-
-                auto* tile = GetTile(current_coord, place_layer);
-                assert(tile != nullptr);
+        int entity_index = 0;
+        ForEachTileInRect(coord, dimension, place_layer, [&](const WorldCoord& current_coord, ChunkTile& tile) {
+            // The top left is handled above
+            if (entity_index++ == 0)
+                return;
 
-                tile->SetPrototype(orien, entity);
-                tile->SetupMultiTile(entity_index++, *provided_tile);
+            tile.SetPrototype(orien, entity);
+            tile.SetupMultiTile(entity_index - 1, *provided_tile);
 
-                // entity_index - 1 has the same effect as adding 1 each iteration, starting with adding 1
-                SetTexCoordId(current_coord, place_layer, base_tex_coord_id + entity_index - 1);
-            }
-            offset_x = 0;
-        }
+            SetTexCoordId(current_coord, place_layer, base_tex_coord_id + entity_index - 1);
+        });
     }
 
     return true;
@@ -304,17 +339,11 @@ bool game::World::Remove(const WorldCoord& coord, const Orientation orien) {
     // Remove starting from top left corner
     const auto tl_coord = coord.Incremented(*provided_tile);
 
-    for (int offset_y = 0; offset_y < t_entity->GetHeight(orien); ++offset_y) {
-        for (int offset_x = 0; offset_x < t_entity->GetWidth(orien); ++offset_x) {
-            const auto current_coord = WorldCoord(tl_coord.x + offset_x, tl_coord.y + offset_y);
-
-            auto* tile = GetTile(current_coord, remove_layer);
-            assert(tile != nullptr);
-
-            tile->Clear();
+    ForEachTileInRect(
+        tl_coord, t_entity->GetDimension(orien), remove_layer, [&](const WorldCoord& current_coord, ChunkTile& tile) {
+            tile.Clear();
             SetTexCoordId(current_coord, remove_layer, 0);
-        }
-    }
+        });
 
     return true;
 }
@@ -326,32 +355,47 @@ bool game::World::Remove(const WorldCoord& coord, const Orientation orien) {
 void game::World::LogicRegister(const LogicGroup group, const WorldCoord& coord, const TileLayer tlayer) {
     assert(group != LogicGroup::count_);
     assert(tlayer != TileLayer::count_);
-    auto& list = logicLists_[static_cast<int>(group)];
+    auto& list  = logicLists_[static_cast<int>(group)];
+    auto& index = logicIndices_[static_cast<int>(group)];
 
     // Do not add if already added, ignoring prototype/unique data
-    for (auto& object : list) {
-        if (object.coord == coord) {
-            return;
-        }
-    }
+    const auto [it, inserted] = index.try_emplace({coord.x, coord.y}, list.size());
+    if (!inserted)
+        return;
 
     auto* tile = GetTile(coord, tlayer);
     assert(tile != nullptr);
 
     list.push_back({tile->GetPrototype(), tile->GetUniqueData(), coord});
+
+    if (group == LogicGroup::conveyor) {
+        conveyorActiveSet_->changed.push_back(list.size() - 1);
+    }
 }
 
 void game::World::LogicRemove(const LogicGroup group, const WorldCoord& coord, const TileLayer tlayer) {
     assert(group != LogicGroup::count_);
     assert(tlayer != TileLayer::count_);
-    auto& list = logicLists_[static_cast<int>(group)];
+    auto& list  = logicLists_[static_cast<int>(group)];
+    auto& index = logicIndices_[static_cast<int>(group)];
 
-    for (std::size_t i = 0; i < list.size(); ++i) {
-        auto& object = list[i];
-        if (object.coord == coord) {
-            list.erase(list.begin() + i);
-            return;
-        }
+    const auto it = index.find({coord.x, coord.y});
+    if (it == index.end())
+        return;
+
+    const auto i = it->second;
+    index.erase(it);
+
+    // Fill the gap with the last object
+    if (i != list.size() - 1) {
+        list[i]                                   = std::move(list.back());
+        index[{list[i].coord.x, list[i].coord.y}] = i;
+    }
+    list.pop_back();
+
+    if (group == LogicGroup::conveyor) {
+        // Slot now holds the moved conveyor, or is past the end if the last conveyor was removed
+        conveyorActiveSet_->changed.push_back(i);
     }
 }
 
@@ -363,111 +407,80 @@ const game::World::LogicListT& game::World::LogicGet(const LogicGroup group) con
     return logicLists_[static_cast<int>(group)];
 }
 
-// ======================================================================
+void game::World::LogicRebuildIndex() {
+    for (std::size_t group = 0; group < logicLists_.size(); ++group) {
+        const auto& list = logicLists_[group];
+        auto& index      = logicIndices_[group];
 
-// T is value stored in noise_layer at data_category
-template <typename T>
-void GenerateChunk(game::World& world,
-                   const data::PrototypeManager& proto,
-                   const ChunkCoord& chunk_coord,
-                   const proto::Category data_category,
-                   void (*func)(game::World& l_world,
-                                game::Chunk& chunk,
-                                ChunkTileCoord ct_coord,
-                                const T* prototype,
-                                const proto::NoiseLayer<T>& noise_layer,
-                                float noise_val)) {
-
-    // The Y axis for libnoise is inverted. It causes no issues as of right now. I am leaving this here
-    // In case something happens in the future
-
-    // Get all TILE noise layers for building terrain
-    auto noise_layers = proto.GetAll<proto::NoiseLayer<T>>(data_category);
-
-    // Sort Noise layers, the one with the highest order takes priority if tiles overlap
-    std::sort(
-        noise_layers.begin(), noise_layers.end(), [](auto* left, auto* right) { return left->order < right->order; });
-
-
-    auto* chunk = world.GetChunkC(chunk_coord);
-
-    // Allocate new tiles if chunk has not been generated yet
-    if (chunk == nullptr) {
-        chunk = &world.EmplaceChunk(chunk_coord);
+        index.clear();
+        index.reserve(list.size());
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            index.emplace(LogicKey{list[i].coord.x, list[i].coord.y}, i);
+        }
     }
+}
 
-    int seed_offset = 0; // Incremented every time a noise layer generates to keep terrain unique
-    for (const auto* noise_layer : noise_layers) {
-        module::Perlin base_terrain_noise_module;
-        base_terrain_noise_module.SetSeed(world.GetWorldGeneratorSeed() + seed_offset++);
-
-        // Load properties of each noise layer
-        base_terrain_noise_module.SetOctaveCount(noise_layer->octaveCount);
-        base_terrain_noise_module.SetFrequency(noise_layer->frequency);
-        base_terrain_noise_module.SetPersistence(noise_layer->persistence);
-
-        utils::NoiseMap base_terrain_height_map;
-        utils::NoiseMapBuilderPlane height_map_builder;
-        height_map_builder.SetSourceModule(base_terrain_noise_module);
-        height_map_builder.SetDestNoiseMap(base_terrain_height_map);
-        height_map_builder.SetDestSize(game::Chunk::kChunkWidth, game::Chunk::kChunkWidth);
+// ======================================================================
 
-        // Since x, y represents the center of the chunk, +- 0.5 to get the edges
-        height_map_builder.SetBounds(
-            chunk_coord.x - 0.5, chunk_coord.x + 0.5, chunk_coord.y - 0.5, chunk_coord.y + 0.5);
-        height_map_builder.Build();
+/// \param func Called with (game::Chunk& chunk, ChunkTileCoord ct_coord, const WorldGenPlan::Layer<T>& layer,
+/// int range, float noise_val) for each tile of each layer, range is -1 if noise_val is not within a range of layer
+template <typename T, typename TFunc>
+void GenerateChunkLayers(const std::vector<game::WorldGenPlan::Layer<T>>& layers, game::Chunk& chunk, TFunc&& func) {
+    const auto chunk_coord = chunk.GetPosition();
 
+    game::ChunkNoiseMap noise_map;
+    for (const auto& layer : layers) {
+        game::GenerateChunkNoise(layer.params, chunk_coord, noise_map);
 
         // Transfer noise values from height map to chunk tiles
         for (ChunkTileCoordAxis y = 0; y < game::Chunk::kChunkWidth; ++y) {
             for (ChunkTileCoordAxis x = 0; x < game::Chunk::kChunkWidth; ++x) {
-                float noise_val = base_terrain_height_map.GetValue(x, y);
-                auto* prototype = noise_layer->Get(noise_val);
-
-                assert(chunk != nullptr);
-                assert(noise_layer != nullptr);
-
-                func(world, *chunk, {x, y}, prototype, *noise_layer, noise_val);
+                const float noise_val = noise_map[y * game::Chunk::kChunkWidth + x];
+                func(chunk, ChunkTileCoord{x, y}, layer, layer.FindRange(noise_val), noise_val);
             }
         }
     }
 }
 
-/// Generates a chunk and adds it to the world when done
-/// Call this with a std::thread to to this in async
-void Generate(game::World& world, const data::PrototypeManager& proto, const int chunk_x, const int chunk_y) {
+void game::World::GenerateChunk(const WorldGenPlan& plan, const ChunkCoord& c_coord, GeneratedChunk& generated) {
+    generated.chunk = std::make_unique<Chunk>(c_coord);
+
+    auto& tex_coord_ids   = generated.chunk->TexCoordIds();
+    auto set_tex_coord_id = [&tex_coord_ids](const ChunkTileCoord& ct_coord, TileLayer layer, SpriteTexCoordIndexT id) {
+        tex_coord_ids[Chunk::GetTexCoordIndex(ct_coord, layer)] = id;
+    };
+
     // Base
-    GenerateChunk<proto::Tile>(
-        world,
-        proto,
-        {chunk_x, chunk_y},
-        proto::Category::noise_layer_tile,
-        [](auto& l_world,
-           auto& chunk,
-           auto ct_coord,
-           const auto* prototype,
-           const auto& /*noise_layer*/,
-           float /*noise_val*/) {
+    GenerateChunkLayers(
+        plan.GetTileLayers(),
+        *generated.chunk,
+        [&](auto& chunk, auto ct_coord, const auto& layer, const int range, float /*noise_val*/) {
+            if (range < 0)
+                return;
+
+            const auto* prototype = layer.prototypes[range];
             if (prototype == nullptr)
                 return;
 
-            auto& tile = chunk.GetCTile(ct_coord, game::TileLayer::base);
+            auto& tile = chunk.GetCTile(ct_coord, TileLayer::base);
             tile.SetPrototype(Orientation::up, prototype);
-            l_world.SetTexCoordId(chunk.GetPosition(), ct_coord, game::TileLayer::base, prototype->sprite->texCoordId);
+            set_tex_coord_id(ct_coord, TileLayer::base, layer.texCoordIds[range]);
         });
 
     // Resources
-    GenerateChunk<proto::Entity>(
-        world,
-        proto,
-        {chunk_x, chunk_y},
-        proto::Category::noise_layer_entity,
-        [](auto& l_world, auto& chunk, auto ct_coord, auto* prototype, const auto& noise_layer, float noise_val) {
+    GenerateChunkLayers(
+        plan.GetEntityLayers(),
+        *generated.chunk,
+        [&](auto& chunk, auto ct_coord, const auto& layer, const int range, float noise_val) {
+            if (range < 0)
+                return;
+
+            const auto* prototype = layer.prototypes[range];
             if (prototype == nullptr)
                 return;
 
-            auto& tile_base     = chunk.GetCTile(ct_coord, game::TileLayer::base);
-            auto& tile_resource = chunk.GetCTile(ct_coord, game::TileLayer::resource);
+            auto& tile_base     = chunk.GetCTile(ct_coord, TileLayer::base);
+            auto& tile_resource = chunk.GetCTile(ct_coord, TileLayer::resource);
 
             // Do not place resources on water since they cannot be mined by entities
             const auto* base_proto = tile_base.template GetPrototype<proto::Tile>();
@@ -480,92 +493,465 @@ void Generate(game::World& world, const data::PrototypeManager& proto, const int
 
 
             // For resource amount, scale noise value up by richness
-            const auto noise_range = noise_layer.GetValNoiseRange(noise_val);
-            const auto noise_min   = noise_range.first;
-            const auto noise_max   = noise_range.second;
+            const auto noise_min = layer.ranges[range];
+            const auto noise_max = layer.ranges[range + 1];
             auto resource_amount =
-                LossyCast<uint16_t>((noise_val - noise_min) * noise_layer.richness / (noise_max - noise_min));
+                LossyCast<uint16_t>((noise_val - noise_min) * layer.noiseLayer->richness / (noise_max - noise_min));
 
             if (resource_amount <= 0)
                 resource_amount = 1;
 
             // Place new resource
             tile_resource.SetPrototype(Orientation::up, prototype);
-            l_world.SetTexCoordId(
-                chunk.GetPosition(), ct_coord, game::TileLayer::resource, prototype->sprite->texCoordId);
+            set_tex_coord_id(ct_coord, TileLayer::resource, layer.texCoordIds[range]);
 
             assert(resource_amount > 0);
-            tile_resource.template MakeUniqueData<proto::ResourceEntityData>(resource_amount);
+            chunk.GetResourceAmount(ct_coord) = resource_amount;
         });
 }
 
+const std::shared_ptr<const game::WorldGenPlan>& game::World::GetGenerationPlan(const data::PrototypeManager& proto) {
+    if (worldGenPlan_ == nullptr || !worldGenPlan_->IsBuiltFrom(proto, worldGenSeed_)) {
+        worldGenPlan_ = std::make_shared<const WorldGenPlan>(proto, worldGenSeed_);
+    }
+    return worldGenPlan_;
+}
+
+void game::World::CommitGeneratedChunk(GeneratedChunk& generated) {
+    assert(generated.chunk != nullptr);
+    const auto c_coord = generated.chunk->GetPosition();
+
+    if (worldChunks_.Find(c_coord) != nullptr)
+        return;
+
+    const auto encoded = encodedChunks_.find({c_coord.x, c_coord.y});
+    if (generated.decoded) {
+        // Deleted or replaced while decoding
+        if (encoded == encodedChunks_.end())
+            return;
+
+        // Chunk a const lookup decoded meanwhile is kept, pointers to it were handed out
+        if (constDecoded_->chunks.count(encoded->first) > 0) {
+            worldChunks_.Insert(c_coord, TakeEncodedChunk(encoded));
+            return;
+        }
+
+        encodedChunks_.erase(encoded);
+        generated.chunk->MarkSaved();
+    }
+    else if (encoded != encodedChunks_.end()) {
+        return; // Chunk from save is decoded instead
+    }
+
+    worldChunks_.Insert(c_coord, std::move(generated.chunk));
+}
+
+void game::World::SubmitQueuedChunks(ThreadPool& pool, const data::PrototypeManager& proto) {
+    auto is_pending = [this](const ChunkCoord& c_coord) {
+        return std::any_of(worldGenPending_.begin(), worldGenPending_.end(), [&c_coord](const auto& pending) {
+            return pending.coord == c_coord;
+        });
+    };
+
+    // Few chunks are submitted at a time so chunks queued later, but nearer to focus, are generated first
+    const auto max_pending = std::max<std::size_t>(pool.GetThreadCount(), 1) * 2;
+
+    ChunkCoord c_coord;
+    while (worldGenPending_.size() < max_pending && worldGenQueue_.Pop(c_coord)) {
+        if (worldChunks_.Find(c_coord) != nullptr || is_pending(c_coord))
+            continue;
+
+        auto generated = std::make_shared<GeneratedChunk>();
+        std::future<void> done;
+
+        // Chunks left encoded when loading are decoded rather than generated
+        const auto encoded = encodedChunks_.find({c_coord.x, c_coord.y});
+        if (encoded != encodedChunks_.end() && constDecoded_->chunks.count(encoded->first) > 0) {
+            worldChunks_.Insert(c_coord, TakeEncodedChunk(encoded)); // Already decoded by a const lookup
+            continue;
+        }
+        if (encoded != encodedChunks_.end()) {
+            generated->decoded = true;
+            done = pool.Submit([buffer = encoded->second, generated, unique_pool = uniqueDataPool_.get()]() {
+                generated->chunk = DecodeChunk(*buffer, *unique_pool);
+            });
+        }
+        else {
+            done = pool.Submit([plan = GetGenerationPlan(proto), c_coord, generated]() {
+                GenerateChunk(*plan, c_coord, *generated);
+            });
+        }
+
+        worldGenPending_.push_back({c_coord, std::move(generated), std::move(done)});
+    }
+}
+
+void game::World::DiscardPendingChunks() noexcept {
+    // Generating chunks hold a reference to the prototype manager
+    for (auto& pending : worldGenPending_) {
+        if (pending.done.valid()) {
+            pending.done.wait();
+        }
+    }
+    worldGenPending_.clear();
+}
+
+void game::World::LoadLegacyTexCoordIds(const DVector<DVector<Chunk::TexCoordIdArrayT>>& tex_coord_ids) {
+    /// \return true if dvector has an element at coord_axis
+    auto in_range = [](const auto& dvector, const ChunkCoordAxis coord_axis) {
+        if (coord_axis < 0)
+            return SafeCast<std::size_t>(-static_cast<int64_t>(coord_axis)) <= dvector.size_front();
+        return SafeCast<std::size_t>(coord_axis) < dvector.size_back();
+    };
+
+    worldChunks_.ForEach([&](Chunk& chunk) {
+        const auto c_coord = chunk.GetPosition();
+        if (!in_range(tex_coord_ids, c_coord.y))
+            return;
+
+        const auto& x_dvector = tex_coord_ids[c_coord.y];
+        if (!in_range(x_dvector, c_coord.x))
+            return;
+
+        chunk.TexCoordIds() = x_dvector[c_coord.x];
+    });
+}
+
 
 void game::World::QueueChunkGeneration(const ChunkCoord& c_coord) const {
     // NO need to regenerate existing chunks
     if (GetChunkC(c_coord) == nullptr) {
-        // .find is not needed to check for duplicates as insert already does that
-        worldGenChunks_.insert({c_coord.x, c_coord.y});
+        worldGenQueue_.Push(c_coord);
     }
 }
 
+void game::World::SetGenerationFocus(std::vector<ChunkCoord> focus) {
+    worldGenQueue_.SetFocus(std::move(focus));
+}
+
 void game::World::GenChunk(const data::PrototypeManager& proto, uint8_t amount) {
     assert(amount > 0);
 
-    // https://stackoverflow.com/questions/8234779/how-to-remove-from-a-map-while-iterating-it
+    ChunkCoord c_coord;
+    while (worldGenQueue_.Pop(c_coord)) {
+        if (GetChunkC(c_coord) != nullptr)
+            continue;
+
+        GeneratedChunk generated;
+        GenerateChunk(*GetGenerationPlan(proto), c_coord, generated);
+        CommitGeneratedChunk(generated);
+
+        if (--amount == 0)
+            break;
+    }
+}
 
-    for (auto it = worldGenChunks_.cbegin(); it != worldGenChunks_.cend() /* not hoisted */; /* no increment */) {
-        const auto& coords = *it;
+void game::World::GenChunk(ThreadPool& pool,
+                           const data::PrototypeManager& proto,
+                           const std::chrono::microseconds budget) {
+    const auto start_time = std::chrono::steady_clock::now();
 
-        assert(worldGenChunks_.count(coords) == 1);
-        Generate(*this, proto, std::get<0>(coords), std::get<1>(coords));
+    // Finished chunks are added in the order submitted, which is nearest to focus first
+    while (!worldGenPending_.empty() &&
+           worldGenPending_.front().done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto pending = std::move(worldGenPending_.front());
+        worldGenPending_.pop_front();
 
-        worldGenChunks_.erase(it++);
+        pending.done.get();
+        CommitGeneratedChunk(*pending.generated);
 
-        if (--amount == 0)
+        if (std::chrono::steady_clock::now() - start_time >= budget)
             break;
     }
+
+    SubmitQueuedChunks(pool, proto);
 }
 
+void game::World::GenChunkAll(ThreadPool& pool, const data::PrototypeManager& proto) {
+    SubmitQueuedChunks(pool, proto);
 
-void game::World::DeserializePostProcess() {
-    auto iterate_world_chunks =
-        [&](const std::function<void(const WorldCoord& coord, ChunkTile& tile, TileLayer tlayer)>& callback) {
-            for (auto& [c_coord, chunk] : worldChunks_) {
+    while (!worldGenPending_.empty()) {
+        auto pending = std::move(worldGenPending_.front());
+        worldGenPending_.pop_front();
+
+        pending.done.get();
+        CommitGeneratedChunk(*pending.generated);
+
+        SubmitQueuedChunks(pool, proto);
+    }
+}
 
-                for (uint32_t y = 0; y < Chunk::kChunkWidth; ++y) { // x, y is position within current chunk
-                    for (uint32_t x = 0; x < Chunk::kChunkWidth; ++x) {
+void game::World::GenChunkFinish() {
+    while (!worldGenPending_.empty()) {
+        auto pending = std::move(worldGenPending_.front());
+        worldGenPending_.pop_front();
 
-                        auto coord = ChunkCToWorldC({std::get<0>(c_coord), std::get<1>(c_coord)});
-                        coord.x += x;
-                        coord.y += y;
+        pending.done.get();
+        CommitGeneratedChunk(*pending.generated);
+    }
+}
 
-                        for (uint8_t layer_i = 0; layer_i < kTileLayerCount; ++layer_i) {
-                            const auto tlayer = static_cast<TileLayer>(layer_i);
 
-                            auto* tile = GetTile(coord, tlayer);
-                            assert(tile != nullptr);
+void game::World::MarkSaved() {
+    worldChunks_.ForEach([](Chunk& chunk) {
+        if (chunk.IsDirty()) {
+            chunk.MarkSaved();
+        }
+    });
+    deletedChunks_.clear();
+}
 
-                            callback(coord, *tile, tlayer);
-                        }
+void game::World::DeserializePostProcess() {
+    // Logic lists were replaced
+    conveyorActiveSet_->stale = true;
+
+    // Entities reach at most into neighboring chunks, e.g. a mining drill at the edge of a chunk
+    std::vector<ChunkCoord> neighbors;
+    if (!encodedChunks_.empty()) {
+        worldChunks_.ForEach([this, &neighbors](const Chunk& chunk) {
+            if (chunk.IsStandalone())
+                return;
+
+            const auto c_coord = chunk.GetPosition();
+            for (ChunkCoordAxis y = -1; y <= 1; ++y) {
+                for (ChunkCoordAxis x = -1; x <= 1; ++x) {
+                    if (encodedChunks_.count({c_coord.x + x, c_coord.y + y}) > 0) {
+                        neighbors.push_back({c_coord.x + x, c_coord.y + y});
                     }
                 }
             }
-        };
+        });
+    }
+    DecodeEncodedChunks(neighbors);
+
+    std::vector<Chunk*> chunks;
+    chunks.reserve(worldChunks_.Size());
+    worldChunks_.ForEach([&chunks](Chunk& chunk) { chunks.push_back(&chunk); });
+
+    auto iterate_chunk = [](Chunk& chunk, const auto& callback) {
+        const auto chunk_start = ChunkCToWorldC(chunk.GetPosition());
+
+        for (ChunkTileCoordAxis y = 0; y < Chunk::kChunkWidth; ++y) { // x, y is position within current chunk
+            for (ChunkTileCoordAxis x = 0; x < Chunk::kChunkWidth; ++x) {
+                const WorldCoord coord{chunk_start.x + x, chunk_start.y + y};
+
+                for (uint8_t layer_i = 0; layer_i < kTileLayerCount; ++layer_i) {
+                    const auto tlayer = static_cast<TileLayer>(layer_i);
+
+                    callback(coord, chunk.GetCTile({x, y}, tlayer), tlayer);
+                }
+            }
+        }
+    };
 
     // Resolve multi tiles
-    iterate_world_chunks([this](const auto& coord, auto& tile, auto tlayer) {
-        if (tile.GetMultiTileIndex() != 0) {
-            auto* tl_tile = GetTile(coord.Incremented(tile), tlayer); // Now adjusted to top left
-            assert(tl_tile != nullptr);
+    // Chunks resolve in parallel, only non top left tiles are modified and top left tiles are only read
+    auto resolve_multi_tiles = [this, &chunks, &iterate_chunk](const std::size_t i) {
+        iterate_chunk(*chunks[i], [this](const auto& coord, auto& tile, auto tlayer) {
+            if (tile.GetMultiTileIndex() != 0) {
+                // Chunks with multi tiles are never left encoded, no chunk is decoded here
+                auto* tl_tile = GetTile(coord.Incremented(tile), tlayer); // Now adjusted to top left
+                assert(tl_tile != nullptr);
+
+                tile.SetupMultiTile(tile.GetMultiTileIndex(), *tl_tile);
+            }
+        });
+    };
+    if (data::active_thread_pool != nullptr) {
+        data::active_thread_pool->ParallelFor(chunks.size(), resolve_multi_tiles);
+    }
+    else {
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            resolve_multi_tiles(i);
+        }
+    }
+
+    // OnDeserialize, serially as entities may modify their neighbors
+    for (auto* chunk : chunks) {
+        iterate_chunk(*chunk, [this](const auto& coord, auto& tile, auto /*tlayer*/) {
+            if (tile.GetPrototype() != nullptr && tile.IsTopLeft()) {
+                tile.GetPrototype()->OnDeserialize(*this, coord, tile);
+            }
+        });
+    }
+}
 
-            tile.SetupMultiTile(tile.GetMultiTileIndex(), *tl_tile);
+std::vector<std::string> game::World::EncodeChunks(const std::vector<const Chunk*>& chunks,
+                                                   std::vector<ChunkBufferEntry>& directory,
+                                                   ThreadPool* pool) {
+    std::vector<std::string> buffers(chunks.size());
+    directory.resize(chunks.size());
+
+    auto encode = [&chunks, &buffers, &directory](const std::size_t i) {
+        std::ostringstream oss(std::ios_base::binary);
+        {
+            cereal::PortableBinaryOutputArchive archive(oss);
+            archive(*chunks[i]);
         }
-    });
+        buffers[i]   = oss.str();
+        directory[i] = {chunks[i]->GetPosition(), buffers[i].size(), chunks[i]->IsStandalone()};
+    };
 
-    // OnDeserialize
-    iterate_world_chunks([this](const auto& coord, auto& tile, auto /*tlayer*/) {
-        if (tile.GetPrototype() != nullptr && tile.IsTopLeft()) {
-            tile.GetPrototype()->OnDeserialize(*this, coord, tile);
+    if (pool != nullptr) {
+        pool->ParallelFor(chunks.size(), encode);
+    }
+    else {
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            encode(i);
         }
-    });
+    }
+    return buffers;
+}
+
+bool game::World::DeferSaveChunks(const std::vector<const Chunk*>& chunks, const EncodedChunksT& encoded) {
+    if (data::active_deferred_save == nullptr)
+        return false;
+
+    // Copying a standalone chunk copies no unique data
+    std::vector<const Chunk*> unique_chunks;
+    std::vector<Chunk> copies;
+    copies.reserve(chunks.size());
+    for (const auto* chunk : chunks) {
+        if (chunk->IsStandalone()) {
+            copies.push_back(*chunk);
+        }
+        else {
+            unique_chunks.push_back(chunk);
+        }
+    }
+
+    std::vector<ChunkBufferEntry> directory;
+    auto buffers = EncodeChunks(unique_chunks, directory);
+
+    auto encode_copies = [directory = std::move(directory),
+                          buffers   = std::move(buffers),
+                          copies    = std::move(copies),
+                          encoded]() mutable {
+        std::vector<const Chunk*> copy_ptrs;
+        copy_ptrs.reserve(copies.size());
+        for (const auto& copy : copies) {
+            copy_ptrs.push_back(&copy);
+        }
+
+        // Workers of the thread pool are left to logic
+        std::vector<ChunkBufferEntry> copy_directory;
+        auto copy_buffers = EncodeChunks(copy_ptrs, copy_directory, nullptr);
+
+        directory.insert(directory.end(), copy_directory.begin(), copy_directory.end());
+        buffers.insert(
+            buffers.end(), std::make_move_iterator(copy_buffers.begin()), std::make_move_iterator(copy_buffers.end()));
+
+        std::ostringstream oss(std::ios_base::binary);
+        {
+            cereal::PortableBinaryOutputArchive archive(oss);
+            WriteChunks(archive, std::move(directory), buffers, encoded);
+        }
+        // Without the endianness byte each archive begins with, the save's archive already wrote it
+        auto bytes = oss.str();
+        bytes.erase(0, 1);
+        return bytes;
+    };
+    data::active_deferred_save->Defer(std::move(encode_copies));
+    return true;
+}
+
+std::unique_ptr<game::Chunk> game::World::DecodeChunk(const std::string& buffer, proto::UniqueDataPool& pool) {
+    proto::UniqueDataPool::Scope scope(pool);
+
+    std::istringstream iss(buffer, std::ios_base::binary);
+    auto chunk = std::make_unique<Chunk>();
+
+    cereal::PortableBinaryInputArchive archive(iss);
+    archive(*chunk);
+    return chunk;
+}
+
+std::vector<std::unique_ptr<game::Chunk>> game::World::DecodeChunks(const std::vector<ChunkBufferEntry>& directory,
+                                                                    const std::vector<std::string>& buffers,
+                                                                    proto::UniqueDataPool& pool) {
+    assert(directory.size() == buffers.size());
+    std::vector<std::unique_ptr<Chunk>> chunks(buffers.size());
+
+    auto decode = [&directory, &buffers, &chunks, &pool](const std::size_t i) {
+        auto chunk = DecodeChunk(buffers[i], pool);
+
+        if (chunk->GetPosition() != directory[i].coord) {
+            throw std::runtime_error("Chunk does not match save directory");
+        }
+        chunks[i] = std::move(chunk);
+    };
+
+    if (data::active_thread_pool != nullptr) {
+        data::active_thread_pool->ParallelFor(buffers.size(), decode);
+    }
+    else {
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            decode(i);
+        }
+    }
+    return chunks;
+}
+
+void game::World::LoadEncodedChunks(const ChunkCoord& center, const ChunkCoordAxis radius) {
+    std::vector<ChunkCoord> c_coords;
+    for (const auto& [key, buffer] : encodedChunks_) {
+        const ChunkCoord c_coord{std::get<0>(key), std::get<1>(key)};
+        if (std::abs(c_coord.x - center.x) <= radius && std::abs(c_coord.y - center.y) <= radius) {
+            c_coords.push_back(c_coord);
+        }
+    }
+    DecodeEncodedChunks(c_coords);
+}
+
+void game::World::DecodeEncodedChunks(const std::vector<ChunkCoord>& c_coords) {
+    std::vector<ChunkBufferEntry> directory;
+    std::vector<std::string> buffers;
+    for (const auto& c_coord : c_coords) {
+        const auto encoded = encodedChunks_.find({c_coord.x, c_coord.y});
+        if (encoded == encodedChunks_.end())
+            continue;
+
+        // Erased once taken, so coords repeated in c_coords are decoded once
+        if (constDecoded_->chunks.count(encoded->first) > 0) {
+            worldChunks_.Insert(c_coord, TakeEncodedChunk(encoded));
+            continue;
+        }
+        directory.push_back({c_coord, encoded->second->size(), true});
+        buffers.push_back(*encoded->second);
+        encodedChunks_.erase(encoded);
+    }
+
+    for (auto& chunk : DecodeChunks(directory, buffers, *uniqueDataPool_)) {
+        const auto c_coord = chunk->GetPosition();
+        chunk->MarkSaved();
+        worldChunks_.Insert(c_coord, std::move(chunk));
+    }
+}
+
+void game::World::EraseEncodedChunk(const ChunkCoord& c_coord) {
+    const ChunkKey key{c_coord.x, c_coord.y};
+    if (encodedChunks_.erase(key) > 0) {
+        std::lock_guard<std::shared_mutex> guard(constDecoded_->mutex);
+        constDecoded_->chunks.erase(key);
+    }
+}
+
+std::unique_ptr<game::Chunk> game::World::TakeEncodedChunk(const EncodedChunksT::const_iterator encoded) {
+    std::unique_ptr<Chunk> chunk;
+    {
+        std::lock_guard<std::shared_mutex> guard(constDecoded_->mutex);
+
+        const auto decoded = constDecoded_->chunks.find(encoded->first);
+        if (decoded != constDecoded_->chunks.end()) {
+            chunk = std::move(decoded->second);
+            constDecoded_->chunks.erase(decoded);
+        }
+    }
+    if (chunk == nullptr) {
+        chunk = DecodeChunk(*encoded->second, *uniqueDataPool_);
+        chunk->MarkSaved();
+    }
+
+    encodedChunks_.erase(encoded);
+    return chunk;
 }
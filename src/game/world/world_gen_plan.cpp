@@ -0,0 +1,53 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "game/world/world_gen_plan.h"
+
+#include <algorithm>
+
+#include "data/prototype_manager.h"
+#include "proto/sprite.h"
+
+using namespace jactorio;
+
+/// \tparam T Type stored in noise layers of category
+template <typename T>
+static std::vector<game::WorldGenPlan::Layer<T>> MakeLayers(const data::PrototypeManager& proto,
+                                                             const int seed,
+                                                             const proto::Category category) {
+    auto noise_layers = proto.GetAll<proto::NoiseLayer<T>>(category);
+
+    // Sort Noise layers, the one with the highest order takes priority if tiles overlap
+    std::sort(
+        noise_layers.begin(), noise_layers.end(), [](auto* left, auto* right) { return left->order < right->order; });
+
+    std::vector<game::WorldGenPlan::Layer<T>> layers;
+    layers.reserve(noise_layers.size());
+
+    int seed_offset = 0; // Incremented every time a noise layer generates to keep terrain unique
+    for (const auto* noise_layer : noise_layers) {
+        auto& layer      = layers.emplace_back();
+        layer.noiseLayer = noise_layer;
+
+        layer.params.seed        = seed + seed_offset++;
+        layer.params.octaveCount = noise_layer->octaveCount;
+        layer.params.frequency   = noise_layer->frequency;
+        layer.params.persistence = noise_layer->persistence;
+
+        layer.normalize = noise_layer->normalize;
+        layer.ranges    = noise_layer->GetNoiseRanges();
+
+        for (const auto* prototype : noise_layer->GetPrototypes()) {
+            layer.prototypes.push_back(prototype);
+
+            const bool has_sprite = prototype != nullptr && prototype->sprite != nullptr;
+            layer.texCoordIds.push_back(has_sprite ? prototype->sprite->texCoordId : 0);
+        }
+    }
+    return layers;
+}
+
+game::WorldGenPlan::WorldGenPlan(const data::PrototypeManager& proto, const int seed)
+    : proto_(&proto),
+      seed_(seed),
+      tileLayers_(MakeLayers<proto::Tile>(proto, seed, proto::Category::noise_layer_tile)),
+      entityLayers_(MakeLayers<proto::Entity>(proto, seed, proto::Category::noise_layer_entity)) {}
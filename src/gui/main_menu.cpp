@@ -204,11 +204,15 @@ static void LoadSaveGameMenu(ThreadedLoopCommon& common) {
     for (const auto& save_game : data::GetSaveDirIt()) {
         const auto filename = save_game.path().stem().string();
 
+        // E.g: Temporary file of a save being written
+        if (!data::IsValidSaveName(filename))
+            continue;
+
         if (MenuButton(filename.c_str())) {
             try {
                 common.gameController.LoadGame(filename.c_str());
             }
-            catch (cereal::Exception& e) {
+            catch (std::runtime_error& e) {
                 common.mainMenuData.lastError = e.what();
                 LOG_MESSAGE_F(error, "Failed to load game %s : %s", filename.c_str(), e.what());
             }
@@ -253,10 +257,11 @@ static void SaveGameMenu(ThreadedLoopCommon& common) {
     if (data::IsValidSaveName(save_name)) {
         if (MenuButtonMini(GetLocalText(common, proto::LabelNames::kMenuSaveGameSave))) {
             try {
-                common.gameController.SaveGame(save_name);
+                // Game continues while the save is written
+                common.gameController.SaveGameAsync(save_name);
                 common.mainMenuData.currentMenu = MainMenuData::Window::main;
             }
-            catch (cereal::Exception& e) {
+            catch (std::runtime_error& e) {
                 common.mainMenuData.lastError = e.what();
                 LOG_MESSAGE_F(error, "Failed to save game as %s : %s", save_name, e.what());
             }
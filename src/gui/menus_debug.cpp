@@ -16,6 +16,7 @@
 #include "game/logic/logic.h"
 #include "game/logistic/inventory.h"
 #include "game/player/player.h"
+#include "game/world/perlin_noise.h"
 #include "game/world/world.h"
 #include "gui/colors.h"
 #include "gui/context.h"
@@ -132,6 +133,15 @@ void gui::DebugMenu(const Context& context,
         ImGui::InputInt("World generator seed", &seed);
         world.SetWorldGeneratorSeed(seed);
 
+        // Unsupported kernels are ignored when selected
+        const char* noise_kernels[] = {"libnoise", "Scalar", "SSE2", "AVX2"};
+        static_assert(std::size(noise_kernels) == static_cast<int>(game::NoiseKernel::count_));
+
+        int noise_kernel = static_cast<int>(game::GetNoiseKernel());
+        if (ImGui::Combo("Noise kernel", &noise_kernel, noise_kernels, static_cast<int>(std::size(noise_kernels)))) {
+            game::SetNoiseKernel(static_cast<game::NoiseKernel>(noise_kernel));
+        }
+
         // Options
         ImGui::Checkbox("Item spawner", &show_item_spawner_window);
 
@@ -290,6 +300,12 @@ void gui::DebugTileInfo(GameWorlds& worlds, game::Player& player) {
         ImGui::Text("Prototype: %s", MemoryAddressToStr(tile->GetPrototype()).c_str());
         ImGui::Text("Unique data: %s", MemoryAddressToStr(tile->GetUniqueData()).c_str());
     }
+
+    const auto* resource_amount = world.GetResourceAmount(player.world.GetMouseTileCoords());
+    if (resource_amount != nullptr) {
+        ImGui::TextUnformatted("------------------------------------");
+        ImGui::Text("Resource amount: %u", *resource_amount);
+    }
 }
 
 static void ShowConveyorSegments(game::World& world,
@@ -466,28 +482,29 @@ void gui::DebugConveyorInfo(GameWorlds& worlds,
         ImGui::Text("Direction: %s", segment.direction.ToCstr());
 
         ImGui::Text("Item update index: %d %d", segment.left.index, segment.right.index);
+        ImGui::Text("Sleeping: %s", segment.IsSleeping() ? "true" : "false");
 
         // Appending item
         const std::string iname = "__base__/wooden-chest-item";
         if (ImGui::Button("Append Item Left"))
-            segment.AppendItem(true, 0.2, *proto.Get<proto::Item>(iname));
+            segment.AppendItem(true, proto::LineDistT(0.2), *proto.Get<proto::Item>(iname));
 
         if (ImGui::Button("Append Item Right"))
-            segment.AppendItem(false, 0.2, *proto.Get<proto::Item>(iname));
+            segment.AppendItem(false, proto::LineDistT(0.2), *proto.Get<proto::Item>(iname));
 
 
         // Display items
         ImGui::Text("Left ----------");
         ImGui::Text("Status: %s", segment.left.IsActive() ? "Active" : "Stopped");
-        for (auto& item : segment.left.lane) {
-            ImGui::Text("%s %5.5f", item.item->name.c_str(), item.dist.getAsDouble());
+        for (const auto& item : segment.left.lane) {
+            ImGui::Text("%s %5.5f", item.item->name.c_str(), item.dist.AsDouble());
         }
 
         ImGui::Separator();
         ImGui::Text("Right ----------");
         ImGui::Text("Status: %s", segment.right.IsActive() ? "Active" : "Stopped");
-        for (auto& item : segment.right.lane) {
-            ImGui::Text("%s %5.5f", item.item->name.c_str(), item.dist.getAsDouble());
+        for (const auto& item : segment.right.lane) {
+            ImGui::Text("%s %5.5f", item.item->name.c_str(), item.dist.AsDouble());
         }
     }
 }
@@ -513,7 +530,7 @@ void gui::DebugInserterInfo(GameWorlds& worlds, game::Player& player) {
 
     ImGui::Text("Orientation %s", inserter_data.orientation.ToCstr());
 
-    ImGui::Text("Degree: %f", inserter_data.rotationDegree.getAsDouble());
+    ImGui::Text("Degree: %f", inserter_data.rotationDegree.AsDouble());
 
     switch (inserter_data.status) {
     case proto::InserterData::Status::dropoff:
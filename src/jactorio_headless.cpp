@@ -0,0 +1,224 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "jactorio.h"
+
+#include "config.h"
+#include "core/crash_handler.h"
+#include "core/execution_timer.h"
+#include "core/resource_guard.h"
+#include "data/save_game_manager.h"
+#include "game/game_controller.h"
+#include "render/spritemap_generator.h"
+
+using namespace jactorio;
+
+namespace
+{
+    /// Accumulated results of a headless run
+    struct HeadlessStats
+    {
+        uint64_t ticks   = 0;
+        double elapsedMs = 0;
+        /// Key is the ExecutionTimer name, value is the total time in milliseconds across all ticks
+        std::map<std::string, double> phaseTotalMs;
+    };
+
+    void PrintUsage() {
+        printf("Usage: jactorioHeadless <save name> <ticks> [log level]\n"
+               "       jactorioHeadless --pregenerate <save name> --radius <chunks> [log level]\n"
+               "    save name  Save in saves/ to load, no extension. E.g: \"first world\"\n"
+               "               When pregenerating, a new world is created if the save does not exist\n"
+               "    ticks      Number of logic ticks to run\n"
+               "    chunks     Chunks to generate in each direction from spawn\n"
+               "    log level  0 (debug) - %d (none), defaults to warning\n",
+               static_cast<int>(LogSeverity::none));
+    }
+
+    /// Generates chunks within radius of spawn which do not exist on all cores, then saves the game
+    void Pregenerate(game::GameController& game_controller, const char* save_name, const int radius) {
+        // Tex coord ids are assigned when the renderer creates the terrain spritemap, chunks store the ids
+        // Ids are deterministic, thus identical to the ones assigned when the save is loaded with a renderer
+        const auto spritemap = render::RendererSprites::CreateSpritemap(
+            game_controller.proto, proto::Sprite::SpriteGroup::terrain, false);
+
+        auto& world = game_controller.worlds[0];
+
+        uint64_t chunk_count = 0;
+        for (int y = -radius; y <= radius; ++y) {
+            for (int x = -radius; x <= radius; ++x) {
+                if (world.GetChunkC({x, y}) == nullptr) {
+                    world.QueueChunkGeneration({x, y});
+                    ++chunk_count;
+                }
+            }
+        }
+
+        const auto gen_start = std::chrono::steady_clock::now();
+        world.GenChunkAll(game_controller.threadPool, game_controller.proto);
+        const auto gen_end = std::chrono::steady_clock::now();
+
+        game_controller.SaveGame(save_name);
+        const auto save_end = std::chrono::steady_clock::now();
+
+        const double gen_s          = std::chrono::duration<double>(gen_end - gen_start).count();
+        const double save_s         = std::chrono::duration<double>(save_end - gen_end).count();
+        const double chunks_per_sec = gen_s > 0 ? static_cast<double>(chunk_count) / gen_s : 0;
+
+        printf("Chunks: %llu\n", static_cast<unsigned long long>(chunk_count));
+        printf("Threads: %llu\n",
+               static_cast<unsigned long long>(game_controller.threadPool.GetThreadCount()));
+        printf("Generation time: %.3f s\n", gen_s);
+        printf("Chunks/s: %.2f\n", chunks_per_sec);
+        printf("Save time: %.3f s\n", save_s);
+    }
+
+    /// Runs logic ticks back to back, without rendering or waiting for the next frame
+    HeadlessStats RunTicks(game::GameController& game_controller, const uint64_t ticks) {
+        HeadlessStats stats;
+        stats.ticks = ticks;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < ticks; ++i) {
+            // Timers not entered in a tick would otherwise report their previous sample again
+            ExecutionTimer::measuredTimes.clear();
+
+            game_controller.LogicUpdate();
+
+            for (const auto& [name, ms] : ExecutionTimer::measuredTimes) {
+                stats.phaseTotalMs[name] += ms;
+            }
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+
+        stats.elapsedMs = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        return stats;
+    }
+
+    void PrintStats(const HeadlessStats& stats) {
+        const double elapsed_s     = stats.elapsedMs / 1000;
+        const double ticks_per_sec = elapsed_s > 0 ? static_cast<double>(stats.ticks) / elapsed_s : 0;
+
+        printf("Ticks: %llu\n", static_cast<unsigned long long>(stats.ticks));
+        printf("Time: %.3f s\n", elapsed_s);
+        printf("Ticks/s: %.2f (%.2fx realtime)\n", ticks_per_sec, ticks_per_sec / kGameHertz);
+        printf("\n%-24s %14s %14s %8s\n", "Phase", "Total ms", "Avg ms/tick", "Share");
+
+        for (const auto& [name, total_ms] : stats.phaseTotalMs) {
+            const double avg_ms = stats.ticks > 0 ? total_ms / static_cast<double>(stats.ticks) : 0;
+            const double share  = stats.elapsedMs > 0 ? total_ms / stats.elapsedMs * 100 : 0;
+            printf("%-24s %14.3f %14.4f %7.2f%%\n", name.c_str(), total_ms, avg_ms, share);
+        }
+    }
+} // namespace
+
+
+/// ENTRY POINT
+/// Loads a save and runs logic updates as fast as possible, reporting throughput and the time spent per phase
+/// Or generates the chunks around spawn into a save, reporting chunks generated per second
+int main(const int argc, char* argv[]) {
+    const bool pregenerate = argc > 1 && std::strcmp(argv[1], "--pregenerate") == 0;
+
+    // Index of first optional argument
+    const int args_end = pregenerate ? 5 : 3;
+    if (argc < args_end || argc > args_end + 1 || (pregenerate && std::strcmp(argv[3], "--radius") != 0)) {
+        PrintUsage();
+        return 1;
+    }
+
+    current_path(std::filesystem::path(argv[0]).parent_path());
+
+    const char* save_name = pregenerate ? argv[2] : argv[1];
+
+    uint64_t ticks = 0;
+    int radius     = 0;
+    if (pregenerate) {
+        char* end         = nullptr;
+        const auto parsed = std::strtol(argv[4], &end, 10);
+        if (*end != '\0' || parsed < 0 || parsed > std::numeric_limits<ChunkCoordAxis>::max() / 2) {
+            printf("Invalid radius\n");
+            return 1;
+        }
+        radius = static_cast<int>(parsed);
+    }
+    else {
+        ticks = std::strtoull(argv[2], nullptr, 10);
+        if (ticks == 0) {
+            printf("Invalid tick count\n");
+            return 1;
+        }
+    }
+
+    log_level = LogSeverity::warning;
+    if (argc == args_end + 1) {
+        const auto level = argv[args_end][0] - '0';
+        if (level >= 0 && level <= static_cast<int>(LogSeverity::none)) {
+            log_level = static_cast<LogSeverity>(level);
+        }
+        else {
+            // Have to use printf, logger is not initialized yet
+            printf("Invalid log level\n");
+            return 1;
+        }
+    }
+    ResourceGuard log_guard(&CloseLogFile);
+    OpenLogFile();
+
+    RegisterCrashHandler();
+
+    LOG_MESSAGE_F(info,
+                  "%s | %s build %d, version: %s | Headless\n\n",
+                  CConfig::kBuildTargetPlatform,
+                  CConfig::kBuildType,
+                  CConfig::kBuildNumber,
+                  CConfig::kVersion);
+
+    // No render controller exists, keybinds which act on the renderer are never raised without input
+    auto game_controller = std::make_unique<game::GameController>(nullptr);
+
+    data::active_prototype_manager   = &game_controller->proto;
+    data::active_unique_data_manager = &game_controller->unique;
+
+    if (!game_controller->Init()) {
+        printf("Failed to load prototypes\n");
+        return 1;
+    }
+
+    const bool new_world = pregenerate && !std::filesystem::exists(data::ResolveSavePath(save_name));
+    if (new_world) {
+        printf("Save '%s' does not exist, generating new world\n", save_name);
+    }
+    else {
+        try {
+            game_controller->LoadGame(save_name);
+        }
+        catch (std::exception& e) {
+            printf("Failed to load save '%s': %s\n", save_name, e.what());
+            return 1;
+        }
+    }
+
+    if (pregenerate) {
+        try {
+            Pregenerate(*game_controller, save_name, radius);
+        }
+        catch (std::exception& e) {
+            printf("Failed to pregenerate save '%s': %s\n", save_name, e.what());
+            return 1;
+        }
+    }
+    else {
+        PrintStats(RunTicks(*game_controller, ticks));
+    }
+
+    LOG_MESSAGE(info, "goodbye!");
+    return 0;
+}
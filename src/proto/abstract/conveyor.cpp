@@ -26,7 +26,8 @@ void proto::Conveyor::OnBuild(game::World& world,
                               game::Logic& /*logic*/,
                               const WorldCoord& coord,
                               const Orientation orientation) const {
-    auto& con_data = world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<ConveyorData>();
+    auto& con_data =
+        world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<ConveyorData>(world.GetUniqueDataPool());
     BuildConveyor(world, coord, con_data, orientation, kConveyorLogicGroup);
 }
 
@@ -44,6 +45,7 @@ void proto::Conveyor::OnNeighborUpdate(game::World& world,
     // Reset segment lane item index to 0, since the head items MAY now have somewhere to go
     line_data->structure->left.index  = 0;
     line_data->structure->right.index = 0;
+    line_data->structure->Wake();
 
     ConveyorUpdateNeighborTermination(world, receive_coord);
 }
@@ -116,7 +116,7 @@ void proto::AssemblyMachine::OnBuild(game::World& world,
                                      game::Logic& /*logic*/,
                                      const WorldCoord& coord,
                                      const Orientation /*orientation*/) const {
-    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<AssemblyMachineData>();
+    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<AssemblyMachineData>(world.GetUniqueDataPool());
     world.DisableAnimation(coord, game::TileLayer::entity);
 }
 
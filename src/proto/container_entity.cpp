@@ -12,7 +12,8 @@ void proto::ContainerEntity::OnBuild(game::World& world,
                                      game::Logic& /*logic*/,
                                      const WorldCoord& coord,
                                      Orientation /*orientation*/) const {
-    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<ContainerEntityData>(inventorySize);
+    world.GetTile(coord, game::TileLayer::entity)
+        ->MakeUniqueData<ContainerEntityData>(world.GetUniqueDataPool(), inventorySize);
 }
 
 bool proto::ContainerEntity::OnRShowGui(const gui::Context& context, game::ChunkTile* tile) const {
@@ -0,0 +1,30 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include "proto/framework/unique_data_pool.h"
+
+#include <atomic>
+
+using namespace jactorio;
+
+proto::UniqueDataPool& proto::UniqueDataPool::Current() noexcept {
+    if (current_ != nullptr)
+        return *current_;
+
+    // Never destroyed, unique data outside of a world may be destroyed during static destruction
+    static auto* pool = new UniqueDataPool();
+    return *pool;
+}
+
+void proto::UniqueDataPool::Release() noexcept {
+    std::lock_guard<std::mutex> guard(poolsMutex_);
+    for (auto& pool : pools_) {
+        if (pool != nullptr) {
+            pool->Release();
+        }
+    }
+}
+
+std::size_t proto::UniqueDataPool::NextTypeIndex() noexcept {
+    static std::atomic<std::size_t> next_index = 0;
+    return next_index++;
+}
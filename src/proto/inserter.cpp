@@ -18,7 +18,7 @@ void proto::Inserter::OnBuild(game::World& world,
                               game::Logic& /*logic*/,
                               const WorldCoord& coord,
                               Orientation orientation) const {
-    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<InserterData>(orientation);
+    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<InserterData>(world.GetUniqueDataPool(), orientation);
 
     // Dropoff side
     {
@@ -2,6 +2,7 @@
 
 #include "proto/mining_drill.h"
 
+#include <algorithm>
 #include <tuple>
 
 #include "game/logic/logic.h"
@@ -24,14 +25,15 @@ proto::Item* proto::MiningDrill::FindOutputItem(const game::World& world,
     coord.x -= this->miningRadius;
     coord.y -= this->miningRadius;
 
-    for (WorldCoordAxis y = 0; y < SafeCast<WorldCoordAxis>(2u * this->miningRadius + this->GetHeight(orien)); ++y) {
-        for (WorldCoordAxis x = 0; x < SafeCast<WorldCoordAxis>(2u * this->miningRadius + this->GetWidth(orien)); ++x) {
-            const auto* tile = world.GetTile({coord.x + x, coord.y + y}, game::TileLayer::resource);
+    const auto* tile = world.FindTileInRect(coord,
+                                            GetMiningArea(orien),
+                                            game::TileLayer::resource,
+                                            [](const WorldCoord& /*coord*/, const game::ChunkTile& tile) {
+                                                return tile.GetPrototype() != nullptr;
+                                            });
 
-            if (tile->GetPrototype() != nullptr)
-                return tile->GetPrototype<ResourceEntity>()->GetItem();
-        }
-    }
+    if (tile != nullptr)
+        return tile->GetPrototype<ResourceEntity>()->GetItem();
 
     return nullptr;
 }
@@ -69,23 +71,21 @@ bool proto::MiningDrill::OnCanBuild(const game::World& world, const WorldCoord&
     coords.x -= this->miningRadius;
     coords.y -= this->miningRadius;
 
-    for (WorldCoordAxis y = 0; y < SafeCast<WorldCoordAxis>(2u * this->miningRadius + this->GetHeight(orien)); ++y) {
-        for (WorldCoordAxis x = 0; x < SafeCast<WorldCoordAxis>(2u * this->miningRadius + this->GetWidth(orien)); ++x) {
-            const auto* tile = world.GetTile({coords.x + x, coords.y + y}, game::TileLayer::resource);
-
-            if (tile->GetPrototype() != nullptr)
-                return true;
-        }
-    }
-
-    return false;
+    const auto* tile = world.FindTileInRect(coords,
+                                            GetMiningArea(orien),
+                                            game::TileLayer::resource,
+                                            [](const WorldCoord& /*coord*/, const game::ChunkTile& tile) {
+                                                return tile.GetPrototype() != nullptr;
+                                            });
+    return tile != nullptr;
 }
 
 void proto::MiningDrill::OnBuild(game::World& world,
                                  game::Logic& logic,
                                  const WorldCoord& coord,
                                  const Orientation orientation) const {
-    auto& drill_data = world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<MiningDrillData>(orientation);
+    auto& drill_data = world.GetTile(coord, game::TileLayer::entity)
+                           ->MakeUniqueData<MiningDrillData>(world.GetUniqueDataPool(), orientation);
     world.DisableAnimation(coord, game::TileLayer::entity);
 
     drill_data.resourceCoord.x = coord.x - this->miningRadius;
@@ -146,7 +146,17 @@ void proto::MiningDrill::OnDeserialize(game::World& world, const WorldCoord& coo
     auto* drill_data = tile.GetUniqueData<MiningDrillData>();
     assert(drill_data != nullptr);
 
-    InitializeOutput(world, GetOutputCoord(coord, drill_data->output.GetOrientation()), drill_data);
+    // Output's orientation is drill's orientation
+    const auto orientation = drill_data->output.GetOrientation();
+
+    // Resources up to resourceOffset were already mined
+    FindResources(world, *drill_data, orientation);
+    auto& offsets = drill_data->resourceOffsets;
+    while (!offsets.empty() && offsets.back() <= drill_data->resourceOffset) {
+        offsets.pop_back();
+    }
+
+    InitializeOutput(world, GetOutputCoord(coord, orientation), drill_data);
 }
 
 void proto::MiningDrill::PostLoadValidate(const data::PrototypeManager& proto) const {
@@ -179,61 +189,104 @@ int proto::MiningDrill::GetMiningAreaY(const Orientation orien) const {
     return 2 * this->miningRadius + this->GetHeight(orien);
 }
 
+Dimension proto::MiningDrill::GetMiningArea(const Orientation orien) const {
+    return {SafeCast<DimensionAxis>(GetMiningAreaX(orien)), SafeCast<DimensionAxis>(GetMiningAreaY(orien))};
+}
+
 bool proto::MiningDrill::SetupResourceDeduction(const game::World& world,
                                                 MiningDrillData& drill_data,
                                                 const Orientation orien) const {
+    FindResources(world, drill_data, orien);
+    return TakeNextResource(world, drill_data, orien);
+}
+
+void proto::MiningDrill::FindResources(const game::World& world,
+                                       MiningDrillData& drill_data,
+                                       const Orientation orien) const {
     const auto x_span = GetMiningAreaX(orien);
-    const auto y_span = GetMiningAreaY(orien);
-
-    for (int y = 0; y < y_span; ++y) {
-        for (int x = 0; x < x_span; ++x) {
-            const auto* tile = world.GetTile({drill_data.resourceCoord.x + x, drill_data.resourceCoord.y + y},
-                                             game::TileLayer::resource);
-
-            if (tile->GetPrototype() != nullptr) {
-                drill_data.outputItem     = tile->GetPrototype<ResourceEntity>()->GetItem();
-                drill_data.resourceOffset = SafeCast<decltype(drill_data.resourceOffset)>(y * x_span + x);
-                return true;
-            }
-        }
-    }
 
+    auto& offsets = drill_data.resourceOffsets;
+    offsets.clear();
+
+    world.ForEachTileInRect(drill_data.resourceCoord,
+                            GetMiningArea(orien),
+                            game::TileLayer::resource,
+                            [&](const WorldCoord& coord, const game::ChunkTile& tile) {
+                                if (tile.GetPrototype() == nullptr)
+                                    return;
+
+                                const auto x = coord.x - drill_data.resourceCoord.x;
+                                const auto y = coord.y - drill_data.resourceCoord.y;
+                                offsets.push_back(SafeCast<uint16_t>(y * x_span + x));
+                            });
+
+    // First resource from top left is mined first
+    std::reverse(offsets.begin(), offsets.end());
+}
+
+bool proto::MiningDrill::TakeNextResource(const game::World& world,
+                                          MiningDrillData& drill_data,
+                                          const Orientation orien) const {
+    auto& offsets = drill_data.resourceOffsets;
+
+    // Resources may have been depleted by another drill or the player since the offsets were found
+    while (!offsets.empty()) {
+        const auto offset = offsets.back();
+        offsets.pop_back();
+
+        const auto* tile = world.GetTile(GetResourceCoord(drill_data, offset, orien), game::TileLayer::resource);
+        if (tile == nullptr || tile->GetPrototype() == nullptr)
+            continue;
+
+        drill_data.outputItem     = tile->GetPrototype<ResourceEntity>()->GetItem();
+        drill_data.resourceOffset = offset;
+        return true;
+    }
     return false;
 }
 
+WorldCoord proto::MiningDrill::GetResourceCoord(const MiningDrillData& drill_data,
+                                                const uint16_t resource_offset,
+                                                const Orientation orien) const {
+    return {drill_data.resourceCoord.x + resource_offset % GetMiningAreaX(orien),
+            drill_data.resourceCoord.y + resource_offset / GetMiningAreaX(orien)};
+}
+
 bool proto::MiningDrill::DeductResource(game::World& world,
                                         const Orientation orien,
                                         MiningDrillData& drill_data,
-                                        const ResourceEntityData::ResourceCount amount) const {
-    auto get_tile_coord = [&]() {
-        return WorldCoord{drill_data.resourceCoord.x + drill_data.resourceOffset % GetMiningAreaX(orien),
-                          drill_data.resourceCoord.y + drill_data.resourceOffset / GetMiningAreaX(orien)};
-    };
+                                        const ResourceEntityResourceCount amount) const {
     auto get_resource_layer = [&](const WorldCoord& coord) {
-        auto* tile = world.GetTile(coord, game::TileLayer::resource);
-        assert(tile != nullptr);
-        return std::make_tuple(tile, tile->GetUniqueData<ResourceEntityData>());
+        auto* chunk = world.GetChunkW(coord);
+        assert(chunk != nullptr);
+
+        chunk->MarkDirty(); // Resource amount deducted
+
+        const auto ct_coord = game::Chunk::WorldCToChunkTileC(coord);
+        return std::make_tuple(&chunk->GetCTile(ct_coord, game::TileLayer::resource),
+                               &chunk->GetResourceAmount(ct_coord));
     };
 
 
-    auto tile_coord                      = get_tile_coord();
-    auto [resource_layer, resource_data] = get_resource_layer(tile_coord);
+    auto tile_coord                        = GetResourceCoord(drill_data, drill_data.resourceOffset, orien);
+    auto [resource_layer, resource_amount] = get_resource_layer(tile_coord);
 
-    if (resource_data == nullptr) {
-        if (!SetupResourceDeduction(world, drill_data, orien))
+    if (resource_layer->GetPrototype() == nullptr) {
+        // Search mining area again once all found resources are depleted, resources may be in chunks generated since
+        if (!TakeNextResource(world, drill_data, orien) && !SetupResourceDeduction(world, drill_data, orien))
             return false; // Drill has no resources left to mine
 
-        tile_coord                              = get_tile_coord();
-        std::tie(resource_layer, resource_data) = get_resource_layer(tile_coord);
+        tile_coord                                = GetResourceCoord(drill_data, drill_data.resourceOffset, orien);
+        std::tie(resource_layer, resource_amount) = get_resource_layer(tile_coord);
     }
 
-    assert(resource_data != nullptr);
+    assert(resource_layer->GetPrototype() != nullptr);
 
-    assert(resource_data->resourceAmount >= amount);
-    resource_data->resourceAmount -= amount;
+    assert(*resource_amount >= amount);
+    *resource_amount -= amount;
 
 
-    if (resource_data->resourceAmount == 0) {
+    if (*resource_amount == 0) {
         resource_layer->Clear();
         world.SetTexCoordId(tile_coord, game::TileLayer::resource, 0);
     }
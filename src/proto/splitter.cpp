@@ -16,7 +16,7 @@ void proto::Splitter::OnBuild(game::World& world,
                               game::Logic& /*logic*/,
                               const WorldCoord& coord,
                               const Orientation orientation) const {
-    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<SplitterData>(orientation);
+    world.GetTile(coord, game::TileLayer::entity)->MakeUniqueData<SplitterData>(world.GetUniqueDataPool(), orientation);
 
     auto build_conveyor = [&world, orientation](const WorldCoord& side_coord) {
         auto* con_data = GetConData(world, side_coord);
@@ -17,7 +17,7 @@ using namespace jactorio;
 static void PrepareConveyorSegmentData(render::IRenderBuffer& buf,
                                        const SpriteTexCoords& tex_coords,
                                        const game::ConveyorStruct& conveyor,
-                                       std::deque<game::ConveyorItem>& conveyor_lane,
+                                       const game::ConveyorItemBuffer& conveyor_lane,
                                        Position2<double> tile_offset,
                                        const Position2<OverlayOffsetAxis>& pixel_offset) {
     using namespace game;
@@ -55,7 +55,7 @@ static void PrepareConveyorSegmentData(render::IRenderBuffer& buf,
 
     for (const auto& [dist, item] : conveyor_lane) {
         // Move the target offset (up or down depending on multiplier)
-        *target_offset += dist.getAsDouble() * multiplier;
+        *target_offset += dist.AsDouble() * multiplier;
 
         // tl = Top left; br = Bottom right
         constexpr auto f_tile_width = SafeCast<float>(render::TileRenderer::tileWidth);
@@ -334,7 +334,7 @@ void render::PrepareInserterParts(IRenderBuffer& buf,
     // ^^^ Accounts for arm lengths > 1
 
     // Rotation from 12:00 position
-    const auto rotation_rad = glm::radians(LossyCast<float>(inserter_data.rotationDegree.getAsDouble()) +
+    const auto rotation_rad = glm::radians(LossyCast<float>(inserter_data.rotationDegree.AsDouble()) +
                                            static_cast<float>(inserter_data.orientation) * 90);
 
     // To world space
@@ -229,8 +229,6 @@ void render::TileRenderer::GlRender(const game::World& world) {
     // ======================================================================
 
 
-    std::mutex world_gen_mutex;
-
     // Thread order: (Helps reduce stalls as some threads are always active)
     // - Start all
     // - Wait for thread 1, draw, continue thread 1
@@ -255,7 +253,6 @@ void render::TileRenderer::GlRender(const game::World& world) {
                                           this,
                                           std::ref(r_layer),
                                           std::ref(world),
-                                          std::ref(world_gen_mutex),
                                           row_start,
                                           chunk_amount.x,
                                           render_tile_offset);
@@ -280,7 +277,6 @@ void render::TileRenderer::GlRender(const game::World& world) {
                                                  this,
                                                  std::ref(r_layer),
                                                  std::ref(world),
-                                                 std::ref(world_gen_mutex),
                                                  row_start,
                                                  chunk_amount.x,
                                                  render_tile_offset);
@@ -457,49 +453,15 @@ Position2<int> render::TileRenderer::GetTileDrawAmount() const noexcept {
 
 void render::TileRenderer::PrepareChunkRow(TRenderBuffer& r_layer,
                                            const game::World& world,
-                                           std::mutex& world_gen_mutex,
                                            Position2<int> row_start,
                                            const int chunk_span,
                                            Position2<int> render_tile_offset) const noexcept {
-    auto [tex_ids, readable_chunks] = world.GetChunkTexCoordIds(row_start);
-
-    if (readable_chunks < chunk_span) {
-        std::lock_guard gen_guard{world_gen_mutex};
-
-        for (int x = readable_chunks; x < chunk_span; ++x) {
-            const auto chunk_x = x + row_start.x;
-            world.QueueChunkGeneration({chunk_x, row_start.y});
-        }
-    }
-
-    // If the leftmost chunk is not readable, try other ones in row
-    // avoids annoying black screens when moving left
-    if (readable_chunks == 0) {
-        int i = 1; // Not 0, since we already know current chunk has no readable chunks
-        while (readable_chunks == 0 && i < chunk_span) {
-            std::tie(tex_ids, readable_chunks) = world.GetChunkTexCoordIds({row_start.x + i, row_start.y});
-            render_tile_offset.x += game::Chunk::kChunkWidth;
-            ++i;
-        }
-        row_start.x += i - 1; // i gets increment extra time at end of while
-    }
-
-    // Despite being readable, the chunk may not be generated
-    auto tex_ids_2 = tex_ids; // Cannot move the original pointer
-    for (int i = 0; i < readable_chunks; ++i) {
-        if (tex_ids_2[0] == 0) { // First tile, bottom layer of chunk
-            std::lock_guard gen_guard{world_gen_mutex};
-            world.QueueChunkGeneration({row_start.x + i, row_start.y});
-        }
-        tex_ids_2 += game::Chunk::kChunkArea * game::kTileLayerCount;
-    }
-
     // Allocate for the maximum possible tile layers to render
     const auto required_r_layer_capacity =
         SafeCast<uint32_t>(chunk_span * game::Chunk::kChunkArea * game::kTileLayerCount);
-    if (required_r_layer_capacity > r_layer.Capacity()) {
+    const bool reserved = required_r_layer_capacity > r_layer.Capacity();
+    if (reserved) {
         r_layer.Reserve(required_r_layer_capacity);
-        return;
     }
 
     // Prevents PrepareChunk from having a pixel x/y < 0
@@ -514,29 +476,37 @@ void render::TileRenderer::PrepareChunkRow(TRenderBuffer& r_layer,
         tiles_prepare_y = game::Chunk::kChunkWidth;
     }
 
-    for (int x = 0; x < std::min(readable_chunks, chunk_span); ++x) {
-        const auto chunk_render_tile_offset_x = x * game::Chunk::kChunkWidth + render_tile_offset.x;
+    world.ForEachChunkTexCoordIds(
+        row_start, chunk_span, [&](const ChunkCoord& c_coord, const SpriteTexCoordIndexT* tex_ids) {
+            if (tex_ids == nullptr) {
+                world.QueueChunkGeneration(c_coord);
+                return;
+            }
+            if (reserved)
+                return;
 
-        auto skip_tiles_left = -chunk_render_tile_offset_x / SafeCast<int>(tileWidth);
-        if (skip_tiles_left < 0) {
-            skip_tiles_left = 0;
-        }
+            const auto chunk_render_tile_offset_x =
+                (c_coord.x - row_start.x) * game::Chunk::kChunkWidth + render_tile_offset.x;
 
-        // Tiles needed to reach window width
-        auto tiles_prepare_x =
-            (windowWidth_ - render_tile_offset.x * SafeCast<int>(tileWidth)) / SafeCast<int>(tileWidth);
-        if (tiles_prepare_x > game::Chunk::kChunkWidth) {
-            tiles_prepare_x = game::Chunk::kChunkWidth;
-        }
+            auto skip_tiles_left = -chunk_render_tile_offset_x / SafeCast<int>(tileWidth);
+            if (skip_tiles_left < 0) {
+                skip_tiles_left = 0;
+            }
 
-        // PrepareOverlayLayers(r_layer, chunk, render_tile_offset); // Unused
-        PrepareChunk(r_layer,
-                     tex_ids,
-                     {chunk_render_tile_offset_x, render_tile_offset.y},
-                     {SafeCast<uint8_t>(skip_tiles_left), SafeCast<uint8_t>(skip_tiles_top)},
-                     {SafeCast<uint8_t>(tiles_prepare_x), SafeCast<uint8_t>(tiles_prepare_y)});
-        tex_ids += game::Chunk::kChunkArea * game::kTileLayerCount;
-    }
+            // Tiles needed to reach window width
+            auto tiles_prepare_x =
+                (windowWidth_ - render_tile_offset.x * SafeCast<int>(tileWidth)) / SafeCast<int>(tileWidth);
+            if (tiles_prepare_x > game::Chunk::kChunkWidth) {
+                tiles_prepare_x = game::Chunk::kChunkWidth;
+            }
+
+            // PrepareOverlayLayers(r_layer, chunk, render_tile_offset); // Unused
+            PrepareChunk(r_layer,
+                         tex_ids,
+                         {chunk_render_tile_offset_x, render_tile_offset.y},
+                         {SafeCast<uint8_t>(skip_tiles_left), SafeCast<uint8_t>(skip_tiles_top)},
+                         {SafeCast<uint8_t>(tiles_prepare_x), SafeCast<uint8_t>(tiles_prepare_y)});
+        });
 }
 
 FORCEINLINE void render::TileRenderer::PrepareChunk(TRenderBuffer& r_layer,
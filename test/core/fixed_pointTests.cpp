@@ -0,0 +1,92 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "core/fixed_point.h"
+
+namespace jactorio
+{
+    using TestFixedT = FixedPoint<int32_t, 1000>;
+
+    TEST(FixedPoint, Construct) {
+        EXPECT_EQ(TestFixedT().Raw(), 0);
+        EXPECT_EQ(TestFixedT(3).Raw(), 3000);
+        EXPECT_EQ(TestFixedT(-3).Raw(), -3000);
+
+        EXPECT_EQ(TestFixedT(0.06).Raw(), 60);
+        EXPECT_EQ(TestFixedT(2.1f).Raw(), 2100);
+        EXPECT_EQ(TestFixedT(-0.7).Raw(), -700);
+
+        // Rounded to nearest
+        EXPECT_EQ(TestFixedT(0.0004).Raw(), 0);
+        EXPECT_EQ(TestFixedT(0.0005).Raw(), 1);
+        EXPECT_EQ(TestFixedT(-0.0005).Raw(), -1);
+
+        EXPECT_EQ(TestFixedT::FromRaw(1234).AsDouble(), 1.234);
+    }
+
+    TEST(FixedPoint, Assign) {
+        TestFixedT fixed;
+
+        fixed = 12;
+        EXPECT_EQ(fixed.Raw(), 12000);
+
+        fixed = 0.125;
+        EXPECT_EQ(fixed.Raw(), 125);
+    }
+
+    TEST(FixedPoint, AsInteger) {
+        EXPECT_EQ(TestFixedT(2.4).AsInteger(), 2);
+        EXPECT_EQ(TestFixedT(2.5).AsInteger(), 3);
+        EXPECT_EQ(TestFixedT(-2.4).AsInteger(), -2);
+        EXPECT_EQ(TestFixedT(-2.5).AsInteger(), -3);
+    }
+
+    TEST(FixedPoint, AddSubtract) {
+        // 0.1 repeatedly added does not drift as a double would
+        TestFixedT fixed;
+        for (int i = 0; i < 10; ++i) {
+            fixed += TestFixedT(0.1);
+        }
+        EXPECT_EQ(fixed, TestFixedT(1));
+
+        EXPECT_EQ(TestFixedT(0.7) + TestFixedT(0.3), TestFixedT(1));
+        EXPECT_EQ(TestFixedT(0.3) - TestFixedT(0.7), TestFixedT(-0.4));
+        EXPECT_EQ(-TestFixedT(1.5), TestFixedT(-1.5));
+    }
+
+    TEST(FixedPoint, MultiplyDivide) {
+        EXPECT_EQ(TestFixedT(1.5) * TestFixedT(2), TestFixedT(3));
+        EXPECT_EQ(TestFixedT(-0.5) * TestFixedT(0.5), TestFixedT(-0.25));
+
+        EXPECT_EQ(TestFixedT(1) / TestFixedT(3), TestFixedT(0.333));
+        EXPECT_EQ(TestFixedT(-2) / TestFixedT(3), TestFixedT(-0.667));
+        EXPECT_EQ(TestFixedT(2) / TestFixedT(-3), TestFixedT(-0.667));
+    }
+
+    TEST(FixedPoint, MultiplyDivideWide) {
+        using WideFixedT = FixedPoint<int64_t, 1000>;
+
+        // Product of the raw values does not fit in 64 bits
+        EXPECT_EQ(WideFixedT::FromRaw(6345532536000) * WideFixedT(6345), WideFixedT::FromRaw(40262403940920000));
+        EXPECT_EQ(WideFixedT(-6345532.536) * WideFixedT(0.5), WideFixedT(-3172766.268));
+        EXPECT_EQ(WideFixedT(6345532.536) / WideFixedT(-2), WideFixedT(-3172766.268));
+
+        EXPECT_EQ(WideFixedT(-2) / WideFixedT(3), WideFixedT(-0.667));
+    }
+
+    TEST(FixedPoint, Abs) {
+        EXPECT_EQ(TestFixedT(-1.25).Abs(), TestFixedT(1.25));
+        EXPECT_EQ(TestFixedT(1.25).Abs(), TestFixedT(1.25));
+        EXPECT_EQ(TestFixedT().Abs(), TestFixedT());
+    }
+
+    TEST(FixedPoint, Compare) {
+        EXPECT_TRUE(TestFixedT(0.25) == TestFixedT(0.25));
+        EXPECT_TRUE(TestFixedT(0.25) != TestFixedT(0.26));
+        EXPECT_TRUE(TestFixedT(-0.25) < TestFixedT(0.25));
+        EXPECT_TRUE(TestFixedT(0.25) <= TestFixedT(0.25));
+        EXPECT_TRUE(TestFixedT(1) > TestFixedT(0.999));
+        EXPECT_TRUE(TestFixedT(1) >= TestFixedT(1));
+    }
+} // namespace jactorio
@@ -0,0 +1,115 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "core/slab_pool.h"
+
+#include <thread>
+#include <vector>
+
+namespace jactorio
+{
+    struct SlabPoolTestObject
+    {
+        double a = 0;
+        int b    = 0;
+    };
+
+    TEST(SlabPool, AllocateContiguous) {
+        SlabPool<SlabPoolTestObject, 4> pool;
+
+        auto* first  = static_cast<SlabPoolTestObject*>(pool.Allocate());
+        auto* second = static_cast<SlabPoolTestObject*>(pool.Allocate());
+
+        EXPECT_EQ(reinterpret_cast<char*>(second) - reinterpret_cast<char*>(first), sizeof(SlabPoolTestObject));
+        EXPECT_EQ(pool.Size(), 2);
+        EXPECT_EQ(pool.SlabCount(), 1);
+
+        pool.Deallocate(first);
+        pool.Deallocate(second);
+    }
+
+    TEST(SlabPool, AllocateNewSlab) {
+        SlabPool<SlabPoolTestObject, 4> pool;
+
+        std::vector<void*> ptrs;
+        for (int i = 0; i < 5; ++i) {
+            ptrs.push_back(pool.Allocate());
+        }
+        EXPECT_EQ(pool.SlabCount(), 2);
+
+        for (auto* ptr : ptrs) {
+            pool.Deallocate(ptr);
+        }
+    }
+
+    TEST(SlabPool, ReuseDeallocated) {
+        SlabPool<SlabPoolTestObject, 4> pool;
+
+        auto* first = pool.Allocate();
+        auto* held  = pool.Allocate();
+
+        pool.Deallocate(first);
+        EXPECT_EQ(pool.Allocate(), first);
+        EXPECT_EQ(pool.SlabCount(), 1);
+
+        pool.Deallocate(first);
+        pool.Deallocate(held);
+    }
+
+    TEST(SlabPool, Release) {
+        SlabPool<SlabPoolTestObject, 4> pool;
+
+        for (int i = 0; i < 9; ++i) {
+            (void)pool.Allocate();
+        }
+        EXPECT_EQ(pool.SlabCount(), 3);
+
+        pool.Release();
+        EXPECT_EQ(pool.Size(), 0);
+        EXPECT_EQ(pool.SlabCount(), 0);
+
+        (void)pool.Allocate();
+        EXPECT_EQ(pool.SlabCount(), 1);
+        pool.Release();
+    }
+
+    TEST(SlabPool, DeallocateToOwner) {
+        SlabPool<SlabPoolTestObject, 4> pool_a;
+        SlabPool<SlabPoolTestObject, 4> pool_b;
+
+        auto* a = pool_a.Allocate();
+        auto* b = pool_b.Allocate();
+
+        // Memory returns to the pool which allocated it, regardless of the pool it is deallocated with
+        pool_a.Deallocate(b);
+        EXPECT_EQ(pool_a.Size(), 1);
+        EXPECT_EQ(pool_b.Size(), 0);
+        EXPECT_EQ(pool_b.Allocate(), b);
+
+        SlabPool<SlabPoolTestObject, 4>::Deallocate(a);
+        EXPECT_EQ(pool_a.Size(), 0);
+        EXPECT_EQ(pool_a.Allocate(), a);
+    }
+
+    TEST(SlabPool, AllocateThreads) {
+        SlabPool<SlabPoolTestObject, 16> pool;
+
+        auto allocate = [&pool]() {
+            std::vector<void*> ptrs;
+            for (int i = 0; i < 1000; ++i) {
+                ptrs.push_back(pool.Allocate());
+            }
+            for (auto* ptr : ptrs) {
+                pool.Deallocate(ptr);
+            }
+        };
+
+        std::thread t1(allocate);
+        std::thread t2(allocate);
+        t1.join();
+        t2.join();
+
+        EXPECT_EQ(pool.Size(), 0);
+    }
+} // namespace jactorio
@@ -0,0 +1,81 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "core/thread_pool.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace jactorio
+{
+    TEST(ThreadPool, Submit) {
+        ThreadPool pool(2);
+        EXPECT_EQ(pool.GetThreadCount(), 2);
+
+        int value = 0;
+        pool.Submit([&value]() { value = 42; }).get();
+
+        EXPECT_EQ(value, 42);
+    }
+
+    TEST(ThreadPool, SubmitException) {
+        ThreadPool pool(1);
+
+        auto future = pool.Submit([]() { throw std::runtime_error("Task error"); });
+        EXPECT_THROW(future.get(), std::runtime_error);
+    }
+
+    TEST(ThreadPool, ParallelFor) {
+        ThreadPool pool(3);
+
+        std::vector<int> visited(1000, 0);
+        pool.ParallelFor(visited.size(), [&visited](const std::size_t i) { visited[i]++; });
+
+        for (const auto count : visited) {
+            EXPECT_EQ(count, 1);
+        }
+    }
+
+    TEST(ThreadPool, ParallelForEmpty) {
+        ThreadPool pool(2);
+
+        std::atomic<int> calls = 0;
+        pool.ParallelFor(0, [&calls](std::size_t) { ++calls; });
+
+        EXPECT_EQ(calls, 0);
+    }
+
+    TEST(ThreadPool, ParallelForException) {
+        ThreadPool pool(2);
+
+        std::atomic<int> calls = 0;
+        EXPECT_THROW(pool.ParallelFor(100,
+                                      [&calls](const std::size_t i) {
+                                          ++calls;
+                                          if (i == 50)
+                                              throw std::runtime_error("Index 50");
+                                      }),
+                     std::runtime_error);
+
+        // Remaining indices still run
+        EXPECT_EQ(calls, 100);
+    }
+
+    TEST(ThreadPool, ParallelForWorkersBusy) {
+        ThreadPool pool(1);
+
+        std::promise<void> release;
+        auto blocked = pool.Submit([future = release.get_future().share()]() { future.wait(); });
+
+        // Completes on the calling thread while the only worker is busy
+        std::atomic<int> calls = 0;
+        pool.ParallelFor(4, [&calls](std::size_t) { ++calls; });
+        EXPECT_EQ(calls, 4);
+
+        release.set_value();
+        blocked.get();
+    }
+} // namespace jactorio
@@ -2,19 +2,65 @@
 
 #include <gtest/gtest.h>
 
-#include "data/cereal/support/decimal.h"
+#include "data/cereal/support/fixed_point.h"
 
 #include "jactorioTests.h"
 
+#include <limits>
+
+#include "core/resource_guard.h"
+
 namespace jactorio::data
 {
-    TEST(CerealSupport, DecDecimal) {
+    TEST(CerealSupport, FixedDecimal3) {
         constexpr auto original_val = 6345532.536;
 
-        const Decimal3T val(original_val);
+        const FixedDecimal3T val(original_val);
 
         const auto result = TestSerializeDeserialize(val);
 
-        EXPECT_DOUBLE_EQ(result.getAsDouble(), original_val);
+        EXPECT_DOUBLE_EQ(result.AsDouble(), original_val);
+    }
+
+    /// Layout of a FixedDecimal3T in saves before kSaveVersionFixedPoint
+    struct LegacyDecimal3
+    {
+        int64_t before;
+        int64_t after;
+
+        CEREAL_SERIALIZE(archive) {
+            archive(before, after);
+        }
+    };
+
+    TEST(CerealSupport, FixedDecimal3Legacy) {
+        active_save_version = kSaveVersionLegacy;
+        CapturingGuard<void()> guard([]() { active_save_version = kSaveVersion; });
+
+        TestSerialize(LegacyDecimal3{-1, -234});
+        EXPECT_EQ(TestDeserialize<FixedDecimal3T>(), FixedDecimal3T(-1.234));
+
+        TestSerialize(LegacyDecimal3{0, -500});
+        EXPECT_EQ(TestDeserialize<FixedDecimal3T>(), FixedDecimal3T(-0.5));
+
+        TestSerialize(LegacyDecimal3{87, 900});
+        EXPECT_EQ(TestDeserialize<FixedDecimal3T>(), FixedDecimal3T(87.9));
+    }
+
+    TEST(CerealSupport, FixedDecimal3LegacyOutOfRange) {
+        active_save_version = kSaveVersionLegacy;
+        CapturingGuard<void()> guard([]() { active_save_version = kSaveVersion; });
+
+        TestSerialize(LegacyDecimal3{std::numeric_limits<int64_t>::max() / 10, 0});
+        FixedDecimal3T val;
+        EXPECT_THROW(TestDeserialize(val), std::runtime_error);
+    }
+
+    TEST(CerealSupport, FixedDecimal3Narrow) {
+        active_save_version = kSaveVersionFixedPoint;
+        CapturingGuard<void()> guard([]() { active_save_version = kSaveVersion; });
+
+        TestSerialize(int32_t{-1234});
+        EXPECT_EQ(TestDeserialize<FixedDecimal3T>(), FixedDecimal3T(-1.234));
     }
 } // namespace jactorio::data
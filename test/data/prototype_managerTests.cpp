@@ -263,4 +263,42 @@ namespace jactorio::data
         EXPECT_EQ(&proto_.RelocationTableGet<proto::Sprite>(1), &sprite);
         EXPECT_EQ(proto_.GetDebugInfo().relocationTable.size(), 1);
     }
+
+    TEST_F(PrototypeManagerTest, TilePrototypeId) {
+        auto& container = proto_.Make<proto::ContainerEntity>();
+        proto_.Make<proto::Sprite>();
+        auto& container_2 = proto_.Make<proto::ContainerEntity>();
+
+        EXPECT_EQ(container.tilePrototypeId, 1);
+        EXPECT_EQ(container_2.tilePrototypeId, 2); // Sprite is not a world object
+        EXPECT_EQ(proto_.TilePrototypeGet(1), &container);
+        EXPECT_EQ(proto_.TilePrototypeGet(2), &container_2);
+        EXPECT_EQ(proto_.TilePrototypeGet(0), nullptr);
+
+        // Ids are per prototype manager
+        PrototypeManager other_proto;
+        auto& other_container = other_proto.Make<proto::ContainerEntity>();
+        EXPECT_EQ(other_container.tilePrototypeId, 1);
+        EXPECT_EQ(proto_.TilePrototypeGet(1), &container);
+        EXPECT_EQ(other_proto.TilePrototypeGet(1), &other_container);
+    }
+
+    TEST_F(PrototypeManagerTest, TilePrototypeIdOverride) {
+        auto& container = proto_.Make<proto::ContainerEntity>("chest");
+        const auto id   = container.tilePrototypeId;
+
+        auto& overriding = proto_.Make<proto::ContainerEntity>("chest");
+        EXPECT_NE(overriding.tilePrototypeId, id); // Not reused
+        EXPECT_EQ(proto_.TilePrototypeGet(id), nullptr);
+        EXPECT_EQ(proto_.TilePrototypeGet(overriding.tilePrototypeId), &overriding);
+    }
+
+    TEST_F(PrototypeManagerTest, TilePrototypeIdClear) {
+        proto_.Make<proto::ContainerEntity>();
+        proto_.Clear();
+
+        auto& container = proto_.Make<proto::ContainerEntity>();
+        EXPECT_EQ(container.tilePrototypeId, 1);
+        EXPECT_EQ(proto_.TilePrototypeGet(1), &container);
+    }
 } // namespace jactorio::data
@@ -5,6 +5,7 @@
 #include "data/save_game_manager.h"
 
 #include <fstream>
+#include <sstream>
 
 #include "core/loop_common.h"
 #include "proto/sprite.h"
@@ -56,4 +57,106 @@ namespace jactorio::data
 
         std::filesystem::remove_all("saves");
     }
+
+    TEST(SaveGameManager, SaveHeader) {
+        std::stringstream ss;
+        WriteSaveHeader(ss);
+        ss << "game";
+
+        EXPECT_EQ(ReadSaveHeader(ss), kSaveVersion);
+
+        std::string remaining;
+        ss >> remaining;
+        EXPECT_EQ(remaining, "game");
+    }
+
+    TEST(SaveGameManager, ReadSaveHeaderLegacy) {
+        // Save without header is left untouched
+
+        std::stringstream ss;
+        ss << "legacy game";
+
+        EXPECT_EQ(ReadSaveHeader(ss), kSaveVersionLegacy);
+
+        std::string remaining;
+        std::getline(ss, remaining);
+        EXPECT_EQ(remaining, "legacy game");
+    }
+
+    TEST(SaveGameManager, ReadSaveHeaderNewer) {
+        std::stringstream ss;
+        ss.write("JACTSAVE", 8);
+
+        const SaveVersionT newer_version = kSaveVersion + 1;
+        for (std::size_t i = 0; i < sizeof(SaveVersionT); ++i) {
+            ss.put(static_cast<char>((newer_version >> (i * 8)) & 0xFF));
+        }
+
+        EXPECT_THROW((void)ReadSaveHeader(ss), std::runtime_error);
+    }
+
+    TEST(SaveGameManager, SaveIncrement) {
+        std::stringstream ss;
+        WriteSaveIncrement(ss, "first");
+        WriteSaveIncrement(ss, std::string("sec\0nd", 7));
+
+        std::string increment;
+        ASSERT_TRUE(ReadSaveIncrement(ss, increment));
+        EXPECT_EQ(increment, "first");
+
+        ASSERT_TRUE(ReadSaveIncrement(ss, increment));
+        EXPECT_EQ(increment, std::string("sec\0nd", 7));
+
+        EXPECT_FALSE(ReadSaveIncrement(ss, increment));
+    }
+
+    TEST(SaveGameManager, ReadSaveIncrementCutOff) {
+        std::stringstream written;
+        WriteSaveIncrement(written, "increment");
+
+        // Increment was partially written
+        auto bytes = written.str();
+        bytes.pop_back();
+        std::stringstream ss(bytes);
+
+        std::string increment;
+        EXPECT_FALSE(ReadSaveIncrement(ss, increment));
+    }
+
+    TEST(SaveGameManager, ReadSaveIncrementCorrupt) {
+        std::stringstream written;
+        WriteSaveIncrement(written, "increment");
+
+        // Data of increment partially flushed before a crash
+        auto bytes = written.str();
+        bytes[10]  = '\0';
+        std::stringstream ss(bytes);
+
+        std::string increment;
+        EXPECT_FALSE(ReadSaveIncrement(ss, increment));
+    }
+
+    TEST(SaveGameManager, ReadSaveIncrementNoChecksum) {
+        std::stringstream written;
+        WriteSaveIncrement(written, "increment");
+
+        // Older versions have no checksum after the increment
+        auto bytes = written.str();
+        bytes.resize(bytes.size() - sizeof(uint64_t));
+        std::stringstream ss(bytes);
+
+        std::string increment;
+        ASSERT_TRUE(ReadSaveIncrement(ss, increment, kSaveVersionWideFixedPoint));
+        EXPECT_EQ(increment, "increment");
+    }
+
+    TEST(SaveGameManager, DeferredSave) {
+        DeferredSave save;
+        save.Stream() << "ab";
+        save.Defer([]() { return std::string("X"); });
+        save.Stream() << "cd";
+        save.Defer([]() { return std::string("Y"); });
+
+        EXPECT_EQ(save.Finish(), "abXcdY");
+    }
 } // namespace jactorio::data
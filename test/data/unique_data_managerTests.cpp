@@ -4,6 +4,11 @@
 
 #include "proto/assembly_machine.h"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace jactorio::data
 {
     TEST(UniqueDataManager, AssignId) {
@@ -19,6 +24,37 @@ namespace jactorio::data
         EXPECT_EQ(data_2.internalId, 2);
     }
 
+    TEST(UniqueDataManager, AssignIdThreads) {
+        UniqueDataManager unique;
+
+        std::vector<proto::AssemblyMachineData> data_1(1000);
+        std::vector<proto::AssemblyMachineData> data_2(1000);
+
+        auto assign = [&unique](std::vector<proto::AssemblyMachineData>& data) {
+            for (auto& unique_data : data) {
+                unique.AssignId(unique_data);
+            }
+        };
+
+        std::thread t1(assign, std::ref(data_1));
+        std::thread t2(assign, std::ref(data_2));
+        t1.join();
+        t2.join();
+
+        std::vector<UniqueDataIdT> ids;
+        for (const auto& unique_data : data_1) {
+            ids.push_back(unique_data.internalId);
+        }
+        for (const auto& unique_data : data_2) {
+            ids.push_back(unique_data.internalId);
+        }
+        std::sort(ids.begin(), ids.end());
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(ids[i], i + 1);
+        }
+    }
+
     TEST(UniqueDataManager, ClearResetId) {
         UniqueDataManager unique;
 
@@ -75,4 +111,27 @@ namespace jactorio::data
 
         EXPECT_TRUE(unique.GetDebugInfo().dataEntries.empty());
     }
+
+    TEST(UniqueDataManager, StoreSharedEntry) {
+        UniqueDataManager unique;
+
+        auto first  = std::make_shared<int>(1);
+        auto second = std::make_shared<int>(1);
+        auto other  = std::make_shared<int>(2);
+
+        EXPECT_EQ(unique.StoreSharedEntry(100, first), first);
+        EXPECT_EQ(unique.StoreSharedEntry(100, second), first); // Replaced by first copy
+        EXPECT_EQ(unique.StoreSharedEntry(200, other), other);
+    }
+
+    TEST(UniqueDataManager, ClearSharedEntries) {
+        UniqueDataManager unique;
+
+        auto first  = std::make_shared<int>(1);
+        auto second = std::make_shared<int>(1);
+
+        EXPECT_EQ(unique.StoreSharedEntry(100, first), first);
+        unique.Clear();
+        EXPECT_EQ(unique.StoreSharedEntry(100, second), second);
+    }
 } // namespace jactorio::data
@@ -4,6 +4,11 @@
 
 #include "game/game_controller.h"
 
+#include <filesystem>
+#include <fstream>
+
+#include "data/save_game_manager.h"
+
 #include "proto/container_entity.h"
 #include "proto/sprite.h"
 
@@ -30,4 +35,72 @@ namespace jactorio::game
 
         EXPECT_FALSE(game_controller.proto.GetAll<proto::ContainerEntity>().empty());
     }
+
+    TEST(GameController, SaveGameAsync) {
+        GameController game_controller{nullptr};
+
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+        EXPECT_FALSE(game_controller.IsSaving());
+
+        const auto save_path = data::ResolveSavePath("async_save");
+        EXPECT_TRUE(std::filesystem::exists(save_path));
+        EXPECT_FALSE(std::filesystem::exists(save_path + ".tmp"));
+
+        // Same as saving on calling thread
+        std::ifstream ifs(save_path, std::ios_base::binary);
+        EXPECT_EQ(data::ReadSaveHeader(ifs), data::kSaveVersion);
+
+        std::filesystem::remove_all("saves");
+    }
+
+    TEST(GameController, SaveGameAsyncIncrement) {
+        GameController game_controller{nullptr};
+
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+
+        const auto save_path = data::ResolveSavePath("async_save");
+        const auto base_size = std::filesystem::file_size(save_path);
+
+        // Appended to save
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+        EXPECT_GT(std::filesystem::file_size(save_path), base_size);
+
+        // Saved in full after reset
+        game_controller.ResetGame();
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+        EXPECT_EQ(std::filesystem::file_size(save_path), base_size);
+
+        std::filesystem::remove_all("saves");
+    }
+
+    TEST(GameController, LoadGameTornIncrement) {
+        GameController game_controller{nullptr};
+
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+
+        game_controller.logic.GameTickAdvance();
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+
+        const auto save_path  = data::ResolveSavePath("async_save");
+        const auto valid_size = std::filesystem::file_size(save_path);
+
+        game_controller.logic.GameTickAdvance();
+        game_controller.SaveGameAsync("async_save");
+        game_controller.WaitSaveGame();
+
+        // Crashed while appending last increment
+        std::filesystem::resize_file(save_path, std::filesystem::file_size(save_path) - 1);
+
+        game_controller.LoadGame("async_save");
+        EXPECT_EQ(game_controller.logic.GameTick(), 1);
+        EXPECT_EQ(std::filesystem::file_size(save_path), valid_size);
+
+        std::filesystem::remove_all("saves");
+    }
 } // namespace jactorio::game
\ No newline at end of file
@@ -5,9 +5,12 @@
 #include "game/logic/conveyor_controller.h"
 
 #include <memory>
+#include <vector>
 
 #include "jactorioTests.h"
 
+#include "core/thread_pool.h"
+#include "game/logic/conveyor_active_set.h"
 #include "proto/transport_belt.h"
 
 namespace jactorio::game
@@ -21,16 +24,20 @@ namespace jactorio::game
     class ConveyorControllerTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
         Logic logic_;
 
         Chunk* chunk_ = nullptr;
 
         proto::Item itemProto_;
-        proto::TransportBelt transportBelt_;
+        proto::TransportBelt& transportBelt_ = proto_.Make<proto::TransportBelt>();
 
         /// Creates a world, chunk at 0, 0
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             chunk_ = &world_.EmplaceChunk({0, 0});
         }
 
@@ -67,9 +74,9 @@ namespace jactorio::game
         CreateSegment({0, 5}, left_segment);
 
         // Logic
-        left_segment->AppendItem(true, 0.f, itemProto_);
-        left_segment->AppendItem(true, ConveyorProp::kItemSpacing, itemProto_);
-        left_segment->AppendItem(true, ConveyorProp::kItemSpacing, itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), itemProto_);
 
         // 1 update
         // first item moved to up segment
@@ -77,9 +84,9 @@ namespace jactorio::game
         ASSERT_EQ(up_segment->left.lane.size(), 1);
         ASSERT_EQ(left_segment->left.lane.size(), 2);
 
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.getAsDouble(), 4.40 - j_belt_speed);
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.25 - j_belt_speed);
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[1].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.AsDouble(), 4.40 - j_belt_speed);
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.25 - j_belt_speed);
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[1].dist.AsDouble(), 0.25);
 
         // 2 updates | 0.12
         for (int i = 0; i < 2; ++i) {
@@ -88,9 +95,9 @@ namespace jactorio::game
         ASSERT_EQ(up_segment->left.lane.size(), 1);
         ASSERT_EQ(left_segment->left.lane.size(), 2);
 
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.getAsDouble(), 4.40 - (3 * j_belt_speed));
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.25 - (3 * j_belt_speed));
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[1].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.AsDouble(), 4.40 - (3 * j_belt_speed));
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.25 - (3 * j_belt_speed));
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[1].dist.AsDouble(), 0.25);
 
 
         // 2 updates | Total distance = 4(0.06) = 0.24
@@ -101,11 +108,11 @@ namespace jactorio::game
         ASSERT_EQ(up_segment->left.lane.size(), 2);
         ASSERT_EQ(left_segment->left.lane.size(), 1);
 
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.getAsDouble(), 4.40 - (5 * j_belt_speed));
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[1].dist.getAsDouble(), 0.25); // Spacing maintained
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.AsDouble(), 4.40 - (5 * j_belt_speed));
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[1].dist.AsDouble(), 0.25); // Spacing maintained
         // Item 2 was 0.01 -> -0.05
         // | -0.05 - 0.20 | = 0.25 Maintains distance
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.20);
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.20);
     }
 
 
@@ -135,9 +142,9 @@ namespace jactorio::game
         CreateSegment({3, 0}, right_segment);
 
         // Offset is distance from beginning, or previous item
-        up_segment->AppendItem(true, 0.f, itemProto_);
-        up_segment->AppendItem(true, 1, itemProto_);
-        up_segment->AppendItem(true, 1, itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(1), itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(1), itemProto_);
         static_assert(ConveyorProp::kItemSpacing < 1); // Tested positions would otherwise be invalid
 
         // Logic
@@ -146,12 +153,12 @@ namespace jactorio::game
 
 
         EXPECT_EQ(up_segment->left.lane.size(), 2);
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.getAsDouble(), 0.99);
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[1].dist.getAsDouble(), 1.);
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.AsDouble(), 0.99);
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[1].dist.AsDouble(), 1.);
 
         EXPECT_EQ(right_segment->left.lane.size(), 1);
         // Moved forward once 4 - 0.3 - 0.01
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 3.69);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 3.69);
 
         // Transfer second item after (1 / 0.01) + 1 update - 1 update (Already moved once above)
         for (int i = 0; i < 100; ++i) {
@@ -161,8 +168,8 @@ namespace jactorio::game
         EXPECT_EQ(up_segment->left.lane.size(), 1);
         EXPECT_EQ(right_segment->left.lane.size(), 2);
         // Spacing of 1 tile between the items is maintained across belts
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 2.69);
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.getAsDouble(), 1);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 2.69);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.AsDouble(), 1);
 
 
         // Third item
@@ -172,9 +179,9 @@ namespace jactorio::game
         EXPECT_EQ(up_segment->left.lane.size(), 0);
         EXPECT_EQ(right_segment->left.lane.size(), 3);
 
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 1.69);
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.getAsDouble(), 1);
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[2].dist.getAsDouble(), 1);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 1.69);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.AsDouble(), 1);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[2].dist.AsDouble(), 1);
     }
 
     TEST_F(ConveyorControllerTest, LineLogicCompressedRightBend) {
@@ -203,19 +210,19 @@ namespace jactorio::game
         CreateSegment({3, 0}, right_segment);
 
         // Offset is distance from beginning, or previous item
-        up_segment->AppendItem(true, 0.f, itemProto_);
-        up_segment->AppendItem(true, ConveyorProp::kItemSpacing, itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), itemProto_);
 
         // First item
         ConveyorLogicUpdate(world_);
 
 
         EXPECT_EQ(up_segment->left.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.getAsDouble(), 0.24);
+        EXPECT_DOUBLE_EQ(up_segment->left.lane[0].dist.AsDouble(), 0.24);
 
         EXPECT_EQ(right_segment->left.lane.size(), 1);
         // Moved forward once 4 - 0.3 - 0.01
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 3.69);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 3.69);
 
 
         // Transfer second item after (0.25 / 0.01) + 1 update - 1 update (Already moved once above)
@@ -226,8 +233,8 @@ namespace jactorio::game
         EXPECT_EQ(up_segment->left.lane.size(), 0);
         EXPECT_EQ(right_segment->left.lane.size(), 2);
         // Spacing is maintained across belts
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 3.44);
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 3.44);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.AsDouble(), 0.25);
     }
 
     TEST_F(ConveyorControllerTest, LineLogicStopAtEndOfLine) {
@@ -242,9 +249,9 @@ namespace jactorio::game
 
         CreateSegment({0, 0}, segment);
 
-        segment->AppendItem(true, 0.5f, itemProto_);
-        segment->AppendItem(true, ConveyorProp::kItemSpacing, itemProto_);
-        segment->AppendItem(true, ConveyorProp::kItemSpacing + 1.f, itemProto_);
+        segment->AppendItem(true, proto::LineDistT(0.5f), itemProto_);
+        segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), itemProto_);
+        segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing + 1.f), itemProto_);
 
         // Will reach distance 0 after 0.5 / 0.01 updates
         for (int i = 0; i < 50; ++i) {
@@ -252,7 +259,7 @@ namespace jactorio::game
         }
 
         EXPECT_EQ(segment->left.index, 0);
-        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.AsDouble(), 0);
 
         // On the next update, with no target segment, first item is kept at 0, second item untouched
         // move index to 2 (was 0) as it has a distance greater than item_width
@@ -260,22 +267,22 @@ namespace jactorio::game
 
 
         EXPECT_EQ(segment->left.index, 2);
-        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.getAsDouble(), 0);
-        EXPECT_DOUBLE_EQ(segment->left.lane[1].dist.getAsDouble(), ConveyorProp::kItemSpacing);
-        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.getAsDouble(), ConveyorProp::kItemSpacing + 0.99);
+        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.AsDouble(), 0);
+        EXPECT_DOUBLE_EQ(segment->left.lane[1].dist.AsDouble(), ConveyorProp::kItemSpacing);
+        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.AsDouble(), ConveyorProp::kItemSpacing + 0.99);
 
         // After 0.2 + 0.99 / 0.01 updates, the Third item will not move in following updates
         for (int j = 0; j < 99; ++j) {
             ConveyorLogicUpdate(world_);
         }
-        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.getAsDouble(), ConveyorProp::kItemSpacing);
+        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.AsDouble(), ConveyorProp::kItemSpacing);
 
         ConveyorLogicUpdate(world_);
 
         // Index set to 0, checking if a valid target exists to move items forward
         EXPECT_EQ(segment->left.index, 0);
 
-        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.getAsDouble(), ConveyorProp::kItemSpacing);
+        EXPECT_DOUBLE_EQ(segment->left.lane[2].dist.AsDouble(), ConveyorProp::kItemSpacing);
 
 
         // Updates do nothing since all items are compressed
@@ -310,18 +317,18 @@ namespace jactorio::game
 
         // RIGHT LINE: 14 items can be fit on the right lane: (4 - 0.7) / ConveyorProp::kItemSpacing{0.25} = 13.2
         for (int i = 0; i < 14; ++i) {
-            right_segment->AppendItem(false, 0.f, itemProto_);
+            right_segment->AppendItem(false, proto::LineDistT(0.f), itemProto_);
         }
 
         // Items on up line should stop
-        up_segment->AppendItem(false, 0.f, itemProto_);
+        up_segment->AppendItem(false, proto::LineDistT(0.f), itemProto_);
 
         // WIll not move after an arbitrary number of updates
         for (int i = 0; i < 34; ++i) {
             ConveyorLogicUpdate(world_);
         }
 
-        EXPECT_DOUBLE_EQ(up_segment->right.lane.front().dist.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment->right.lane.front().dist.AsDouble(), 0);
     }
 
     TEST_F(ConveyorControllerTest, LineLogicNewSegmentAddedAhead) {
@@ -337,11 +344,11 @@ namespace jactorio::game
         CreateSegment({2, 1}, left_segment);
 
         // One item stopped, one still moving
-        left_segment->AppendItem(true, 0, itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(0), itemProto_);
         ConveyorLogicUpdate(world_);
         EXPECT_EQ(left_segment.get()->left.index, 0);
 
-        left_segment->AppendItem(true, 2, itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(2), itemProto_);
         ConveyorLogicUpdate(world_);
         EXPECT_EQ(left_segment.get()->left.index, 1);
 
@@ -382,11 +389,11 @@ namespace jactorio::game
         // ======================================================================
 
 
-        left_segment->AppendItem(true, 1 - ConveyorProp::kItemSpacing + 0.01, itemProto_);
+        left_segment->AppendItem(true, proto::LineDistT(1 - ConveyorProp::kItemSpacing + 0.01), itemProto_);
 
-        left_segment_2->AppendItem(true, 0, itemProto_);
-        left_segment_2->AppendItem(true, 0.5, itemProto_);
-        left_segment_2->AppendItem(true, 2, itemProto_);
+        left_segment_2->AppendItem(true, proto::LineDistT(0), itemProto_);
+        left_segment_2->AppendItem(true, proto::LineDistT(0.5), itemProto_);
+        left_segment_2->AppendItem(true, proto::LineDistT(2), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
@@ -398,6 +405,211 @@ namespace jactorio::game
     }
 
 
+    TEST_F(ConveyorControllerTest, SleepEmpty) {
+        transportBelt_.speed = 0.05;
+
+        auto segment =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 2);
+        CreateSegment({1, 0}, segment);
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_TRUE(segment->IsSleeping());
+        EXPECT_TRUE(world_.GetConveyorActiveSet().active.empty());
+
+        // Woken by inserting item, moves on the next update
+        segment->AppendItem(true, proto::LineDistT(0.5), itemProto_);
+        EXPECT_FALSE(segment->IsSleeping());
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_EQ(world_.GetConveyorActiveSet().active.size(), 1);
+        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.AsDouble(), 0.45);
+    }
+
+    TEST_F(ConveyorControllerTest, SleepBlockedAtEnd) {
+        // All items compressed at end of conveyor without target
+
+        transportBelt_.speed = 0.05;
+
+        auto segment =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        CreateSegment({1, 0}, segment);
+
+        segment->AppendItem(true, proto::LineDistT(0.05), itemProto_);
+        segment->AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), itemProto_);
+
+        ConveyorLogicUpdate(world_); // Front item reaches end
+        EXPECT_FALSE(segment->IsSleeping());
+
+        ConveyorLogicUpdate(world_); // Nothing can move
+        EXPECT_TRUE(segment->IsSleeping());
+
+        // Picking up the front item allows the remaining item to move
+        EXPECT_NE(segment->TryPopItem(true, proto::LineDistT(0)), nullptr);
+        EXPECT_FALSE(segment->IsSleeping());
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_DOUBLE_EQ(segment->left.lane[0].dist.AsDouble(), 0.2);
+    }
+
+    TEST_F(ConveyorControllerTest, SleepFeederWokenByTarget) {
+        //     1      2
+        // < ----- < -----
+
+        transportBelt_.speed = 0.05;
+
+        const auto segment_1 =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        CreateSegment({1, 1}, segment_1);
+
+        const auto segment_2 =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        segment_2->target = segment_1.get();
+        CreateSegment({2, 1}, segment_2);
+
+        for (int i = 0; i < 4; ++i) {
+            segment_1->AppendItem(true, proto::LineDistT(0), itemProto_);
+        }
+        segment_2->AppendItem(true, proto::LineDistT(0), itemProto_);
+
+        // Segment 1 is full and sleeps, segment 2 cannot insert into it and also sleeps
+        ConveyorLogicUpdate(world_);
+        EXPECT_TRUE(segment_1->IsSleeping());
+        EXPECT_TRUE(segment_2->IsSleeping());
+
+        // Space made in segment 1 wakes segment 2
+        EXPECT_NE(segment_1->TryPopItem(true, proto::LineDistT(0)), nullptr);
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_FALSE(segment_2->IsSleeping());
+
+        for (int i = 0; i < 5; ++i) {
+            ConveyorLogicUpdate(world_);
+        }
+        EXPECT_TRUE(segment_2->left.lane.empty());
+        EXPECT_EQ(segment_1->left.lane.size(), 4);
+    }
+
+    TEST_F(ConveyorControllerTest, SleepRescheduledOnStructureChange) {
+        transportBelt_.speed = 0.05;
+
+        auto segment =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        CreateSegment({1, 0}, segment);
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_TRUE(segment->IsSleeping());
+
+        // New conveyor is scheduled, others remain asleep
+        auto new_segment =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        new_segment->AppendItem(true, proto::LineDistT(0.5), itemProto_);
+        CreateSegment({3, 0}, new_segment);
+        EXPECT_FALSE(world_.GetConveyorActiveSet().stale);
+
+        ConveyorLogicUpdate(world_);
+        EXPECT_TRUE(segment->IsSleeping());
+        EXPECT_EQ(world_.GetConveyorActiveSet().active, std::vector<std::size_t>{1});
+        EXPECT_DOUBLE_EQ(new_segment->left.lane[0].dist.AsDouble(), 0.45);
+    }
+
+    TEST_F(ConveyorControllerTest, SleepMovedOnRemove) {
+        transportBelt_.speed = 0.05;
+
+        auto segment_1 =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        auto segment_2 =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        auto segment_3 =
+            std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+        CreateSegment({1, 0}, segment_1);
+        CreateSegment({3, 0}, segment_2);
+        CreateSegment({5, 0}, segment_3);
+
+        segment_1->AppendItem(true, proto::LineDistT(0.5), itemProto_);
+        ConveyorLogicUpdate(world_);
+        ASSERT_TRUE(segment_3->IsSleeping());
+
+        // Last conveyor moves into the slot of the first
+        world_.LogicRemove(LogicGroup::conveyor, {1, 0}, TileLayer::entity);
+        ConveyorLogicUpdate(world_);
+        EXPECT_EQ(segment_3->GetLogicIndex(), 0);
+        EXPECT_TRUE(segment_2->IsSleeping());
+
+        // Woken at its new index
+        segment_3->AppendItem(true, proto::LineDistT(0.5), itemProto_);
+        ConveyorLogicUpdate(world_);
+        EXPECT_EQ(world_.GetConveyorActiveSet().active, std::vector<std::size_t>{0});
+        EXPECT_DOUBLE_EQ(segment_3->left.lane[0].dist.AsDouble(), 0.45);
+    }
+
+    TEST_F(ConveyorControllerTest, ParallelSameAsSerial) {
+        // Rows of conveyors feeding left, every second row also feeds into the row above
+
+        transportBelt_.speed = 0.05;
+
+        World parallel_world;
+        parallel_world.EmplaceChunk({0, 0});
+
+        using StructsT = std::vector<std::shared_ptr<ConveyorStruct>>;
+
+        auto create_rows = [this](World& world) {
+            StructsT structs;
+            for (int y = 0; y < 16; ++y) {
+                ConveyorStruct* target = nullptr;
+                for (int x = 0; x < 6; ++x) {
+                    auto con_struct = std::make_shared<ConveyorStruct>(
+                        Orientation::left, ConveyorStruct::TerminationType::straight, 1);
+                    con_struct->target = target;
+                    if (x == 0 && y % 2 == 1) {
+                        con_struct->target = structs[structs.size() - 6 + 1].get();
+                    }
+
+                    for (int i = 0; i < (x + y) % 4; ++i) {
+                        con_struct->AppendItem(i % 2 == 0, proto::LineDistT(0.25), itemProto_);
+                    }
+
+                    TestCreateConveyorSegment(world, {x, y}, con_struct, transportBelt_);
+                    target = con_struct.get();
+                    structs.push_back(std::move(con_struct));
+                }
+            }
+            return structs;
+        };
+
+        const auto serial_structs   = create_rows(world_);
+        const auto parallel_structs = create_rows(parallel_world);
+
+        ThreadPool pool(3);
+        for (int i = 0; i < 200; ++i) {
+            ConveyorLogicUpdate(world_);
+            ConveyorLogicUpdate(parallel_world, pool, 0);
+
+            // Picking up items wakes sleeping conveyors
+            if (i % 50 == 0) {
+                for (std::size_t s = 0; s < serial_structs.size(); s += 7) {
+                    const proto::LineDistT offset(0);
+                    const proto::LineDistT epsilon(1);
+                    EXPECT_EQ(serial_structs[s]->TryPopItem(true, offset, epsilon) == nullptr,
+                              parallel_structs[s]->TryPopItem(true, offset, epsilon) == nullptr);
+                }
+            }
+        }
+
+        for (std::size_t s = 0; s < serial_structs.size(); ++s) {
+            for (const bool left_side : {true, false}) {
+                const auto& serial_lane   = serial_structs[s]->GetSide(left_side).lane;
+                const auto& parallel_lane = parallel_structs[s]->GetSide(left_side).lane;
+
+                ASSERT_EQ(serial_lane.size(), parallel_lane.size());
+                for (std::size_t i = 0; i < serial_lane.size(); ++i) {
+                    EXPECT_EQ(serial_lane[i].dist, parallel_lane[i].dist);
+                }
+            }
+            EXPECT_EQ(serial_structs[s]->IsSleeping(), parallel_structs[s]->IsSleeping());
+        }
+        EXPECT_EQ(world_.GetConveyorActiveSet().active, parallel_world.GetConveyorActiveSet().active);
+    }
+
     // ======================================================================
     // Line properties
 
@@ -409,12 +621,12 @@ namespace jactorio::game
 
         CreateSegment({0, 0}, right_segment);
 
-        right_segment->AppendItem(true, 0.f, itemProto_);
-        right_segment->AppendItem(true, 0.f, itemProto_); // Insert behind previous item
+        right_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+        right_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_); // Insert behind previous item
 
         // Check that second item has a minimum distance of ConveyorProp::kItemSpacing
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.getAsDouble(), 0.);
-        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.getAsDouble(), ConveyorProp::kItemSpacing);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[0].dist.AsDouble(), 0.);
+        EXPECT_DOUBLE_EQ(right_segment->left.lane[1].dist.AsDouble(), ConveyorProp::kItemSpacing);
     }
 
     TEST_F(ConveyorControllerTest, BackItemDistance) {
@@ -442,43 +654,43 @@ namespace jactorio::game
         CreateSegment({0, 0}, up_segment_1);
         CreateSegment({0, 1}, up_segment_2);
 
-        up_segment_2->AppendItem(true, 0.05, itemProto_);
-        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.getAsDouble(), 0.05);
+        up_segment_2->AppendItem(true, proto::LineDistT(0.05), itemProto_);
+        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.AsDouble(), 0.05);
 
         ConveyorLogicUpdate(world_);
-        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.AsDouble(), 0);
 
         // Segment 1
         ConveyorLogicUpdate(world_);
-        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.AsDouble(), 0);
 
-        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.getAsDouble(), 0.95); // First segment now
+        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.AsDouble(), 0.95); // First segment now
 
         for (int i = 0; i < 19; ++i) {
             ConveyorLogicUpdate(world_);
         }
-        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.AsDouble(), 0);
 
         // Remains at 0
         ConveyorLogicUpdate(world_);
-        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.AsDouble(), 0);
 
 
         // ======================================================================
         // Fill the first segment up to 4 items
-        up_segment_1->AppendItem(true, 0, itemProto_);
-        up_segment_1->AppendItem(true, 0, itemProto_);
-        up_segment_1->AppendItem(true, 0, itemProto_);
-        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.getAsDouble(), 0.75);
+        up_segment_1->AppendItem(true, proto::LineDistT(0), itemProto_);
+        up_segment_1->AppendItem(true, proto::LineDistT(0), itemProto_);
+        up_segment_1->AppendItem(true, proto::LineDistT(0), itemProto_);
+        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.AsDouble(), 0.75);
 
 
         // Will not enter since segment 1 is full
-        up_segment_2->AppendItem(true, 0.05, itemProto_);
+        up_segment_2->AppendItem(true, proto::LineDistT(0.05), itemProto_);
         ConveyorLogicUpdate(world_);
         ConveyorLogicUpdate(world_);
         ConveyorLogicUpdate(world_);
-        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.getAsDouble(), 0.75);
-        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(up_segment_1->left.backItemDistance.AsDouble(), 0.75);
+        EXPECT_DOUBLE_EQ(up_segment_2->left.backItemDistance.AsDouble(), 0);
     }
 
 
@@ -505,8 +717,8 @@ namespace jactorio::game
         CreateSegment({3, 0}, segment_2);
 
         // Insert item on left + right side
-        segment_2->AppendItem(true, 0.02f, itemProto_);
-        segment_2->AppendItem(false, 0.02f, itemProto_);
+        segment_2->AppendItem(true, proto::LineDistT(0.02f), itemProto_);
+        segment_2->AppendItem(false, proto::LineDistT(0.02f), itemProto_);
 
         // Travel to the next belt in 0.02 / 0.01 + 1 updates
         for (int i = 0; i < 3; ++i) {
@@ -516,8 +728,8 @@ namespace jactorio::game
         EXPECT_EQ(segment_2->left.lane.size(), 0);
         EXPECT_EQ(segment_2->right.lane.size(), 0);
         // 3.99 tiles from the end of this conveyor
-        EXPECT_DOUBLE_EQ(segment_1->left.lane[0].dist.getAsDouble(), 3.99);
-        EXPECT_DOUBLE_EQ(segment_1->right.lane[0].dist.getAsDouble(), 3.99);
+        EXPECT_DOUBLE_EQ(segment_1->left.lane[0].dist.AsDouble(), 3.99);
+        EXPECT_DOUBLE_EQ(segment_1->right.lane[0].dist.AsDouble(), 3.99);
     }
 
     TEST_F(ConveyorControllerTest, TransitionSideLeft) {
@@ -553,8 +765,8 @@ namespace jactorio::game
 
         // Insert items
         for (int i = 0; i < 3; ++i) {
-            right_segment->AppendItem(true, 0.f, itemProto_);
-            right_segment->AppendItem(false, 0.f, itemProto_);
+            right_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+            right_segment->AppendItem(false, proto::LineDistT(0.f), itemProto_);
         }
 
         // Logic tests
@@ -562,17 +774,17 @@ namespace jactorio::game
 
         // Since the target belt is empty, both A + B inserts into right lane
         EXPECT_EQ(right_segment->left.lane.size(), 2);
-        EXPECT_EQ(right_segment->left.lane[0].dist.getAsDouble(), 0.2); // 0.25 - 0.05
+        EXPECT_EQ(right_segment->left.lane[0].dist.AsDouble(), 0.2); // 0.25 - 0.05
 
         EXPECT_EQ(right_segment->right.lane.size(), 2);
-        EXPECT_EQ(right_segment->right.lane[0].dist.getAsDouble(), 0.2);
+        EXPECT_EQ(right_segment->right.lane[0].dist.AsDouble(), 0.2);
 
 
         ASSERT_EQ(down_segment->right.lane.size(), 2);
         // 10 - 0.7 - 0.05
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.25);
         // (10 - 0.3 - 0.05) - (10 - 0.7 - 0.05)
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.getAsDouble(), 0.4);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.AsDouble(), 0.4);
 
 
         // ======================================================================
@@ -580,28 +792,28 @@ namespace jactorio::game
         for (int j = 0; j < 4; ++j) {
             ConveyorLogicUpdate(world_);
         }
-        EXPECT_EQ(right_segment->left.lane[0].dist.getAsDouble(), 0.0);
-        EXPECT_EQ(right_segment->right.lane[0].dist.getAsDouble(), 0.0);
+        EXPECT_EQ(right_segment->left.lane[0].dist.AsDouble(), 0.0);
+        EXPECT_EQ(right_segment->right.lane[0].dist.AsDouble(), 0.0);
 
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.05);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.05);
 
 
         // ======================================================================
         // Transition items
         ConveyorLogicUpdate(world_);
         EXPECT_EQ(right_segment->left.lane.size(), 1);
-        EXPECT_EQ(right_segment->left.lane[0].dist.getAsDouble(), 0.2); // 0.25 - 0.05
+        EXPECT_EQ(right_segment->left.lane[0].dist.AsDouble(), 0.2); // 0.25 - 0.05
 
 
         // ======================================================================
         // Right lane (B) stops, left (A) takes priority
         EXPECT_EQ(right_segment->right.lane.size(), 2); // Unmoved
-        EXPECT_EQ(right_segment->right.lane[0].dist.getAsDouble(), 0.f);
+        EXPECT_EQ(right_segment->right.lane[0].dist.AsDouble(), 0.f);
 
         ASSERT_EQ(down_segment->right.lane.size(), 3);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.00);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.getAsDouble(), 0.4);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[2].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.00);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.AsDouble(), 0.4);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[2].dist.AsDouble(), 0.25);
 
 
         // ======================================================================
@@ -613,8 +825,8 @@ namespace jactorio::game
         EXPECT_EQ(right_segment->right.lane.size(), 1); // Woke and moved
 
         ASSERT_EQ(down_segment->right.lane.size(), 5);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 8.10);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[3].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 8.10);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[3].dist.AsDouble(), 0.25);
     }
 
     TEST_F(ConveyorControllerTest, TransitionSideRight) {
@@ -651,8 +863,8 @@ namespace jactorio::game
 
         // Insert items
         for (int i = 0; i < 3; ++i) {
-            left_segment->AppendItem(true, 0.f, itemProto_);
-            left_segment->AppendItem(false, 0.f, itemProto_);
+            left_segment->AppendItem(true, proto::LineDistT(0.f), itemProto_);
+            left_segment->AppendItem(false, proto::LineDistT(0.f), itemProto_);
         }
 
         // Logic tests
@@ -660,17 +872,17 @@ namespace jactorio::game
 
         // Since the target belt is empty, both A + B inserts into right lane
         EXPECT_EQ(left_segment->left.lane.size(), 2);
-        EXPECT_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.2); // 0.25 - 0.05
+        EXPECT_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.2); // 0.25 - 0.05
 
         EXPECT_EQ(left_segment->right.lane.size(), 2);
-        EXPECT_EQ(left_segment->right.lane[0].dist.getAsDouble(), 0.2);
+        EXPECT_EQ(left_segment->right.lane[0].dist.AsDouble(), 0.2);
 
 
         ASSERT_EQ(down_segment->right.lane.size(), 2);
         // 10 - 0.7 - 0.05
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.25);
         // (10 - 0.3 - 0.05) - (10 - 0.7 - 0.05)
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.getAsDouble(), 0.4);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.AsDouble(), 0.4);
 
 
         // ======================================================================
@@ -678,28 +890,28 @@ namespace jactorio::game
         for (int j = 0; j < 4; ++j) {
             ConveyorLogicUpdate(world_);
         }
-        EXPECT_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.0);
-        EXPECT_EQ(left_segment->right.lane[0].dist.getAsDouble(), 0.0);
+        EXPECT_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.0);
+        EXPECT_EQ(left_segment->right.lane[0].dist.AsDouble(), 0.0);
 
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.05);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.05);
 
 
         // ======================================================================
         // Transition items
         ConveyorLogicUpdate(world_);
         EXPECT_EQ(left_segment->left.lane.size(), 1);
-        EXPECT_EQ(left_segment->left.lane[0].dist.getAsDouble(), 0.2); // 0.25 - 0.05
+        EXPECT_EQ(left_segment->left.lane[0].dist.AsDouble(), 0.2); // 0.25 - 0.05
 
 
         // ======================================================================
         // Right lane (B) stops, left (A) takes priority
         EXPECT_EQ(left_segment->right.lane.size(), 2); // Unmoved
-        EXPECT_EQ(left_segment->right.lane[0].dist.getAsDouble(), 0.f);
+        EXPECT_EQ(left_segment->right.lane[0].dist.AsDouble(), 0.f);
 
         ASSERT_EQ(down_segment->right.lane.size(), 3);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 9.00);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.getAsDouble(), 0.4);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[2].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 9.00);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[1].dist.AsDouble(), 0.4);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[2].dist.AsDouble(), 0.25);
 
 
         // ======================================================================
@@ -711,8 +923,8 @@ namespace jactorio::game
         EXPECT_EQ(left_segment->right.lane.size(), 1); // Woke and moved
 
         ASSERT_EQ(down_segment->right.lane.size(), 5);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), 8.10);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[3].dist.getAsDouble(), 0.25);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), 8.10);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[3].dist.AsDouble(), 0.25);
     }
 
     TEST_F(ConveyorControllerTest, TransitionSideOnlyToBending) {
@@ -741,14 +953,14 @@ namespace jactorio::game
         // Left lane
 
 
-        down_segment->AppendItem(true, 0, itemProto_);
+        down_segment->AppendItem(true, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(left_segment->right.lane.size(), 1);
 
         // (line offset) - belt speed
-        EXPECT_DOUBLE_EQ(left_segment->right.lane[0].dist.getAsDouble(), (0.3 + 0.7) + 2. - 0.06);
+        EXPECT_DOUBLE_EQ(left_segment->right.lane[0].dist.AsDouble(), (0.3 + 0.7) + 2. - 0.06);
 
 
         // Right lane
@@ -756,13 +968,13 @@ namespace jactorio::game
 
         left_segment->right.lane.clear();
 
-        down_segment->AppendItem(false, 0, itemProto_);
+        down_segment->AppendItem(false, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(left_segment->right.lane.size(), 1);
 
-        EXPECT_DOUBLE_EQ(left_segment->right.lane[0].dist.getAsDouble(), (0.3 + 0.3) + 2. - 0.06);
+        EXPECT_DOUBLE_EQ(left_segment->right.lane[0].dist.AsDouble(), (0.3 + 0.3) + 2. - 0.06);
 
 
         // ======================================================================
@@ -779,13 +991,13 @@ namespace jactorio::game
         // Left lane
 
 
-        up_segment->AppendItem(true, 0, itemProto_);
+        up_segment->AppendItem(true, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(left_segment->left.lane.size(), 1);
 
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.getAsDouble(), (0.7 + 0.3) + 2. - 0.06);
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.AsDouble(), (0.7 + 0.3) + 2. - 0.06);
 
 
         // Right lane
@@ -793,13 +1005,13 @@ namespace jactorio::game
 
         left_segment->left.lane.clear();
 
-        up_segment->AppendItem(false, 0, itemProto_);
+        up_segment->AppendItem(false, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(left_segment->left.lane.size(), 1);
 
-        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.getAsDouble(), (0.7 + 0.7) + 2. - 0.06);
+        EXPECT_DOUBLE_EQ(left_segment->left.lane[0].dist.AsDouble(), (0.7 + 0.7) + 2. - 0.06);
     }
 
     TEST_F(ConveyorControllerTest, TransitionBendingToSideOnly) {
@@ -826,21 +1038,21 @@ namespace jactorio::game
         // ======================================================================
         // Left
 
-        right_segment->AppendItem(true, 0, itemProto_);
+        right_segment->AppendItem(true, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(down_segment->left.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(down_segment->left.lane[0].dist.getAsDouble(), (0.3 + 1. + 0.7) - 0.06);
+        EXPECT_DOUBLE_EQ(down_segment->left.lane[0].dist.AsDouble(), (0.3 + 1. + 0.7) - 0.06);
 
 
         // Right
 
-        right_segment->AppendItem(false, 0, itemProto_);
+        right_segment->AppendItem(false, proto::LineDistT(0), itemProto_);
 
         ConveyorLogicUpdate(world_);
 
         ASSERT_EQ(down_segment->right.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.getAsDouble(), (0.3 + 1. + 0.3) - 0.06);
+        EXPECT_DOUBLE_EQ(down_segment->right.lane[0].dist.AsDouble(), (0.3 + 1. + 0.3) - 0.06);
     }
 } // namespace jactorio::game
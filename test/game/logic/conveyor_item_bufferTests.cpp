@@ -0,0 +1,152 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "game/logic/conveyor_item_buffer.h"
+
+#include <vector>
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    class ConveyorItemBufferTest : public testing::Test
+    {
+    protected:
+        proto::Item item1_;
+        proto::Item item2_;
+        proto::Item item3_;
+
+        ConveyorItemBuffer buffer_;
+
+        /// Distances of each item from front to back, in 1 / 1000 units
+        J_NODISCARD std::vector<int> GetDists() const {
+            std::vector<int> dists;
+            for (const auto& item : buffer_) {
+                dists.push_back(item.dist.Raw());
+            }
+            return dists;
+        }
+    };
+
+    TEST_F(ConveyorItemBufferTest, EmplaceBack) {
+        buffer_.emplace_back(proto::LineDistT(1), &item1_);
+        buffer_.emplace_back(proto::LineDistT(2), &item2_);
+
+        ASSERT_EQ(buffer_.size(), 2);
+        EXPECT_EQ(buffer_.front().dist, proto::LineDistT(1));
+        EXPECT_EQ(buffer_.front().item.Get(), &item1_);
+        EXPECT_EQ(buffer_.back().dist, proto::LineDistT(2));
+        EXPECT_EQ(buffer_.back().item.Get(), &item2_);
+    }
+
+    TEST_F(ConveyorItemBufferTest, ReferenceModifiesBuffer) {
+        buffer_.emplace_back(proto::LineDistT(1), &item1_);
+
+        buffer_[0].dist -= proto::LineDistT(0.25);
+        buffer_[0].item = &item2_;
+
+        EXPECT_EQ(buffer_[0].dist, proto::LineDistT(0.75));
+        EXPECT_EQ(buffer_[0].item.Get(), &item2_);
+    }
+
+    TEST_F(ConveyorItemBufferTest, PopFrontWrapsAround) {
+        // Front repeatedly removed and items added to the back, as conveyors do
+
+        buffer_.reserve(4);
+        const auto capacity = buffer_.capacity();
+
+        for (int i = 0; i < 10; ++i) {
+            buffer_.emplace_back(proto::LineDistT(i), &item1_);
+            if (buffer_.size() == 3) {
+                buffer_.pop_front();
+            }
+        }
+
+        EXPECT_EQ(buffer_.capacity(), capacity); // Never exceeded 3 items, no reallocation
+        EXPECT_EQ(GetDists(), (std::vector<int>{8000, 9000}));
+    }
+
+    TEST_F(ConveyorItemBufferTest, GrowPreservesOrder) {
+        buffer_.emplace_back(proto::LineDistT(1), &item1_);
+        buffer_.emplace_back(proto::LineDistT(2), &item1_);
+        buffer_.pop_front();
+
+        // Head is no longer at index 0 when growing
+        for (int i = 3; i < 10; ++i) {
+            buffer_.emplace_back(proto::LineDistT(i), &item1_);
+        }
+
+        EXPECT_EQ(GetDists(), (std::vector<int>{2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000}));
+    }
+
+    TEST_F(ConveyorItemBufferTest, EmplaceFront) {
+        buffer_.emplace_back(proto::LineDistT(2), &item2_);
+        buffer_.emplace_front(proto::LineDistT(1), &item1_);
+
+        EXPECT_EQ(GetDists(), (std::vector<int>{1000, 2000}));
+        EXPECT_EQ(buffer_.front().item.Get(), &item1_);
+    }
+
+    TEST_F(ConveyorItemBufferTest, Insert) {
+        for (int i = 0; i < 6; ++i) {
+            buffer_.emplace_back(proto::LineDistT(i), &item1_);
+        }
+
+        buffer_.insert(1, proto::LineDistT(0.5), &item2_); // Front half shifted
+        buffer_.insert(6, proto::LineDistT(4.5), &item3_); // Back half shifted
+        buffer_.insert(8, proto::LineDistT(6), &item3_);   // End
+
+        EXPECT_EQ(GetDists(), (std::vector<int>{0, 500, 1000, 2000, 3000, 4000, 4500, 5000, 6000}));
+        EXPECT_EQ(buffer_[1].item.Get(), &item2_);
+        EXPECT_EQ(buffer_[6].item.Get(), &item3_);
+    }
+
+    TEST_F(ConveyorItemBufferTest, Erase) {
+        for (int i = 0; i < 6; ++i) {
+            buffer_.emplace_back(proto::LineDistT(i), &item1_);
+        }
+        buffer_[4].item = &item2_;
+
+        buffer_.erase(1); // Front half shifted
+        buffer_.erase(3); // Back half shifted
+
+        EXPECT_EQ(GetDists(), (std::vector<int>{0, 2000, 3000, 5000}));
+        EXPECT_EQ(buffer_[2].item.Get(), &item1_);
+    }
+
+    TEST_F(ConveyorItemBufferTest, Clear) {
+        buffer_.emplace_back(proto::LineDistT(1), &item1_);
+        buffer_.clear();
+
+        EXPECT_TRUE(buffer_.empty());
+        EXPECT_EQ(buffer_.begin(), buffer_.end());
+    }
+
+    TEST_F(ConveyorItemBufferTest, Reserve) {
+        buffer_.reserve(5);
+        EXPECT_EQ(buffer_.capacity(), 8);
+
+        buffer_.reserve(2); // Does not shrink
+        EXPECT_EQ(buffer_.capacity(), 8);
+    }
+
+    TEST_F(ConveyorItemBufferTest, Serialize) {
+        data::PrototypeManager proto;
+        auto& item = proto.Make<proto::Item>();
+        proto.GenerateRelocationTable();
+        data::active_prototype_manager = &proto;
+
+        buffer_.emplace_back(proto::LineDistT(1), &item);
+        buffer_.emplace_back(proto::LineDistT(2.5), &item);
+        buffer_.pop_front();
+        buffer_.emplace_back(proto::LineDistT(0.25), &item);
+
+        const auto result = TestSerializeDeserialize(buffer_);
+
+        ASSERT_EQ(result.size(), 2);
+        EXPECT_EQ(result[0].dist, proto::LineDistT(2.5));
+        EXPECT_EQ(result[0].item.Get(), &item);
+        EXPECT_EQ(result[1].dist, proto::LineDistT(0.25));
+    }
+} // namespace jactorio::game
@@ -4,6 +4,7 @@
 
 #include "jactorioTests.h"
 
+#include "game/logic/conveyor_active_set.h"
 #include "proto/transport_belt.h"
 
 namespace jactorio::game
@@ -27,15 +28,15 @@ namespace jactorio::game
         // THe entire conveyor is compressed with items, cannot insert
 
         // At spacing of 0.25, 4 items per segment
-        segment_.AppendItem(true, 0., item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
+        segment_.AppendItem(true, proto::LineDistT(0.), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
 
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
-        segment_.AppendItem(true, ConveyorProp::kItemSpacing, item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
+        segment_.AppendItem(true, proto::LineDistT(ConveyorProp::kItemSpacing), item_);
 
         // Location 1.75 tiles from beginning of conveyor is filled
         EXPECT_FALSE(segment_.CanInsert(true, proto::LineDistT(1.75)));
@@ -50,10 +51,10 @@ namespace jactorio::game
         // Insert into a gap between 1 and 1.5
         // Is wide enough for the item (item_width - ConveyorProp::kItemSpacing) to fit there
 
-        segment_.AppendItem(false, 0., item_);
-        segment_.AppendItem(false, 1., item_);
+        segment_.AppendItem(false, proto::LineDistT(0.), item_);
+        segment_.AppendItem(false, proto::LineDistT(1.), item_);
         // Items can be inserted in this 0.5 gap
-        segment_.AppendItem(false, 0.5, item_);
+        segment_.AppendItem(false, proto::LineDistT(0.5), item_);
 
 
         // Overlaps with the item at 1 by 0.01
@@ -75,11 +76,11 @@ namespace jactorio::game
         bool result = segment_.CanInsert(true, offset); // Ok, Offset can be 0, is first item
         EXPECT_TRUE(result);
 
-        segment_.AppendItem(true, 0, item_);
+        segment_.AppendItem(true, proto::LineDistT(0), item_);
         result = segment_.CanInsert(true, offset); // Not ok, offset changed to ConveyorProp::kItemSpacing
         EXPECT_FALSE(result);
 
-        segment_.AppendItem(true, 0, item_);
+        segment_.AppendItem(true, proto::LineDistT(0), item_);
         result = segment_.CanInsert(true, offset); // Not ok, offset changed to ConveyorProp::kItemSpacing
         EXPECT_FALSE(result);
     }
@@ -89,7 +90,7 @@ namespace jactorio::game
         segment_.headOffset = 1;
         const proto::LineDistT offset{0.f};
 
-        segment_.AppendItem(true, 0, item_);
+        segment_.AppendItem(true, proto::LineDistT(0), item_);
         const bool result = segment_.CanInsertAbs(true, offset); // Ok, offset (0) + itemOffset (1) = 1
         EXPECT_TRUE(result);
     }
@@ -102,8 +103,8 @@ namespace jactorio::game
         EXPECT_FALSE(segment_.left.IsActive());
         EXPECT_FALSE(segment_.right.IsActive());
 
-        segment_.AppendItem(false, 0., item_);
-        segment_.AppendItem(true, 0., item_);
+        segment_.AppendItem(false, proto::LineDistT(0.), item_);
+        segment_.AppendItem(true, proto::LineDistT(0.), item_);
 
         // Has items, now active
         EXPECT_TRUE(segment_.left.IsActive());
@@ -120,17 +121,17 @@ namespace jactorio::game
         ConveyorStruct line_segment(Orientation::up, ConveyorStruct::TerminationType::bend_right, 5);
 
         // Offset is from the beginning of the conveyor OR the previous item if it exists
-        line_segment.AppendItem(true, 1.3, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 1.3);
+        line_segment.AppendItem(true, proto::LineDistT(1.3), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 1.3);
 
-        line_segment.AppendItem(true, 1.2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 1.2);
+        line_segment.AppendItem(true, proto::LineDistT(1.2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 1.2);
 
-        line_segment.AppendItem(true, 1.5, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.getAsDouble(), 1.5);
+        line_segment.AppendItem(true, proto::LineDistT(1.5), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.AsDouble(), 1.5);
 
-        line_segment.AppendItem(true, 0.5, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.getAsDouble(), 0.5);
+        line_segment.AppendItem(true, proto::LineDistT(0.5), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.AsDouble(), 0.5);
     }
 
     TEST_F(ConveyorStructTest, AppendItemFirstItem) {
@@ -139,14 +140,16 @@ namespace jactorio::game
 
         ConveyorStruct line_segment(Orientation::up, ConveyorStruct::TerminationType::bend_right, 5);
 
-        line_segment.AppendItem(true, 0, item_); // Ok, Offset can be 0, is first item
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 0);
+        line_segment.AppendItem(true, proto::LineDistT(0), item_); // Ok, Offset can be 0, is first item
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 0);
 
-        line_segment.AppendItem(true, 0, item_); // Not ok, offset changed to ConveyorProp::kItemSpacing
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), ConveyorProp::kItemSpacing);
+        // Not ok, offset changed to ConveyorProp::kItemSpacing
+        line_segment.AppendItem(true, proto::LineDistT(0), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), ConveyorProp::kItemSpacing);
 
-        line_segment.AppendItem(true, 0, item_); // Not ok, offset changed to ConveyorProp::kItemSpacing
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.getAsDouble(), ConveyorProp::kItemSpacing);
+        // Not ok, offset changed to ConveyorProp::kItemSpacing
+        line_segment.AppendItem(true, proto::LineDistT(0), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.AsDouble(), ConveyorProp::kItemSpacing);
     }
 
     TEST_F(ConveyorStructTest, InsertItem) {
@@ -156,31 +159,31 @@ namespace jactorio::game
 
         // Offset is ALWAYS from the beginning of the conveyor
 
-        line_segment.InsertItem(true, 1.2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 1.2); // < 1.2
+        line_segment.InsertItem(true, proto::LineDistT(1.2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 1.2); // < 1.2
 
         // Should be sorted by items closest to the end of the segment
-        line_segment.InsertItem(true, 2.5, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 1.2); // 1.2
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 1.3); // < 2.5
-
-        line_segment.InsertItem(true, 0.5, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 0.5); // < 0.5
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 0.7); // 1.2
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.getAsDouble(), 1.3); // 2.5
-
-        line_segment.InsertItem(true, 0.1, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 0.1); // < 0.1
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 0.4); // 0.5
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.getAsDouble(), 0.7); // 1.2
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.getAsDouble(), 1.3); // 2.5
-
-        line_segment.InsertItem(true, 1.8, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 0.1); // 0.1
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 0.4); // 0.5
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.getAsDouble(), 0.7); // 1.2
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.getAsDouble(), 0.6); // < 1.8
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[4].dist.getAsDouble(), 0.7); // 2.5
+        line_segment.InsertItem(true, proto::LineDistT(2.5), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 1.2); // 1.2
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 1.3); // < 2.5
+
+        line_segment.InsertItem(true, proto::LineDistT(0.5), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 0.5); // < 0.5
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 0.7); // 1.2
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.AsDouble(), 1.3); // 2.5
+
+        line_segment.InsertItem(true, proto::LineDistT(0.1), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 0.1); // < 0.1
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 0.4); // 0.5
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.AsDouble(), 0.7); // 1.2
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.AsDouble(), 1.3); // 2.5
+
+        line_segment.InsertItem(true, proto::LineDistT(1.8), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 0.1); // 0.1
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 0.4); // 0.5
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[2].dist.AsDouble(), 0.7); // 1.2
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[3].dist.AsDouble(), 0.6); // < 1.8
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[4].dist.AsDouble(), 0.7); // 2.5
     }
 
     TEST_F(ConveyorStructTest, InsertItemAbs) {
@@ -190,12 +193,12 @@ namespace jactorio::game
 
         // Offset is ALWAYS from the beginning of the conveyor + itemOffset
 
-        line_segment.InsertItemAbs(true, 1.2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 3.2);
+        line_segment.InsertItemAbs(true, proto::LineDistT(1.2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 3.2);
 
-        line_segment.InsertItemAbs(true, 1.5, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 3.2);
-        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 0.3); // 1.5
+        line_segment.InsertItemAbs(true, proto::LineDistT(1.5), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 3.2);
+        EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 0.3); // 1.5
     }
 
     TEST_F(ConveyorStructTest, TryInsertItem) {
@@ -203,13 +206,13 @@ namespace jactorio::game
 
         // Offset is ALWAYS from the beginning of the conveyor
         {
-            const bool result = line_segment.TryInsertItem(true, 1.2, item_);
+            const bool result = line_segment.TryInsertItem(true, proto::LineDistT(1.2), item_);
             ASSERT_TRUE(result);
-            EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 1.2);
+            EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 1.2);
         }
         {
             // Too close
-            const bool result = line_segment.TryInsertItem(true, 1.3, item_);
+            const bool result = line_segment.TryInsertItem(true, proto::LineDistT(1.3), item_);
             ASSERT_FALSE(result);
         }
 
@@ -218,10 +221,10 @@ namespace jactorio::game
         line_segment.left.index = 999;
 
         {
-            const bool result = line_segment.TryInsertItem(true, 0.5, item_);
+            const bool result = line_segment.TryInsertItem(true, proto::LineDistT(0.5), item_);
             ASSERT_TRUE(result);
-            EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.getAsDouble(), 0.5);
-            EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.getAsDouble(), 0.7); // 1.2
+            EXPECT_DOUBLE_EQ(line_segment.left.lane[0].dist.AsDouble(), 0.5);
+            EXPECT_DOUBLE_EQ(line_segment.left.lane[1].dist.AsDouble(), 0.7); // 1.2
         }
 
         EXPECT_EQ(line_segment.left.index, 0);
@@ -230,69 +233,69 @@ namespace jactorio::game
     TEST_F(ConveyorStructTest, BackItemDistanceLeft) {
         ConveyorStruct line_segment(Orientation::up, ConveyorStruct::TerminationType::bend_right, 5);
 
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 0);
 
 
         // Appending
-        line_segment.AppendItem(true, 1.2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 1.2);
+        line_segment.AppendItem(true, proto::LineDistT(1.2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 1.2);
 
-        line_segment.AppendItem(true, 3, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 4.2);
+        line_segment.AppendItem(true, proto::LineDistT(3), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 4.2);
 
-        line_segment.AppendItem(true, 1.8, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 6);
+        line_segment.AppendItem(true, proto::LineDistT(1.8), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 6);
 
         // Inserting (Starting at 6.f)
-        line_segment.InsertItem(true, 7, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 7);
+        line_segment.InsertItem(true, proto::LineDistT(7), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 7);
 
-        line_segment.InsertItem(true, 2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 7); // Unchanged
+        line_segment.InsertItem(true, proto::LineDistT(2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 7); // Unchanged
 
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 0);
     }
 
     TEST_F(ConveyorStructTest, BackItemDistanceRight) {
         ConveyorStruct line_segment(Orientation::up, ConveyorStruct::TerminationType::bend_right, 5);
 
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 0.);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 0.);
 
 
         // Appending
-        line_segment.AppendItem(false, 1.2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 1.2);
+        line_segment.AppendItem(false, proto::LineDistT(1.2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 1.2);
 
-        line_segment.AppendItem(false, 3, item_);
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 4.2);
+        line_segment.AppendItem(false, proto::LineDistT(3), item_);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 4.2);
 
-        line_segment.AppendItem(false, 1.8, item_);
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 6);
+        line_segment.AppendItem(false, proto::LineDistT(1.8), item_);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 6);
 
         // Inserting (Starting at 6.f)
-        line_segment.InsertItem(false, 7, item_);
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 7);
+        line_segment.InsertItem(false, proto::LineDistT(7), item_);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 7);
 
-        line_segment.InsertItem(false, 2, item_);
-        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.getAsDouble(), 7); // Unchanged
+        line_segment.InsertItem(false, proto::LineDistT(2), item_);
+        EXPECT_DOUBLE_EQ(line_segment.right.backItemDistance.AsDouble(), 7); // Unchanged
 
-        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(line_segment.left.backItemDistance.AsDouble(), 0);
     }
 
     TEST_F(ConveyorStructTest, GetOffsetAbs) {
         {
             segment_.headOffset = 0;
 
-            ConveyorStruct::FloatOffsetT o = 3;
+            proto::LineDistT o(3);
             segment_.GetOffsetAbs(o);
-            EXPECT_DOUBLE_EQ(o, 3.);
+            EXPECT_EQ(o, proto::LineDistT(3));
         }
         {
             segment_.headOffset = 3;
 
-            ConveyorStruct::FloatOffsetT o = 3;
+            proto::LineDistT o(3);
             segment_.GetOffsetAbs(o);
-            EXPECT_DOUBLE_EQ(o, 0.);
+            EXPECT_EQ(o, proto::LineDistT(0));
         }
 
         {
@@ -307,40 +310,154 @@ namespace jactorio::game
     TEST_F(ConveyorStructTest, GetItem) {
         auto get_item = [&]() { // true is an item is found
             // Valid range is 1.3 and 1.7 inclusive
-            return segment_.GetItem(true, 1.5).second.item != nullptr;
+            return segment_.GetItem(true, proto::LineDistT(1.5)).second.item != nullptr;
         };
 
-        segment_.AppendItem(true, 0.5, item_);
-        segment_.AppendItem(true, 0.5, item_);  // 1.00
-        segment_.AppendItem(true, 0.29, item_); // 1.29
+        segment_.AppendItem(true, proto::LineDistT(0.5), item_);
+        segment_.AppendItem(true, proto::LineDistT(0.5), item_);  // 1.00
+        segment_.AppendItem(true, proto::LineDistT(0.29), item_); // 1.29
         EXPECT_FALSE(get_item());
 
-        segment_.AppendItem(true, 0.42, item_); // 1.71
+        segment_.AppendItem(true, proto::LineDistT(0.42), item_); // 1.71
         EXPECT_FALSE(get_item());
     }
 
     TEST_F(ConveyorStructTest, TryPopItem) {
-        EXPECT_EQ(segment_.TryPopItem(true, 0.25), nullptr);
-        EXPECT_EQ(segment_.TryPopItem(false, 0.25), nullptr);
+        EXPECT_EQ(segment_.TryPopItem(true, proto::LineDistT(0.25)), nullptr);
+        EXPECT_EQ(segment_.TryPopItem(false, proto::LineDistT(0.25)), nullptr);
 
         // Pop off appended item
-        segment_.AppendItem(true, 0.3, item_);
+        segment_.AppendItem(true, proto::LineDistT(0.3), item_);
 
-        EXPECT_EQ(segment_.TryPopItem(true, 0.4, 0.1), &item_);
+        EXPECT_EQ(segment_.TryPopItem(true, proto::LineDistT(0.4), proto::LineDistT(0.1)), &item_);
         ASSERT_TRUE(segment_.left.lane.empty());
 
         //
 
         proto::Item item2;
-        segment_.AppendItem(true, 0.1, item_);
-        segment_.AppendItem(true, 0.8, item2); // 0.9
-        segment_.AppendItem(true, 0.9, item_); // 1.8
+        segment_.AppendItem(true, proto::LineDistT(0.1), item_);
+        segment_.AppendItem(true, proto::LineDistT(0.8), item2); // 0.9
+        segment_.AppendItem(true, proto::LineDistT(0.9), item_); // 1.8
 
-        EXPECT_EQ(segment_.TryPopItem(true, 0.9, 0.7), &item2);
+        EXPECT_EQ(segment_.TryPopItem(true, proto::LineDistT(0.9), proto::LineDistT(0.7)), &item2);
         ASSERT_EQ(segment_.left.lane.size(), 2);
 
         // Should preserve spacing
-        EXPECT_DOUBLE_EQ(segment_.left.lane[1].dist.getAsDouble(), 1.7);
+        EXPECT_DOUBLE_EQ(segment_.left.lane[1].dist.AsDouble(), 1.7);
+    }
+
+    TEST_F(ConveyorStructTest, WakeAppendsToWakeList) {
+        ConveyorWakeList wake_list;
+
+        segment_.ResetSleep(3);
+        EXPECT_EQ(segment_.GetLogicIndex(), 3);
+
+        segment_.Wake(); // Not sleeping, no effect
+        EXPECT_TRUE(wake_list.Take().empty());
+
+        segment_.Sleep(wake_list);
+        EXPECT_TRUE(segment_.IsSleeping());
+
+        segment_.AppendItem(true, proto::LineDistT(0.3), item_);
+        EXPECT_FALSE(segment_.IsSleeping());
+
+        segment_.Wake(); // Already woken, not appended twice
+        const auto woken = wake_list.Take();
+        ASSERT_EQ(woken.size(), 1);
+        EXPECT_EQ(woken[0].conveyor, &segment_);
+        EXPECT_EQ(woken[0].logicIndex, 3);
+
+        EXPECT_TRUE(wake_list.Take().empty());
+    }
+
+    TEST_F(ConveyorStructTest, WakeFailedInsertion) {
+        // Failing to insert or pop does not change the conveyor, remains asleep
+        ConveyorWakeList wake_list;
+
+        segment_.AppendItem(true, proto::LineDistT(0), item_);
+        segment_.Sleep(wake_list);
+
+        EXPECT_FALSE(segment_.TryInsertItem(true, proto::LineDistT(0.1), item_));
+        EXPECT_EQ(segment_.TryPopItem(true, proto::LineDistT(1.5), proto::LineDistT(0.1)), nullptr);
+        EXPECT_TRUE(segment_.IsSleeping());
+
+        EXPECT_EQ(segment_.TryPopItem(true, proto::LineDistT(0)), &item_);
+        EXPECT_FALSE(segment_.IsSleeping());
+    }
+
+    TEST_F(ConveyorStructTest, WakeFeeders) {
+        ConveyorWakeList wake_list;
+        ConveyorStruct feeder{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+
+        feeder.Sleep(wake_list);
+        segment_.AddSleepingFeeder(feeder);
+        segment_.AddSleepingFeeder(feeder); // Added once only
+
+        segment_.WakeFeeders();
+        EXPECT_FALSE(feeder.IsSleeping());
+        EXPECT_EQ(wake_list.Take().size(), 1);
+
+        // Feeders were cleared
+        feeder.Sleep(wake_list);
+        segment_.WakeFeeders();
+        EXPECT_TRUE(feeder.IsSleeping());
+    }
+
+    TEST_F(ConveyorStructTest, WakeListOrderedByLogicIndex) {
+        ConveyorWakeList wake_list;
+        ConveyorStruct other{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+
+        segment_.ResetSleep(5);
+        other.ResetSleep(2);
+        segment_.Sleep(wake_list);
+        other.Sleep(wake_list);
+
+        segment_.Wake();
+        other.Wake();
+
+        const auto woken = wake_list.Take();
+        ASSERT_EQ(woken.size(), 2);
+        EXPECT_EQ(woken[0].conveyor, &other);
+        EXPECT_EQ(woken[1].conveyor, &segment_);
+    }
+
+    TEST_F(ConveyorStructTest, LeaveSleepingFeeders) {
+        ConveyorWakeList wake_list;
+        ConveyorStruct feeder{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+
+        feeder.Sleep(wake_list);
+        segment_.AddSleepingFeeder(feeder);
+
+        feeder.LeaveSleepingFeeders();
+        segment_.WakeFeeders();
+        EXPECT_TRUE(feeder.IsSleeping());
+
+        // Can be added to another conveyor afterwards
+        ConveyorStruct other{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+        other.AddSleepingFeeder(feeder);
+        other.WakeFeeders();
+        EXPECT_FALSE(feeder.IsSleeping());
+    }
+
+    TEST_F(ConveyorStructTest, DestroySleepingFeeder) {
+        ConveyorWakeList wake_list;
+        {
+            ConveyorStruct feeder{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+            feeder.Sleep(wake_list);
+            segment_.AddSleepingFeeder(feeder);
+        }
+        segment_.WakeFeeders(); // Destroyed feeder was removed
+        EXPECT_TRUE(wake_list.Take().empty());
+
+        ConveyorStruct feeder{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+        {
+            ConveyorStruct target{Orientation::left, ConveyorStruct::TerminationType::straight, 1};
+            feeder.Sleep(wake_list);
+            target.AddSleepingFeeder(feeder);
+        }
+        segment_.AddSleepingFeeder(feeder); // No longer held by destroyed target
+        segment_.WakeFeeders();
+        EXPECT_FALSE(feeder.IsSleeping());
     }
 
     TEST_F(ConveyorStructTest, Serialize) {
@@ -351,13 +468,13 @@ namespace jactorio::game
         auto segment =
             std::make_unique<ConveyorStruct>(Orientation::down, ConveyorStruct::TerminationType::bend_left, 4);
 
-        segment->AppendItem(true, 0.43, item);
-        segment->AppendItem(true, 0.43, item);
+        segment->AppendItem(true, proto::LineDistT(0.43), item);
+        segment->AppendItem(true, proto::LineDistT(0.43), item);
         segment->left.backItemDistance = 65.456;
         segment->left.index            = 40;
         segment->left.visible          = true;
 
-        segment->AppendItem(false, 0.223, item);
+        segment->AppendItem(false, proto::LineDistT(0.223), item);
         segment->right.index            = 50;
         segment->right.backItemDistance = 23.456;
         segment->right.visible          = false;
@@ -374,22 +491,22 @@ namespace jactorio::game
         EXPECT_EQ(result->length, 4);
 
         auto& l_lane = result->left;
-        EXPECT_DOUBLE_EQ(l_lane.backItemDistance.getAsDouble(), 65.456);
+        EXPECT_DOUBLE_EQ(l_lane.backItemDistance.AsDouble(), 65.456);
         EXPECT_EQ(l_lane.index, 40);
         EXPECT_TRUE(l_lane.visible);
 
         ASSERT_EQ(l_lane.lane.size(), 2);
-        EXPECT_DOUBLE_EQ(l_lane.lane[0].dist.getAsDouble(), 0.43);
+        EXPECT_DOUBLE_EQ(l_lane.lane[0].dist.AsDouble(), 0.43);
         EXPECT_EQ(l_lane.lane[0].item, &item);
 
 
         auto& r_lane = result->right;
-        EXPECT_DOUBLE_EQ(r_lane.backItemDistance.getAsDouble(), 23.456);
+        EXPECT_DOUBLE_EQ(r_lane.backItemDistance.AsDouble(), 23.456);
         EXPECT_EQ(r_lane.index, 50);
         EXPECT_FALSE(r_lane.visible);
 
         ASSERT_EQ(r_lane.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(r_lane.lane[0].dist.getAsDouble(), 0.223);
+        EXPECT_DOUBLE_EQ(r_lane.lane[0].dist.AsDouble(), 0.223);
         EXPECT_EQ(r_lane.lane[0].item, &item);
     }
 } // namespace jactorio::game
@@ -17,14 +17,18 @@ namespace jactorio::game
     class ConveyorUtilityTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         /// Logic group chosen for the tests
         static constexpr LogicGroup kLogicGroup_ = LogicGroup::splitter;
 
         World world_;
-        proto::TransportBelt transBelt_;
+        proto::TransportBelt& transBelt_ = proto_.Make<proto::TransportBelt>();
         proto::Sprite sprite_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
 
             // Conveyor utility requires tex coord id when setting up conveyor
@@ -40,7 +44,7 @@ namespace jactorio::game
     }
 
     TEST_F(ConveyorUtilityTest, GetConveyorDataSplitter) {
-        proto::Splitter splitter;
+        auto& splitter = proto_.Make<proto::Splitter>();
         splitter.SetWidth(2);
 
         auto& splitter_data = TestSetupBlankSplitter(world_, {0, 0}, Orientation::up, splitter);
@@ -50,7 +54,7 @@ namespace jactorio::game
     }
 
     TEST_F(ConveyorUtilityTest, GetConveyorDataSplitterInverted) {
-        proto::Splitter splitter;
+        auto& splitter = proto_.Make<proto::Splitter>();
         splitter.SetWidth(2);
 
         auto& splitter_data = TestSetupBlankSplitter(world_, {0, 0}, Orientation::left, splitter);
@@ -76,7 +80,7 @@ namespace jactorio::game
 
     /// Should gracefully handle entity not a conveyor struct
     TEST_F(ConveyorUtilityTest, ConnectUpNonStruct) {
-        const proto::ContainerEntity container_proto;
+        const auto& container_proto = proto_.Make<proto::ContainerEntity>();
 
         TestSetupContainer(world_, {0, 0}, Orientation::up, container_proto);
         TestSetupConveyor(world_, {0, 1}, Orientation::up, transBelt_);
@@ -282,11 +286,17 @@ namespace jactorio::game
     class ConveyorGroupingTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         /// Logic group chosen for the tests
         static constexpr LogicGroup kLogicGroup_ = LogicGroup::splitter;
 
         World world_;
-        proto::TransportBelt transBelt_;
+        proto::TransportBelt& transBelt_ = proto_.Make<proto::TransportBelt>();
+
+        void SetUp() override {
+            data::active_prototype_manager = &proto_;
+        }
 
         /// Checks if conveyor at current coords with current_direction
         /// grouped with other conveyor at other_coord with other_direction
@@ -428,10 +438,11 @@ namespace jactorio::game
         EXPECT_EQ(behind_con_data->structure->length, 1);
         EXPECT_EQ(behind_con_data->structure->terminationType, ConveyorStruct::TerminationType::straight);
 
-        EXPECT_EQ(world_.LogicGet(kLogicGroup_).size(), 2);
-        // Ensure not unregister the wrong one
-        EXPECT_EQ(world_.LogicGet(kLogicGroup_)[0].coord, WorldCoord(2, 0)); // Oldest
-        EXPECT_EQ(world_.LogicGet(kLogicGroup_)[1].coord, WorldCoord(0, 0));
+        auto& logic_list = world_.LogicGet(kLogicGroup_);
+        ASSERT_EQ(logic_list.size(), 2);
+        // Ensure not unregister the wrong one, removal moves the last object into the gap
+        EXPECT_EQ(logic_list[0].coord, WorldCoord(0, 0));
+        EXPECT_EQ(logic_list[1].coord, WorldCoord(2, 0));
     }
 
     /// Removing middle of grouped conveyor segment
@@ -572,9 +583,13 @@ namespace jactorio::game
     class ConveyorCalcLineOrienTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
 
@@ -603,7 +618,7 @@ namespace jactorio::game
         }
 
     private:
-        proto::TransportBelt lineProto_;
+        proto::TransportBelt& lineProto_ = proto_.Make<proto::TransportBelt>();
 
         proto::ConveyorData& BuildConveyor(const WorldCoord coord, const Orientation direction) {
             auto* tile = world_.GetTile(coord, TileLayer::entity);
@@ -133,6 +133,75 @@ namespace jactorio::game
         }
     }
 
+    TEST_F(DeferralTimerTest, RegisterFarFuture) {
+        // Moved down levels of the timing wheel as game tick approaches
+        const GameTickT due_ticks[] = {255, 256, 300, 65535, 65536, 70000, 16777216, 4294967296 + 5};
+
+        for (const auto due_tick : due_ticks) {
+            const MockDeferred deferred;
+            DeferralTimer timer;
+            timer.RegisterAtTick(deferred, nullptr, due_tick);
+
+            timer.DeferralUpdate(logic_, world_, due_tick - 1);
+            EXPECT_FALSE(deferred.callbackCalled) << due_tick;
+
+            timer.DeferralUpdate(logic_, world_, due_tick);
+            EXPECT_TRUE(deferred.callbackCalled) << due_tick;
+        }
+    }
+
+    TEST_F(DeferralTimerTest, SkippedTicksCalled) {
+        const MockDeferred deferred;
+        timer_.RegisterAtTick(deferred_, nullptr, 2);
+        timer_.RegisterAtTick(deferred, nullptr, 600);
+
+        logic_.DeferralUpdate(world_, 1000);
+        EXPECT_TRUE(deferred_.callbackCalled);
+        EXPECT_TRUE(deferred.callbackCalled);
+    }
+
+    TEST_F(DeferralTimerTest, RemoveDeferralReusedSlot) {
+        const MockDeferred deferred;
+
+        const auto entry = timer_.RegisterAtTick(deferred_, nullptr, 2);
+        timer_.RemoveDeferral(entry);
+
+        // Slot of removed callback reused, entry must no longer remove it
+        const auto entry_2 = timer_.RegisterAtTick(deferred, nullptr, 2);
+        EXPECT_NE(entry.callbackIndex, entry_2.callbackIndex);
+
+        timer_.RemoveDeferral(entry);
+
+        logic_.DeferralUpdate(world_, 2);
+        EXPECT_TRUE(deferred.callbackCalled);
+    }
+
+    TEST_F(DeferralTimerTest, RemoveDeferralDuringCallback) {
+        class RemovingDeferred final : public TestMockEntity
+        {
+        public:
+            mutable DeferralTimer::DeferralEntry removeEntry;
+
+            void OnDeferTimeElapsed(World& /*world*/,
+                                    Logic& logic,
+                                    proto::UniqueDataBase* /*unique_data*/) const override {
+                logic.deferralTimer.RemoveDeferralEntry(removeEntry);
+            }
+        };
+
+        // Ordered by prototype id when called, remover is called first
+        RemovingDeferred remover;
+        remover.internalId = 1;
+        deferred_.internalId = 2;
+
+        remover.removeEntry = timer_.RegisterAtTick(deferred_, nullptr, 2);
+        timer_.RegisterAtTick(remover, nullptr, 2);
+
+        logic_.DeferralUpdate(world_, 2);
+        EXPECT_FALSE(deferred_.callbackCalled);
+        EXPECT_TRUE(timer_.GetDebugInfo().callbacks.empty());
+    }
+
     TEST_F(DeferralTimerTest, SerializeDeferralEntry) {
         const DeferralTimer::DeferralEntry entry{32, 123};
 
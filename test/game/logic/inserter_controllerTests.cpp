@@ -14,15 +14,19 @@ namespace jactorio::game
     class InserterControllerTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
         Logic logic_;
 
-        proto::Inserter inserterProto_;
+        proto::Inserter& inserterProto_ = proto_.Make<proto::Inserter>();
 
-        proto::ContainerEntity containerProto_;
+        proto::ContainerEntity& containerProto_ = proto_.Make<proto::ContainerEntity>();
         proto::Item containerItemProto_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
 
@@ -98,7 +102,7 @@ namespace jactorio::game
         }
         EXPECT_EQ(dropoff->inventory[0].count, 11);
         EXPECT_EQ(inserter_data->status, proto::InserterData::Status::pickup);
-        EXPECT_DOUBLE_EQ(inserter_data->rotationDegree.getAsDouble(), 0);
+        EXPECT_DOUBLE_EQ(inserter_data->rotationDegree.AsDouble(), 0);
 
 
         // Return to pickup location after 86 updates, pick up item, set status to dropoff
@@ -115,7 +119,7 @@ namespace jactorio::game
 
         // Setup conveyor segment
         proto::Item item;
-        proto::TransportBelt segment_proto;
+        auto& segment_proto = proto_.Make<proto::TransportBelt>();
 
         auto dropoff =
             std::make_shared<ConveyorStruct>(Orientation::left, ConveyorStruct::TerminationType::straight, 2);
@@ -127,7 +131,7 @@ namespace jactorio::game
         TestCreateConveyorSegment(world_, {1, 2}, pickup, segment_proto);
 
         for (int i = 0; i < 1000; ++i) {
-            pickup->AppendItem(false, 0, item);
+            pickup->AppendItem(false, proto::LineDistT(0), item);
         }
 
 
@@ -166,7 +170,7 @@ namespace jactorio::game
         // Inserter will not pick up items that it can never drop off
 
         // Cannot drop into assembly machine since it has no recipe
-        proto::AssemblyMachine asm_machine;
+        auto& asm_machine = proto_.Make<proto::AssemblyMachine>();
         TestSetupAssemblyMachine(world_, {0, 1}, Orientation::up, asm_machine);
 
         auto* pickup = BuildChest({3, 2}, Orientation::right, 10);
@@ -16,10 +16,14 @@ namespace jactorio::game
     class ItemLogisticsTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
         Logic logic_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
     };
@@ -29,7 +33,7 @@ namespace jactorio::game
 
         auto* tile = world_.GetTile({2, 4}, TileLayer::entity);
 
-        proto::ContainerEntity container;
+        auto& container = proto_.Make<proto::ContainerEntity>();
         tile->SetPrototype(Orientation::up, &container);
         tile->MakeUniqueData<proto::ContainerEntityData>(1);
 
@@ -40,8 +44,8 @@ namespace jactorio::game
     }
 
     TEST_F(ItemLogisticsTest, DropOffDropItem) {
-        proto::ContainerEntity container_entity;
-        auto& container_layer = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
+        auto& container_entity = proto_.Make<proto::ContainerEntity>();
+        auto& container_layer  = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
 
         ItemDropOff drop_off{Orientation::up};
         ASSERT_TRUE(drop_off.Initialize(world_, {2, 4}));
@@ -53,8 +57,8 @@ namespace jactorio::game
     }
 
     TEST_F(ItemLogisticsTest, InserterPickupItem) {
-        proto::ContainerEntity container_entity;
-        auto& container_layer = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
+        auto& container_entity = proto_.Make<proto::ContainerEntity>();
+        auto& container_layer  = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
 
         InserterPickup pickup{Orientation::up};
         ASSERT_TRUE(pickup.Initialize(world_, {2, 4}));
@@ -75,12 +79,16 @@ namespace jactorio::game
     {
     public:
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
 
         explicit ItemDropOffTest() : ItemDropOff(Orientation::up) {}
 
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
         Logic logic_;
 
@@ -116,7 +124,7 @@ namespace jactorio::game
 
 
         // Ok: Transport belt can be inserted onto
-        proto::TransportBelt belt;
+        auto& belt = proto_.Make<proto::TransportBelt>();
         set_prototype(belt);
 
         EXPECT_TRUE(this->Initialize(world_, {2, 4}));
@@ -124,7 +132,7 @@ namespace jactorio::game
 
 
         // No: Mining drill
-        proto::MiningDrill drill;
+        auto& drill = proto_.Make<proto::MiningDrill>();
         set_prototype(drill);
 
         EXPECT_FALSE(this->Initialize(world_, {2, 4}));
@@ -132,7 +140,7 @@ namespace jactorio::game
 
 
         // Ok: Container
-        proto::ContainerEntity container;
+        auto& container = proto_.Make<proto::ContainerEntity>();
         set_prototype(container);
 
         EXPECT_TRUE(this->Initialize(world_, {2, 4}));
@@ -140,7 +148,8 @@ namespace jactorio::game
 
 
         // Ok: Assembly machine
-        proto::AssemblyMachine assembly_machine; // Will also make unique data, so it needs to be on another tile
+        // Will also make unique data, so it needs to be on another tile
+        auto& assembly_machine = proto_.Make<proto::AssemblyMachine>();
         assembly_machine.SetDimension({2, 2});
         TestSetupAssemblyMachine(world_, {3, 4}, Orientation::up, assembly_machine);
 
@@ -176,7 +185,7 @@ namespace jactorio::game
 
         ConveyorInsert(Orientation::up, line_data);
         ASSERT_EQ(line_data.structure->right.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(line_data.structure->right.lane[0].dist.getAsDouble(), 1.5);
+        EXPECT_DOUBLE_EQ(line_data.structure->right.lane[0].dist.AsDouble(), 1.5);
     }
 
     TEST_F(ItemDropOffTest, InsertConveyorUp) {
@@ -310,7 +319,7 @@ namespace jactorio::game
 
         ConveyorInsert(Orientation::up, left);
         ASSERT_EQ(left.structure->left.lane.size(), 1);
-        EXPECT_DOUBLE_EQ(left.structure->left.lane[0].dist.getAsDouble(), 0.5 + 0.7);
+        EXPECT_DOUBLE_EQ(left.structure->left.lane[0].dist.AsDouble(), 0.5 + 0.7);
     }
 
     TEST_F(ItemDropOffTest, InsertAssemblyMachine) {
@@ -326,8 +335,8 @@ namespace jactorio::game
 
 
         // Needs prototype data to register crafting callback
-        proto::AssemblyMachine assembly_machine;
-        targetProtoData_ = &assembly_machine;
+        auto& assembly_machine = proto_.Make<proto::AssemblyMachine>();
+        targetProtoData_       = &assembly_machine;
 
         // Orientation doesn't matter
         EXPECT_TRUE(InsertAssemblyMachine({logic_, {recipe_pack.item2, 10}, asm_data, Orientation::up}));
@@ -398,14 +407,18 @@ namespace jactorio::game
         explicit InserterPickupTest() : InserterPickup(Orientation::up) {}
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
 
     protected:
+        data::PrototypeManager proto_;
+
         World world_;
         Logic logic_;
 
-        proto::Inserter inserterProto_;
+        proto::Inserter& inserterProto_ = proto_.Make<proto::Inserter>();
 
         /// Item which will be on conveyor segments from CreateConveyor
         proto::Item lineItem_;
@@ -416,8 +429,8 @@ namespace jactorio::game
             const auto segment =
                 std::make_shared<ConveyorStruct>(orientation, ConveyorStruct::TerminationType::straight, 2);
 
-            segment->InsertItem(false, 0.5, lineItem_);
-            segment->InsertItem(true, 0.5, lineItem_);
+            segment->InsertItem(false, proto::LineDistT(0.5), lineItem_);
+            segment->InsertItem(true, proto::LineDistT(0.5), lineItem_);
 
             return proto::ConveyorData{segment};
         }
@@ -452,7 +465,7 @@ namespace jactorio::game
 
 
         // Ok: Transport belt can be picked up from
-        proto::TransportBelt belt;
+        auto& belt = proto_.Make<proto::TransportBelt>();
         set_prototype(belt);
 
         EXPECT_TRUE(this->Initialize(world_, {2, 4}));
@@ -460,7 +473,7 @@ namespace jactorio::game
 
 
         // No: Mining drill
-        proto::MiningDrill drill;
+        auto& drill = proto_.Make<proto::MiningDrill>();
         set_prototype(drill);
 
         EXPECT_FALSE(this->Initialize(world_, {2, 4}));
@@ -468,7 +481,7 @@ namespace jactorio::game
 
 
         // Ok: Container
-        proto::ContainerEntity container;
+        auto& container = proto_.Make<proto::ContainerEntity>();
         set_prototype(container);
 
         EXPECT_TRUE(this->Initialize(world_, {2, 4}));
@@ -476,7 +489,7 @@ namespace jactorio::game
 
 
         // Ok: Assembly machine
-        proto::AssemblyMachine assembly_machine;
+        auto& assembly_machine = proto_.Make<proto::AssemblyMachine>();
         assembly_machine.SetDimension({2, 2});
         TestSetupAssemblyMachine(world_, {3, 4}, Orientation::up, assembly_machine);
 
@@ -486,9 +499,9 @@ namespace jactorio::game
     }
 
     TEST_F(InserterPickupTest, PickupContainerEntity) {
-        proto::ContainerEntity container_entity;
-        auto& container_layer = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
-        auto& container_data  = *container_layer.GetUniqueData();
+        auto& container_entity = proto_.Make<proto::ContainerEntity>();
+        auto& container_layer  = TestSetupContainer(world_, {2, 4}, Orientation::up, container_entity);
+        auto& container_data   = *container_layer.GetUniqueData();
 
         proto::Item item;
         auto& inv = container_layer.GetUniqueData<proto::ContainerEntityData>()->inventory;
@@ -641,11 +654,11 @@ namespace jactorio::game
 
         const proto::Item item;
 
-        left->AppendItem(true, 0.5 + 0.7, item);
+        left->AppendItem(true, proto::LineDistT(0.5 + 0.7), item);
         PickupLine(Orientation::up, line);
         EXPECT_EQ(left->left.lane.size(), 0);
 
-        left->AppendItem(false, 0.5 + 0.3, item);
+        left->AppendItem(false, proto::LineDistT(0.5 + 0.3), item);
         PickupLine(Orientation::up, line);
         EXPECT_EQ(left->right.lane.size(), 0);
     }
@@ -680,9 +693,9 @@ namespace jactorio::game
     TEST_F(InserterPickupTest, PickupAssemblyMachine) {
         data::PrototypeManager proto;
 
-        proto::AssemblyMachine asm_machine;
-        auto& tile = TestSetupAssemblyMachine(world_, {0, 0}, Orientation::up, asm_machine);
-        auto* data = tile.GetUniqueData<proto::AssemblyMachineData>();
+        auto& asm_machine = proto_.Make<proto::AssemblyMachine>();
+        auto& tile        = TestSetupAssemblyMachine(world_, {0, 0}, Orientation::up, asm_machine);
+        auto* data        = tile.GetUniqueData<proto::AssemblyMachineData>();
 
         // Does nothing as there is no recipe yet
         PickupAssemblyMachine({logic_, 2, proto::RotationDegreeT(kMaxInserterDegree), 2, *data, Orientation::up});
@@ -53,16 +53,19 @@ namespace jactorio::game
         Logic logic;
         World world;
 
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
         // Create entity
         proto::Item item;
         proto::Item item_no_entity; // Does not hold an entity reference
 
-        proto::ContainerEntity entity;
+        auto& entity     = proto.Make<proto::ContainerEntity>();
         entity.placeable = true;
         entity.SetItem(&item);
 
 
-        proto::Tile tile_proto;
+        auto& tile_proto   = proto.Make<proto::Tile>();
         tile_proto.isWater = false;
 
         // Create world with entity at 0, 0
@@ -109,9 +112,13 @@ namespace jactorio::game
     class PlayerPlacementTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         /// Fills chunk with buildable tile
         /// Sets up item and container_
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             auto& chunk = world_.EmplaceChunk({0, 0});
 
             container_.SetItem(&item_);
@@ -129,11 +136,11 @@ namespace jactorio::game
         World world_;
 
         /// Tile making up the chunk 0, 0
-        proto::Tile tile_;
+        proto::Tile& tile_ = proto_.Make<proto::Tile>();
 
         /// Item for container_
         proto::Item item_;
-        proto::ContainerEntity container_;
+        proto::ContainerEntity& container_ = proto_.Make<proto::ContainerEntity>();
         proto::Sprite sprite_;
     };
 
@@ -246,20 +253,20 @@ namespace jactorio::game
 
     TEST_F(PlayerPlacementTest, PickupResource) {
         proto::Item item;
-        proto::ResourceEntity resource;
+        auto& resource      = proto_.Make<proto::ResourceEntity>();
         resource.pickupTime = 3.f;
         resource.SetItem(&item);
 
         auto* tile = world_.GetTile({0, 0}, TileLayer::resource);
         tile->SetPrototype(Orientation::up, &resource);
-        auto& resource_data = tile->MakeUniqueData<proto::ResourceEntityData>(2);
+        *world_.GetResourceAmount({0, 0}) = 2;
         world_.SetTexCoordId({0, 0}, TileLayer::resource, 1234);
 
 
         player_.placement.TryPickup(world_, logic_, {0, 0}, 180);
         // Resource entity should only become nullptr after all the resources are extracted
         EXPECT_EQ(tile->GetPrototype(), &resource);
-        EXPECT_EQ(resource_data.resourceAmount, 1);
+        EXPECT_EQ(*world_.GetResourceAmount({0, 0}), 1);
 
         EXPECT_EQ(player_.inventory.inventory[0].item, &item); // Gave 1 resource to player
         EXPECT_EQ(player_.inventory.inventory[0].count, 1);
@@ -285,16 +292,16 @@ namespace jactorio::game
 
         // Resource entity
         proto::Item resource_item;
-        proto::ResourceEntity resource_entity;
+        auto& resource_entity      = proto_.Make<proto::ResourceEntity>();
         resource_entity.pickupTime = 3.f;
         resource_entity.SetItem(&resource_item);
 
         tile_resource->SetPrototype(Orientation::up, &resource_entity);
-        tile_resource->MakeUniqueData<proto::ResourceEntityData>(1);
+        *world_.GetResourceAmount({0, 0}) = 1;
 
         // Container entity
         proto::Item container_item;
-        proto::ContainerEntity container_entity;
+        auto& container_entity = proto_.Make<proto::ContainerEntity>();
         container_entity.SetItem(&container_item);
 
         tile_entity->SetPrototype(Orientation::up, &container_entity);
@@ -347,7 +354,8 @@ namespace jactorio::game
             mutable bool onRemoveCalled          = false;
             mutable int onUpdateCalled           = 0;
             mutable proto::UpdateType updateType = proto::UpdateType::place;
-        } mock;
+        };
+        auto& mock = proto_.Make<MockEntity>();
         proto::Sprite sprite;
         mock.sprite = &sprite;
 
@@ -395,7 +403,8 @@ namespace jactorio::game
                 emitCoords.push_back(emit_coord);
                 receiveCoords.push_back(receive_coord);
             }
-        } mock;
+        };
+        auto& mock = proto_.Make<Mock>();
         proto::Sprite sprite;
         mock.sprite = &sprite;
 
@@ -4,6 +4,12 @@
 
 #include "game/world/chunk.h"
 
+#include <sstream>
+
+#include "core/resource_guard.h"
+#include "proto/container_entity.h"
+#include "proto/resource_entity.h"
+
 #include "jactorioTests.h"
 
 namespace jactorio::game
@@ -26,6 +32,298 @@ namespace jactorio::game
         EXPECT_EQ(&chunk.Tiles(TileLayer::entity)[23 * 32 + 12], &chunk.GetCTile({12, 23}, TileLayer::entity));
     }
 
+    TEST(Chunk, Copy) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        container.SetDimension({2, 1});
+
+        Chunk chunk({4, 4});
+        auto& top_left = chunk.GetCTile({0, 0}, TileLayer::entity);
+        top_left.SetPrototype(Orientation::right, container);
+        top_left.MakeUniqueData<proto::ContainerEntityData>(32);
+
+        auto& tile = chunk.GetCTile({0, 1}, TileLayer::entity);
+        tile.SetPrototype(Orientation::right, container);
+        tile.SetupMultiTile(1, top_left);
+
+        const Chunk copy{chunk};
+        EXPECT_EQ(copy.GetPosition(), ChunkCoord(4, 4));
+
+        const auto& copy_top_left = copy.GetCTile({0, 0}, TileLayer::entity);
+        EXPECT_EQ(copy_top_left.GetPrototype(), &container);
+        EXPECT_EQ(copy_top_left.GetOrientation(), Orientation::right);
+
+        // Unique data is deep copied
+        const auto* copy_data = copy_top_left.GetUniqueData<proto::ContainerEntityData>();
+        ASSERT_NE(copy_data, nullptr);
+        EXPECT_NE(copy_data, top_left.GetUniqueData());
+        EXPECT_EQ(copy_data->inventory.Size(), 32);
+
+        const auto& copy_tile = copy.GetCTile({0, 1}, TileLayer::entity);
+        EXPECT_EQ(copy_tile.GetMultiTileIndex(), 1);
+        EXPECT_EQ(copy_tile.GetTopLeft(), nullptr); // top left tile not copied
+    }
+
+    TEST(Chunk, Move) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+
+        Chunk chunk({4, 4});
+        auto& top_left = chunk.GetCTile({0, 0}, TileLayer::entity);
+        top_left.SetPrototype(Orientation::right, container);
+        auto& unique_data = top_left.MakeUniqueData<proto::ContainerEntityData>(32);
+
+        auto& tile = chunk.GetCTile({0, 1}, TileLayer::entity);
+        tile.SetupMultiTile(1, top_left);
+
+        // Tiles keep their address, so multi tiles elsewhere can still refer to them
+        const Chunk move_to{std::move(chunk)};
+        EXPECT_EQ(&move_to.GetCTile({0, 0}, TileLayer::entity), &top_left);
+        EXPECT_EQ(top_left.GetUniqueData(), &unique_data);
+        EXPECT_EQ(tile.GetTopLeft(), &top_left);
+        EXPECT_EQ(top_left.GetOrientation(), Orientation::right);
+    }
+
+    TEST(Chunk, GetTexCoordIndex) {
+        EXPECT_EQ(Chunk::GetTexCoordIndex({0, 0}, TileLayer::base), 0);
+        EXPECT_EQ(Chunk::GetTexCoordIndex({1, 0}, TileLayer::base), kTileLayerCount);
+        EXPECT_EQ(Chunk::GetTexCoordIndex({12, 23}, TileLayer::resource), (23 * 32 + 12) * kTileLayerCount + 1);
+    }
+
+    TEST(Chunk, GetResourceAmount) {
+        Chunk chunk({4, 4});
+        EXPECT_EQ(&chunk.ResourceAmounts()[23 * 32 + 12], &chunk.GetResourceAmount({12, 23}));
+        EXPECT_EQ(chunk.GetResourceAmount({12, 23}), 0);
+    }
+
+    TEST(Chunk, MarkSaved) {
+        Chunk chunk({4, 4});
+        EXPECT_TRUE(chunk.IsDirty()); // New chunks not saved
+
+        chunk.MarkSaved();
+        EXPECT_FALSE(chunk.IsDirty());
+
+        chunk.MarkDirty();
+        EXPECT_TRUE(chunk.IsDirty());
+    }
+
+    TEST(Chunk, MarkSavedEntity) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+
+        Chunk chunk({4, 4});
+        auto& tile = chunk.GetCTile({12, 23}, TileLayer::entity);
+        tile.SetPrototype(Orientation::up, &container);
+
+        chunk.MarkSaved();
+        EXPECT_FALSE(chunk.IsDirty());
+
+        // Unique data is referred to by id, ids are only valid within one save
+        tile.MakeUniqueData<proto::ContainerEntityData>(10);
+        chunk.MarkSaved();
+        EXPECT_TRUE(chunk.IsDirty());
+
+        tile.Clear();
+        EXPECT_FALSE(chunk.IsDirty());
+    }
+
+    TEST(Chunk, IsStandalone) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        auto& resource  = proto.Make<proto::ResourceEntity>();
+
+        Chunk chunk({0, 0});
+        chunk.GetCTile({1, 2}, TileLayer::base).SetPrototype(Orientation::up, &container);
+        chunk.GetCTile({1, 2}, TileLayer::resource).SetPrototype(Orientation::up, &resource);
+        EXPECT_TRUE(chunk.IsStandalone());
+
+        chunk.GetCTile({3, 4}, TileLayer::entity).SetPrototype(Orientation::up, &container);
+        EXPECT_FALSE(chunk.IsStandalone());
+
+        chunk.GetCTile({3, 4}, TileLayer::entity).Clear();
+        EXPECT_TRUE(chunk.IsStandalone());
+    }
+
+    TEST(Chunk, IsStandaloneMultiTile) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        container.SetDimension({2, 1});
+
+        // Multi tiles may span into other chunks
+        Chunk chunk({0, 0});
+        chunk.GetCTile({31, 0}, TileLayer::base).SetPrototype(Orientation::up, &container);
+        EXPECT_FALSE(chunk.IsStandalone());
+
+        chunk.GetCTile({31, 0}, TileLayer::base).SetPrototype(nullptr);
+        EXPECT_TRUE(chunk.IsStandalone());
+
+        auto& top_left = chunk.GetCTile({0, 0}, TileLayer::base);
+        chunk.GetCTile({0, 1}, TileLayer::base).SetupMultiTile(1, top_left);
+        EXPECT_FALSE(chunk.IsStandalone());
+    }
+
+    TEST(Chunk, SerializeIsStandalone) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        proto.GenerateRelocationTable();
+
+        Chunk chunk({0, 0});
+        chunk.GetCTile({1, 2}, TileLayer::entity).SetPrototype(Orientation::up, &container);
+
+        // Counted again when loading
+        const auto result = TestSerializeDeserialize(chunk);
+        EXPECT_FALSE(result.IsStandalone());
+    }
+
+    TEST(Chunk, SerializeResourceAmounts) {
+        Chunk chunk({4, 4});
+        chunk.GetResourceAmount({12, 23}) = 4321;
+
+        const auto result = TestSerializeDeserialize(chunk);
+        EXPECT_EQ(result.GetResourceAmount({12, 23}), 4321);
+    }
+
+    TEST(Chunk, SerializeResourceAmountsLegacy) {
+        data::active_save_version = data::kSaveVersionLegacy;
+        CapturingGuard<void()> guard([]() { data::active_save_version = data::kSaveVersion; });
+
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+
+        auto& resource = proto.Make<proto::ResourceEntity>();
+        proto.GenerateRelocationTable();
+
+        // Older saves store resource amount as unique data of tile
+        Chunk chunk({4, 4});
+        auto& tile = chunk.GetCTile({12, 23}, TileLayer::resource);
+        tile.SetPrototype(Orientation::left, &resource);
+        tile.MakeUniqueData<proto::ResourceEntityData>(1234);
+
+        const auto result = TestSerializeDeserialize(chunk);
+
+        EXPECT_EQ(result.GetResourceAmount({12, 23}), 1234);
+        EXPECT_EQ(result.GetResourceAmount({0, 0}), 0);
+
+        const auto& result_tile = result.GetCTile({12, 23}, TileLayer::resource);
+        EXPECT_EQ(result_tile.GetPrototype(), &resource);
+        EXPECT_EQ(result_tile.GetOrientation(), Orientation::left);
+        EXPECT_EQ(result_tile.GetUniqueData(), nullptr);
+    }
+
+    TEST(Chunk, SerializeColumns) {
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        proto.GenerateRelocationTable();
+
+        Chunk chunk({4, 4});
+        chunk.GetCTile({1, 0}, TileLayer::base).SetPrototype(Orientation::right, &container);
+        chunk.GetCTile({2, 0}, TileLayer::base).SetPrototype(Orientation::right, &container);
+        chunk.GetCTile({3, 0}, TileLayer::base).SetPrototype(Orientation::down, &container);
+
+        auto& top_left = chunk.GetCTile({5, 6}, TileLayer::entity);
+        top_left.SetPrototype(Orientation::up, &container);
+        top_left.MakeUniqueData<proto::ContainerEntityData>(10);
+        auto& non_top_left = chunk.GetCTile({6, 6}, TileLayer::entity);
+        non_top_left.SetPrototype(Orientation::up, &container);
+        non_top_left.SetupMultiTile(1, top_left);
+
+        chunk.TexCoordIds()[1] = 12;
+        chunk.GetResourceAmount({31, 31}) = 4321;
+
+        const auto result = TestSerializeDeserialize(chunk);
+
+        EXPECT_EQ(result.GetPosition(), ChunkCoord(4, 4));
+        EXPECT_EQ(result.GetCTile({0, 0}, TileLayer::base).GetPrototype(), nullptr);
+        EXPECT_EQ(result.GetCTile({2, 0}, TileLayer::base).GetPrototype(), &container);
+        EXPECT_EQ(result.GetCTile({2, 0}, TileLayer::base).GetOrientation(), Orientation::right);
+        EXPECT_EQ(result.GetCTile({3, 0}, TileLayer::base).GetOrientation(), Orientation::down);
+        EXPECT_EQ(result.GetCTile({4, 0}, TileLayer::base).GetPrototype(), nullptr);
+
+        const auto& result_tile = result.GetCTile({5, 6}, TileLayer::entity);
+        const auto* result_data = result_tile.GetUniqueData<proto::ContainerEntityData>();
+        ASSERT_NE(result_data, nullptr);
+        EXPECT_EQ(result_data->inventory.Size(), 10);
+        EXPECT_EQ(result.GetCTile({6, 6}, TileLayer::entity).GetMultiTileIndex(), 1);
+
+        EXPECT_EQ(result.TexCoordIds()[0], 0);
+        EXPECT_EQ(result.TexCoordIds()[1], 12);
+        EXPECT_EQ(result.GetResourceAmount({31, 31}), 4321);
+    }
+
+    TEST(Chunk, SerializeColumnsSmaller) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        proto.GenerateRelocationTable();
+
+        Chunk chunk({0, 0});
+        for (ChunkTileCoordAxis y = 0; y < Chunk::kChunkWidth; ++y) {
+            for (ChunkTileCoordAxis x = 0; x < Chunk::kChunkWidth; ++x) {
+                chunk.GetCTile({x, y}, TileLayer::base).SetPrototype(Orientation::up, &container);
+            }
+        }
+
+        auto serialized_size = [&chunk]() {
+            std::stringstream ss;
+            {
+                cereal::PortableBinaryOutputArchive archive(ss);
+                archive(chunk);
+            }
+            return ss.str().size();
+        };
+
+        const auto columns_size = serialized_size();
+
+        data::active_save_version = data::kSaveVersionParallelChunks;
+        CapturingGuard<void()> guard([]() { data::active_save_version = data::kSaveVersion; });
+        const auto tiled_size = serialized_size();
+
+        EXPECT_LT(columns_size * 100, tiled_size);
+    }
+
+    TEST(Chunk, SerializeTiledLegacy) {
+        data::active_save_version = data::kSaveVersionParallelChunks;
+        CapturingGuard<void()> guard([]() { data::active_save_version = data::kSaveVersion; });
+
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        proto.GenerateRelocationTable();
+
+        // Older saves store tiles one by one
+        Chunk chunk({4, 4});
+        chunk.GetCTile({12, 23}, TileLayer::base).SetPrototype(Orientation::left, &container);
+        chunk.TexCoordIds()[5] = 1234;
+
+        const auto result = TestSerializeDeserialize(chunk);
+
+        EXPECT_EQ(result.GetCTile({12, 23}, TileLayer::base).GetPrototype(), &container);
+        EXPECT_EQ(result.GetCTile({12, 23}, TileLayer::base).GetOrientation(), Orientation::left);
+        EXPECT_EQ(result.TexCoordIds()[5], 1234);
+    }
+
     // TEST(Chunk, GetOverlayLayer) {
     //     Chunk chunk_a{{0, 0}};
     //
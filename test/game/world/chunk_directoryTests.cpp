@@ -0,0 +1,118 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "game/world/chunk_directory.h"
+
+#include <set>
+#include <tuple>
+
+#include "jactorioTests.h"
+
+namespace jactorio::game
+{
+    class ChunkDirectoryTest : public testing::Test
+    {
+    protected:
+        ChunkDirectory directory_;
+    };
+
+    TEST_F(ChunkDirectoryTest, EmplaceFind) {
+        auto& chunk = directory_.Emplace({2, -3});
+
+        EXPECT_EQ(chunk.GetPosition(), ChunkCoord(2, -3));
+        EXPECT_EQ(directory_.Find({2, -3}), &chunk);
+        EXPECT_EQ(directory_.Size(), 1);
+
+        EXPECT_EQ(directory_.Find({0, 0}), nullptr);
+        EXPECT_EQ(directory_.Find({2, 3}), nullptr);
+        EXPECT_EQ(directory_.Find({-3, 2}), nullptr);
+    }
+
+    TEST_F(ChunkDirectoryTest, FindOtherPages) {
+        constexpr auto kWidth = ChunkDirectory::kPageWidth;
+
+        // Grid of pages grows left, up, right and down
+        const ChunkCoord coords[] = {
+            {0, 0}, {-1, -1}, {kWidth, 0}, {-kWidth - 1, 0}, {0, 5 * kWidth}, {3, -7 * kWidth}, {kWidth - 1, kWidth - 1}};
+
+        std::set<Chunk*> chunks;
+        for (const auto& coord : coords) {
+            chunks.insert(&directory_.Emplace(coord));
+        }
+        EXPECT_EQ(chunks.size(), std::size(coords));
+
+        // Chunks did not move as pages were added
+        for (const auto& coord : coords) {
+            auto* chunk = directory_.Find(coord);
+            ASSERT_NE(chunk, nullptr);
+            EXPECT_EQ(chunk->GetPosition(), coord);
+            EXPECT_EQ(chunks.count(chunk), 1);
+        }
+
+        // Within grid of pages, but page is empty
+        EXPECT_EQ(directory_.Find({kWidth, kWidth}), nullptr);
+        // Outside grid of pages
+        EXPECT_EQ(directory_.Find({0, 6 * kWidth}), nullptr);
+        EXPECT_EQ(directory_.Find({-2 * kWidth - 1, 0}), nullptr);
+    }
+
+    TEST_F(ChunkDirectoryTest, Erase) {
+        directory_.Emplace({1, 1});
+        directory_.Emplace({1, 2});
+        directory_.Emplace({100, 2});
+
+        EXPECT_TRUE(directory_.Erase({1, 1}));
+        EXPECT_FALSE(directory_.Erase({1, 1}));
+        EXPECT_FALSE(directory_.Erase({-100, 1}));
+
+        EXPECT_TRUE(directory_.Erase({100, 2})); // Page emptied
+
+        EXPECT_EQ(directory_.Find({1, 1}), nullptr);
+        EXPECT_EQ(directory_.Find({100, 2}), nullptr);
+        EXPECT_NE(directory_.Find({1, 2}), nullptr);
+        EXPECT_EQ(directory_.Size(), 1);
+
+        // Emptied page can be reused
+        directory_.Emplace({101, 2});
+        EXPECT_NE(directory_.Find({101, 2}), nullptr);
+    }
+
+    TEST_F(ChunkDirectoryTest, Clear) {
+        directory_.Emplace({1, 1});
+        directory_.Emplace({-100, 1});
+
+        directory_.Clear();
+        EXPECT_EQ(directory_.Size(), 0);
+        EXPECT_EQ(directory_.Find({1, 1}), nullptr);
+        EXPECT_EQ(directory_.Find({-100, 1}), nullptr);
+    }
+
+    TEST_F(ChunkDirectoryTest, ForEach) {
+        directory_.Emplace({1, 1});
+        directory_.Emplace({-100, 1});
+        directory_.Emplace({4, 40});
+
+        std::set<std::tuple<ChunkCoordAxis, ChunkCoordAxis>> visited;
+        directory_.ForEach([&visited](Chunk& chunk) {
+            const auto c_coord = chunk.GetPosition();
+            visited.emplace(c_coord.x, c_coord.y);
+        });
+
+        EXPECT_EQ(visited, (std::set<std::tuple<ChunkCoordAxis, ChunkCoordAxis>>{{1, 1}, {-100, 1}, {4, 40}}));
+    }
+
+    TEST_F(ChunkDirectoryTest, Serialize) {
+        directory_.Emplace({1, 1});
+        directory_.Emplace({-100, 1});
+
+        const auto result = TestSerializeDeserialize(directory_);
+
+        EXPECT_EQ(result.Size(), 2);
+        ASSERT_NE(result.Find({1, 1}), nullptr);
+
+        const auto* chunk = result.Find({-100, 1});
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_EQ(chunk->GetPosition(), ChunkCoord(-100, 1));
+    }
+} // namespace jactorio::game
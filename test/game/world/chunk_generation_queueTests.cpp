@@ -0,0 +1,117 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "game/world/chunk_generation_queue.h"
+
+#include <set>
+#include <thread>
+
+namespace jactorio::game
+{
+    class ChunkGenerationQueueTest : public testing::Test
+    {
+    protected:
+        ChunkGenerationQueue queue_;
+
+        /// Pops all chunks in queue
+        std::vector<ChunkCoord> PopAll() {
+            std::vector<ChunkCoord> popped;
+            ChunkCoord c_coord;
+            while (queue_.Pop(c_coord)) {
+                popped.push_back(c_coord);
+            }
+            return popped;
+        }
+    };
+
+    TEST_F(ChunkGenerationQueueTest, PopEmpty) {
+        ChunkCoord c_coord{4, 5};
+        EXPECT_FALSE(queue_.Pop(c_coord));
+        EXPECT_EQ(c_coord, ChunkCoord(4, 5));
+    }
+
+    TEST_F(ChunkGenerationQueueTest, PushDuplicate) {
+        queue_.Push({1, 2});
+        queue_.Push({1, 2});
+        EXPECT_EQ(queue_.Size(), 1);
+
+        PopAll();
+
+        // Can be queued again once popped
+        queue_.Push({1, 2});
+        EXPECT_EQ(queue_.Size(), 1);
+    }
+
+    TEST_F(ChunkGenerationQueueTest, NearestFirst) {
+        queue_.SetFocus({{10, -10}});
+
+        queue_.Push({0, 0});
+        queue_.Push({10, -8});
+        queue_.Push({11, -10});
+        queue_.Push({10, -10});
+
+        EXPECT_EQ(PopAll(), (std::vector<ChunkCoord>{{10, -10}, {11, -10}, {10, -8}, {0, 0}}));
+    }
+
+    TEST_F(ChunkGenerationQueueTest, NoFocus) {
+        queue_.Push({3, 0});
+        queue_.Push({-1, 0});
+        queue_.Push({0, 2});
+
+        EXPECT_EQ(PopAll(), (std::vector<ChunkCoord>{{-1, 0}, {0, 2}, {3, 0}}));
+    }
+
+    TEST_F(ChunkGenerationQueueTest, MultipleFocus) {
+        queue_.SetFocus({{0, 0}, {100, 100}});
+
+        queue_.Push({50, 50});
+        queue_.Push({98, 100});
+        queue_.Push({0, 1});
+
+        EXPECT_EQ(PopAll(), (std::vector<ChunkCoord>{{0, 1}, {98, 100}, {50, 50}}));
+    }
+
+    TEST_F(ChunkGenerationQueueTest, SetFocusReorders) {
+        queue_.Push({0, 0});
+        queue_.Push({20, 0});
+
+        queue_.SetFocus({{20, 1}});
+
+        EXPECT_EQ(PopAll(), (std::vector<ChunkCoord>{{20, 0}, {0, 0}}));
+    }
+
+    TEST_F(ChunkGenerationQueueTest, Clear) {
+        queue_.Push({0, 0});
+        queue_.Clear();
+
+        EXPECT_EQ(queue_.Size(), 0);
+        EXPECT_TRUE(PopAll().empty());
+    }
+
+    TEST_F(ChunkGenerationQueueTest, PushMultipleThreads) {
+        constexpr int kPerThread = 500;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([this, t]() {
+                // Half of the chunks are pushed by 2 threads
+                for (int i = 0; i < kPerThread; ++i) {
+                    queue_.Push({i, t / 2});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const auto popped = PopAll();
+        EXPECT_EQ(popped.size(), kPerThread * 2);
+
+        std::set<std::tuple<ChunkCoordAxis, ChunkCoordAxis>> unique;
+        for (const auto& c_coord : popped) {
+            unique.emplace(c_coord.x, c_coord.y);
+        }
+        EXPECT_EQ(unique.size(), popped.size());
+    }
+} // namespace jactorio::game
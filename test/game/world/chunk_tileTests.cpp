@@ -4,6 +4,8 @@
 
 #include "game/world/chunk_tile.h"
 
+#include "game/world/chunk.h"
+
 #include "data/cereal/register_type.h" // Just has to be included somewhere once
 #include "jactorioTests.h"
 
@@ -12,74 +14,24 @@ namespace jactorio::game
     class ChunkTileTest : public testing::Test
     {
     protected:
-        proto::ContainerEntity proto_;
-    };
-
-    TEST_F(ChunkTileTest, CopyTopLeft) {
-        proto_.SetDimension({2, 5});
-
-        ChunkTile top_left;
-        top_left.SetPrototype(Orientation::right, proto_);
-        top_left.MakeUniqueData<proto::ContainerEntityData>(32);
-
-        const ChunkTile copy{top_left};
-        EXPECT_EQ(copy.GetMultiTileIndex(), 0);
-
-        EXPECT_EQ(copy.GetDimension().x, 5);
-        EXPECT_EQ(copy.GetDimension().y, 2);
-        EXPECT_EQ(copy.GetDimension(), top_left.GetDimension());
-
-        EXPECT_EQ(copy.GetUniqueData<proto::ContainerEntityData>()->inventory.Size(), 32);
+        data::PrototypeManager proto_;
+        proto::ContainerEntity& container_ = proto_.Make<proto::ContainerEntity>();
 
-        EXPECT_EQ(copy.GetOrientation(), Orientation::right);
-    }
-
-    TEST_F(ChunkTileTest, CopyNonTopLeft) {
-        // Since orientation is right, width and height are swapped
-        proto_.SetDimension({2, 5});
-
-        ChunkTile top_left;
-        ChunkTile tile;
-        tile.SetupMultiTile(4, top_left);
-        tile.SetPrototype(Orientation::right, proto_);
-
-        const ChunkTile copy = tile;
+        Chunk chunk_{{0, 0}};
 
-        EXPECT_EQ(copy.GetMultiTileIndex(), 4);
-
-        EXPECT_EQ(copy.GetDimension().x, 5);
-        EXPECT_EQ(copy.GetDimension().y, 2);
-
-        EXPECT_EQ(copy.GetTopLeft(), nullptr); // top left tile not copied
-    }
-
-    TEST_F(ChunkTileTest, MoveTopLeft) {
-        ChunkTile top_left;
-        top_left.MakeUniqueData<proto::ContainerEntityData>(32);
-
-        const ChunkTile move_to = std::move(top_left);
-
-        EXPECT_EQ(top_left.GetUniqueData<proto::ContainerEntityData>(), nullptr); // Gave ownership
-        EXPECT_NE(move_to.GetUniqueData<proto::ContainerEntityData>(), nullptr);  // Took ownership
-
-        EXPECT_EQ(move_to.GetOrientation(), Orientation::up);
-    }
-
-    TEST_F(ChunkTileTest, MoveNonTopLeft) {
-        ChunkTile top_left;
-        ChunkTile tile;
-        tile.SetupMultiTile(4, top_left);
-        tile.SetPrototype(Orientation::right, proto_);
-
-        const ChunkTile move_to = std::move(tile);
+        void SetUp() override {
+            data::active_prototype_manager = &proto_;
+        }
 
-        EXPECT_EQ(move_to.GetTopLeft(), &top_left);
-        EXPECT_EQ(move_to.GetOrientation(), Orientation::right);
-    }
+        /// Tiles are only valid within a chunk
+        ChunkTile& Tile(const ChunkTileCoordAxis x, const ChunkTileCoordAxis y = 0) {
+            return chunk_.GetCTile({x, y}, TileLayer::entity);
+        }
+    };
 
     TEST_F(ChunkTileTest, ClearTopLeft) {
-        ChunkTile tile;
-        tile.SetPrototype(Orientation::up, proto_);
+        auto& tile = Tile(0);
+        tile.SetPrototype(Orientation::up, container_);
         tile.MakeUniqueData<proto::ContainerEntityData>();
 
         tile.Clear();
@@ -90,10 +42,10 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, ClearNonTopLeft) {
-        ChunkTile top_left;
-        ChunkTile tile;
+        auto& top_left = Tile(0);
+        auto& tile     = Tile(1);
         tile.SetupMultiTile(2, top_left);
-        tile.SetPrototype(Orientation::up, proto_);
+        tile.SetPrototype(Orientation::up, container_);
 
         tile.Clear();
 
@@ -103,18 +55,18 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, GetSetOrientation) {
-        ChunkTile top_left;
-        top_left.SetPrototype(Orientation::right, proto_);
+        auto& top_left = Tile(0);
+        top_left.SetPrototype(Orientation::right, container_);
 
         EXPECT_EQ(top_left.GetOrientation(), Orientation::right);
     }
 
     TEST_F(ChunkTileTest, GetSetPrototype) {
-        ChunkTile tile;
+        auto& tile = Tile(0);
 
-        tile.SetPrototype(Orientation::right, proto_);
+        tile.SetPrototype(Orientation::right, container_);
 
-        EXPECT_EQ(tile.GetPrototype(), &proto_);
+        EXPECT_EQ(tile.GetPrototype(), &container_);
         EXPECT_EQ(tile.GetOrientation(), Orientation::right);
 
 
@@ -124,17 +76,17 @@ namespace jactorio::game
         EXPECT_EQ(tile.GetOrientation(), Orientation::up);
 
 
-        tile.SetPrototype(Orientation::right, proto_);
+        tile.SetPrototype(Orientation::right, container_);
         tile.SetPrototype(nullptr);
 
         EXPECT_EQ(tile.GetPrototype(), nullptr);
     }
 
     TEST_F(ChunkTileTest, GetUniqueData) {
-        ChunkTile top_left;
+        auto& top_left = Tile(0);
         top_left.MakeUniqueData<proto::ContainerEntityData>(10);
 
-        ChunkTile tile;
+        auto& tile = Tile(1);
         tile.SetupMultiTile(3, top_left);
 
 
@@ -144,12 +96,12 @@ namespace jactorio::game
 
     TEST_F(ChunkTileTest, IsTopLeft) {
         {
-            const ChunkTile tile;
+            const auto& tile = Tile(0);
             EXPECT_TRUE(tile.IsTopLeft());
         }
         {
-            ChunkTile top_left;
-            ChunkTile tile;
+            auto& top_left = Tile(1);
+            auto& tile     = Tile(2);
             tile.SetupMultiTile(4, top_left);
             EXPECT_FALSE(tile.IsTopLeft());
         }
@@ -157,20 +109,20 @@ namespace jactorio::game
 
     TEST_F(ChunkTileTest, IsMultiTile) {
         {
-            const ChunkTile tile;
+            const auto& tile = Tile(0);
             EXPECT_FALSE(tile.IsMultiTile());
         }
         {
             // Top left has to look at prototype to determine if it is multi tile
-            proto_.SetWidth(3);
+            container_.SetWidth(3);
 
-            ChunkTile tile;
-            tile.SetPrototype(Orientation::up, proto_);
+            auto& tile = Tile(1);
+            tile.SetPrototype(Orientation::up, container_);
             EXPECT_TRUE(tile.IsMultiTile());
         }
         {
-            ChunkTile top_left;
-            ChunkTile tile;
+            auto& top_left = Tile(2);
+            auto& tile     = Tile(3);
             tile.SetupMultiTile(1, top_left);
             EXPECT_TRUE(tile.IsMultiTile());
         }
@@ -178,27 +130,27 @@ namespace jactorio::game
 
     TEST_F(ChunkTileTest, IsMultiTileTopLeft) {
         {
-            ChunkTile tile;
+            auto& tile = Tile(0);
             EXPECT_FALSE(tile.IsMultiTileTopLeft());
         }
 
         {
-            proto_.SetWidth(3);
+            container_.SetWidth(3);
 
-            ChunkTile tile;
-            tile.SetPrototype(Orientation::up, proto_);
+            auto& tile = Tile(1);
+            tile.SetPrototype(Orientation::up, container_);
             EXPECT_TRUE(tile.IsMultiTileTopLeft());
         }
         {
-            ChunkTile top_left;
-            ChunkTile tile;
+            auto& top_left = Tile(2);
+            auto& tile     = Tile(3);
             tile.SetupMultiTile(4, top_left);
             EXPECT_FALSE(tile.IsMultiTileTopLeft());
         }
     }
 
     TEST_F(ChunkTileTest, GetDimensions) {
-        const ChunkTile first;
+        const auto& first = Tile(0);
         const auto dimens = first.GetDimension();
 
         EXPECT_EQ(dimens.x, 1);
@@ -206,10 +158,10 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, GetDimensionsMultiTile) {
-        proto::ContainerEntity container;
+        auto& container = proto_.Make<proto::ContainerEntity>();
         container.SetDimension({2, 3});
 
-        ChunkTile first;
+        auto& first = Tile(0);
         first.SetPrototype(Orientation::right, &container);
 
         const auto& dimens = first.GetDimension();
@@ -220,8 +172,8 @@ namespace jactorio::game
 
 
     TEST_F(ChunkTileTest, SetupMultiTile) {
-        ChunkTile top_left;
-        ChunkTile tile;
+        auto& top_left = Tile(0);
+        auto& tile     = Tile(1);
 
         tile.SetupMultiTile(1, top_left);
         EXPECT_EQ(tile.GetMultiTileIndex(), 1);
@@ -229,16 +181,16 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, GetTopLeftAlreadyTopleft) {
-        ChunkTile tile;
+        auto& tile = Tile(0);
         EXPECT_EQ(tile.GetTopLeft(), &tile);
     }
 
     TEST_F(ChunkTileTest, AdjustToTopleft) {
-        proto_.SetWidth(3);
+        container_.SetWidth(3);
 
-        ChunkTile top_left;
-        ChunkTile tile;
-        tile.SetPrototype(Orientation::up, proto_);
+        auto& top_left = Tile(0);
+        auto& tile     = Tile(1);
+        tile.SetPrototype(Orientation::up, container_);
         tile.SetupMultiTile(5, top_left);
 
         Position2<int> p;
@@ -249,7 +201,7 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, AdjustToTopleftNonMultiTile) {
-        const ChunkTile tile;
+        const auto& tile = Tile(0);
 
         Position2<int> p;
         Position2Increment(tile, p, 100);
@@ -259,52 +211,51 @@ namespace jactorio::game
     }
 
     TEST_F(ChunkTileTest, GetOffsetX) {
-        proto_.SetWidth(10);
+        container_.SetWidth(10);
 
-        ChunkTile top_left;
-        ChunkTile tile;
-        tile.SetPrototype(Orientation::up, proto_);
+        auto& top_left = Tile(0);
+        auto& tile     = Tile(1);
+        tile.SetPrototype(Orientation::up, container_);
         tile.SetupMultiTile(19, top_left);
 
         EXPECT_EQ(tile.GetOffsetX(), 9);
     }
 
     TEST_F(ChunkTileTest, GetOffsetY) {
-        proto_.SetWidth(5);
+        container_.SetWidth(5);
 
-        ChunkTile top_left;
-        ChunkTile tile;
-        tile.SetPrototype(Orientation::up, proto_);
+        auto& top_left = Tile(0);
+        auto& tile     = Tile(1);
+        tile.SetPrototype(Orientation::up, container_);
         tile.SetupMultiTile(20, top_left);
 
         EXPECT_EQ(tile.GetOffsetY(), 4);
     }
 
     TEST_F(ChunkTileTest, Serialize) {
-        data::PrototypeManager proto;
         data::UniqueDataManager unique;
-
-        data::active_prototype_manager   = &proto;
         data::active_unique_data_manager = &unique;
 
-        auto& container = proto.Make<proto::ContainerEntity>();
-        container.SetDimension({2, 3}); // Width and height are flipped since orientation is right
+        container_.SetDimension({2, 3}); // Width and height are flipped since orientation is right
 
-        ChunkTile top_left;
-        top_left.SetPrototype(Orientation::right, container);
+        auto& top_left = Tile(0);
+        top_left.SetPrototype(Orientation::right, container_);
         top_left.MakeUniqueData<proto::ContainerEntityData>(10);
 
-        ChunkTile bot_right;
+        auto& bot_right = Tile(1);
         bot_right.SetupMultiTile(3, top_left);
-        bot_right.SetPrototype(Orientation::right, container);
+        bot_right.SetPrototype(Orientation::right, container_);
 
-        proto.GenerateRelocationTable();
+        proto_.GenerateRelocationTable();
 
         // ======================================================================
-        auto result_tl = TestSerializeDeserialize(top_left);
-        auto result_br = TestSerializeDeserialize(bot_right);
+        // Unique data is held by the chunk, tiles are serialized with it
+        const auto result = TestSerializeDeserialize(chunk_);
+
+        const auto& result_tl = result.GetCTile({0, 0}, TileLayer::entity);
+        const auto& result_br = result.GetCTile({1, 0}, TileLayer::entity);
 
-        EXPECT_EQ(result_tl.GetPrototype(), &container);
+        EXPECT_EQ(result_tl.GetPrototype(), &container_);
         ASSERT_NE(result_tl.GetUniqueData(), nullptr);
         EXPECT_EQ(result_tl.GetUniqueData()->internalId, 1);
 
@@ -313,7 +264,7 @@ namespace jactorio::game
 
         EXPECT_EQ(result_tl.GetOrientation(), Orientation::right);
 
-        EXPECT_EQ(result_br.GetPrototype(), &container);
+        EXPECT_EQ(result_br.GetPrototype(), &container_);
         EXPECT_EQ(result_br.GetTopLeft(), nullptr);
 
         EXPECT_EQ(result_br.GetDimension().x, 3);
@@ -0,0 +1,113 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "game/world/perlin_noise.h"
+
+#include <vector>
+
+namespace jactorio::game
+{
+    class PerlinNoiseTest : public testing::Test
+    {
+    protected:
+        /// Kernels supported on this CPU, excluding libnoise
+        std::vector<NoiseKernel> kernels_;
+
+        void SetUp() override {
+            for (int i = 0; i < static_cast<int>(NoiseKernel::count_); ++i) {
+                const auto kernel = static_cast<NoiseKernel>(i);
+                if (kernel != NoiseKernel::libnoise && NoiseKernelSupported(kernel)) {
+                    kernels_.push_back(kernel);
+                }
+            }
+        }
+
+        /// Expects each kernel to give the values libnoise gives for chunk at c_coord
+        void ExpectMatchesLibnoise(const PerlinParams& params, const ChunkCoord& c_coord) const {
+            ChunkNoiseMap expected;
+            GenerateChunkNoise(NoiseKernel::libnoise, params, c_coord, expected);
+
+            for (const auto kernel : kernels_) {
+                ChunkNoiseMap noise_map;
+                GenerateChunkNoise(kernel, params, c_coord, noise_map);
+
+                for (std::size_t i = 0; i < noise_map.size(); ++i) {
+                    ASSERT_NEAR(noise_map[i], expected[i], 1e-5)
+                        << "Kernel " << static_cast<int>(kernel) << " at tile " << i << " chunk " << c_coord.x << " "
+                        << c_coord.y;
+                }
+            }
+        }
+    };
+
+    TEST_F(PerlinNoiseTest, ScalarSupported) {
+        EXPECT_TRUE(NoiseKernelSupported(NoiseKernel::libnoise));
+        EXPECT_TRUE(NoiseKernelSupported(NoiseKernel::scalar));
+        EXPECT_FALSE(NoiseKernelSupported(NoiseKernel::count_));
+    }
+
+    TEST_F(PerlinNoiseTest, SetNoiseKernel) {
+        const auto original = GetNoiseKernel();
+
+        EXPECT_TRUE(SetNoiseKernel(NoiseKernel::scalar));
+        EXPECT_EQ(GetNoiseKernel(), NoiseKernel::scalar);
+
+        // Unsupported, unchanged
+        EXPECT_FALSE(SetNoiseKernel(NoiseKernel::count_));
+        EXPECT_EQ(GetNoiseKernel(), NoiseKernel::scalar);
+
+        SetNoiseKernel(original);
+    }
+
+    TEST_F(PerlinNoiseTest, MatchesLibnoise) {
+        PerlinParams params;
+        params.seed        = 1001;
+        params.octaveCount = 8;
+        params.frequency   = 0.25;
+        params.persistence = 0.5;
+
+        // Chunks about 0 cover lattice points at or below 0, which libnoise handles specially
+        for (const ChunkCoord c_coord : {ChunkCoord{0, 0}, {-1, -1}, {3, -7}, {-12, 40}, {1000, -1000}}) {
+            ExpectMatchesLibnoise(params, c_coord);
+        }
+    }
+
+    TEST_F(PerlinNoiseTest, MatchesLibnoiseParams) {
+        PerlinParams params;
+        params.seed        = -7;
+        params.octaveCount = 3;
+        params.frequency   = 1.7;
+        params.persistence = 0.8;
+        ExpectMatchesLibnoise(params, {5, -2});
+
+        params.seed        = 2147483647; // Seed wraps across octaves
+        params.octaveCount = 1;
+        params.frequency   = 0.01;
+        ExpectMatchesLibnoise(params, {-300, 2});
+    }
+
+    TEST_F(PerlinNoiseTest, MatchesLibnoiseWrappedCoordinates) {
+        PerlinParams params;
+        params.octaveCount = 12;
+        params.frequency   = 1024;
+
+        // Coordinates exceed range of int32 in the later octaves, wrapped by libnoise
+        ExpectMatchesLibnoise(params, {300, -2});
+    }
+
+    TEST_F(PerlinNoiseTest, NoOctaves) {
+        PerlinParams params;
+        params.octaveCount = 0;
+
+        for (const auto kernel : kernels_) {
+            ChunkNoiseMap noise_map;
+            noise_map.fill(1.f);
+            GenerateChunkNoise(kernel, params, {0, 0}, noise_map);
+
+            for (const auto val : noise_map) {
+                EXPECT_EQ(val, 0.f);
+            }
+        }
+    }
+} // namespace jactorio::game
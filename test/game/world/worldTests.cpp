@@ -4,9 +4,17 @@
 
 #include "game/world/world.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "jactorioTests.h"
 
+#include "core/resource_guard.h"
+#include "core/thread_pool.h"
+#include "proto/inserter.h"
 #include "proto/noise_layer.h"
+#include "proto/sprite.h"
+#include "proto/transport_belt.h"
 
 namespace jactorio::game
 {
@@ -61,14 +69,12 @@ namespace jactorio::game
         EXPECT_EQ(world_.GetChunkC({1, 1}), nullptr);
 
 
-        auto [ptr, readable_chunks] = world_.GetChunkTexCoordIds({0, 1});
-        EXPECT_NE(ptr, nullptr);
-        EXPECT_EQ(readable_chunks, 6);
-
-        EXPECT_EQ(world_.GetChunkTexCoordIds({5, 1}).second, 1);
-        EXPECT_EQ(world_.GetChunkTexCoordIds({5, 0}).second, 0);
-        EXPECT_EQ(world_.GetChunkTexCoordIds({-1, 1}).second, 0);
-        EXPECT_EQ(world_.GetChunkTexCoordIds({6, 1}).second, 0);
+        // Tex coord ids only for the added chunk
+        EXPECT_EQ(world_.GetChunkTexCoordIds({5, 1}), added_chunk.TexCoordIds().data());
+        EXPECT_EQ(world_.GetChunkTexCoordIds({0, 1}), nullptr);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({5, 0}), nullptr);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({-1, 1}), nullptr);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({6, 1}), nullptr);
     }
 
     TEST_F(WorldTest, AddChunkNegative) {
@@ -85,24 +91,23 @@ namespace jactorio::game
         EXPECT_EQ(world_.GetChunkC({-1, -1}), nullptr);
         EXPECT_EQ(world_.GetChunkC({1, 1}), nullptr);
 
-        auto [ptr, readable_chunks] = world_.GetChunkTexCoordIds({-5, -1});
-        EXPECT_NE(ptr, nullptr);
-        EXPECT_EQ(readable_chunks, 5);
+        EXPECT_NE(world_.GetChunkTexCoordIds({-5, -1}), nullptr);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({-4, -1}), nullptr);
     }
 
     TEST_F(WorldTest, DeleteChunk) {
         world_.EmplaceChunk({3, 2});
-        world_.GetChunkTexCoordIds({3, 2}).first[0] = 100; // Check that this was zeroed
+        world_.GetChunkTexCoordIds({3, 2})[0] = 100;
 
         world_.DeleteChunk({3, 2});
 
         EXPECT_EQ(world_.GetChunkC({3, 2}), nullptr);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({3, 2}), nullptr);
+        EXPECT_EQ(world_.GetTexCoordId({96, 64}, TileLayer::base), 0);
 
-        auto [ptr, readable_chunks] = world_.GetChunkTexCoordIds({3, 2});
-        EXPECT_EQ(readable_chunks, 1); // Still readable
-        for (int i = 0; i < Chunk::kChunkArea * kTileLayerCount; ++i) {
-            EXPECT_EQ(ptr[i], 0);
-        }
+        // Recreated chunk has no tex coord ids
+        world_.EmplaceChunk({3, 2});
+        EXPECT_EQ(world_.GetChunkTexCoordIds({3, 2})[0], 0);
 
         // No effect, no chunk
         world_.DeleteChunk({2000, 2000});
@@ -144,6 +149,56 @@ namespace jactorio::game
         }
     }
 
+    TEST_F(WorldTest, ForEachTileInRect) {
+        world_.EmplaceChunk({-1, -1});
+        world_.EmplaceChunk({0, -1});
+        world_.EmplaceChunk({-1, 0});
+        world_.EmplaceChunk({0, 0});
+
+        // Spans 4 chunks
+        std::vector<WorldCoord> coords;
+        world_.ForEachTileInRect({-2, -1}, {4, 3}, TileLayer::entity, [&](const WorldCoord& coord, ChunkTile& tile) {
+            EXPECT_EQ(&tile, world_.GetTile(coord, TileLayer::entity));
+            coords.push_back(coord);
+        });
+
+        // Row by row, left to right
+        const std::vector<WorldCoord> expected{
+            {-2, -1}, {-1, -1}, {0, -1}, {1, -1}, {-2, 0}, {-1, 0}, {0, 0}, {1, 0}, {-2, 1}, {-1, 1}, {0, 1}, {1, 1}};
+        EXPECT_EQ(coords, expected);
+    }
+
+    TEST_F(WorldTest, ForEachTileInRectNoChunk) {
+        world_.EmplaceChunk({0, 0});
+
+        // Chunk -1, 0 does not exist
+        int count = 0;
+        world_.ForEachTileInRect({-2, 0}, {4, 1}, TileLayer::base, [&](const WorldCoord& coord, ChunkTile& /*tile*/) {
+            EXPECT_GE(coord.x, 0);
+            ++count;
+        });
+        EXPECT_EQ(count, 2);
+    }
+
+    TEST_F(WorldTest, FindTileInRect) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+
+        int visited = 0;
+        auto* tile  = world_.FindTileInRect({30, 1}, {4, 2}, TileLayer::base, [&](const WorldCoord& coord, ChunkTile&) {
+            ++visited;
+            return coord.x == 32 && coord.y == 2;
+        });
+
+        EXPECT_EQ(tile, world_.GetTile({32, 2}, TileLayer::base));
+        EXPECT_EQ(visited, 7); // Stopped once found
+
+        const auto& const_world = world_;
+        EXPECT_EQ(const_world.FindTileInRect(
+                      {30, 1}, {4, 2}, TileLayer::base, [](const WorldCoord&, const ChunkTile&) { return false; }),
+                  nullptr);
+    }
+
     TEST_F(WorldTest, GetChunkWorldCoords) {
         {
             const auto& chunk = world_.EmplaceChunk({0, 0});
@@ -160,24 +215,56 @@ namespace jactorio::game
         }
     }
 
+    TEST_F(WorldTest, GetResourceAmount) {
+        auto& chunk = world_.EmplaceChunk({-1, 0});
+
+        EXPECT_EQ(world_.GetResourceAmount({-31, 2}), &chunk.GetResourceAmount({1, 2}));
+
+        // No chunk
+        EXPECT_EQ(world_.GetResourceAmount({0, 0}), nullptr);
+    }
+
     TEST_F(WorldTest, GetSetTexCoordId) {
         world_.EmplaceChunk({3, 1});
 
         world_.SetTexCoordId({106, 60}, TileLayer::resource, 4321);
 
-        auto [ptr, readable_chunks] = world_.GetChunkTexCoordIds({3, 1});
-        EXPECT_EQ(readable_chunks, 1);
+        const auto* ptr = world_.GetChunkTexCoordIds({3, 1});
         EXPECT_EQ(
             ptr[(Chunk::kChunkWidth * (60 % Chunk::kChunkWidth) + (106 % Chunk::kChunkWidth)) * kTileLayerCount + 1],
             4321);
 
         EXPECT_EQ(world_.GetTexCoordId({106, 60}, TileLayer::resource), 4321);
+
+        // No chunk
+        EXPECT_EQ(world_.GetTexCoordId({0, 0}, TileLayer::resource), 0);
+    }
+
+    TEST_F(WorldTest, ForEachChunkTexCoordIds) {
+        // Spans 2 pages of chunk directory
+        world_.EmplaceChunk({-2, 3});
+        world_.EmplaceChunk({0, 3});
+        world_.EmplaceChunk({0, 4});
+
+        std::vector<ChunkCoord> coords;
+        std::vector<const SpriteTexCoordIndexT*> tex_ids;
+        world_.ForEachChunkTexCoordIds({-2, 3}, 4, [&](const ChunkCoord& c_coord, const SpriteTexCoordIndexT* ids) {
+            coords.push_back(c_coord);
+            tex_ids.push_back(ids);
+        });
+
+        const std::vector<ChunkCoord> expected_coords{{-2, 3}, {-1, 3}, {0, 3}, {1, 3}};
+        EXPECT_EQ(coords, expected_coords);
+
+        const std::vector<const SpriteTexCoordIndexT*> expected_tex_ids{
+            world_.GetChunkTexCoordIds({-2, 3}), nullptr, world_.GetChunkTexCoordIds({0, 3}), nullptr};
+        EXPECT_EQ(tex_ids, expected_tex_ids);
     }
 
     TEST_F(WorldTest, SerializeTexCoordIds) {
         world_.EmplaceChunk({1, 2});
         {
-            auto [ptr, readable_amount] = world_.GetChunkTexCoordIds({1, 2});
+            auto* ptr = world_.GetChunkTexCoordIds({1, 2});
             for (int i = 0; i < 1000; ++i) {
                 ptr[i] = i;
             }
@@ -185,18 +272,278 @@ namespace jactorio::game
 
         auto result = TestSerializeDeserialize(world_);
 
-        auto [ptr, readable_amount] = result.GetChunkTexCoordIds({1, 2});
-        EXPECT_EQ(readable_amount, 1);
+        const auto* ptr = result.GetChunkTexCoordIds({1, 2});
+        ASSERT_NE(ptr, nullptr);
         for (int i = 0; i < 1000; ++i) {
             EXPECT_EQ(ptr[i], i);
         }
     }
 
+    /// Layout of a World in saves before kSaveVersionChunkTexCoords
+    struct LegacyTexCoordWorld
+    {
+        UpdateDispatcher updateDispatcher;
+        DVector<DVector<Chunk::TexCoordIdArrayT>> texCoordIds;
+        ChunkDirectory chunks;
+        std::array<std::vector<LogicObject>, kLogicGroupCount> logicLists;
+        int worldGenSeed = 0;
+
+        CEREAL_SERIALIZE(archive) {
+            archive(updateDispatcher, texCoordIds, chunks, logicLists, worldGenSeed);
+        }
+    };
+
+    TEST_F(WorldTest, SerializeTexCoordIdsLegacy) {
+        data::active_save_version = data::kSaveVersionLegacy;
+        CapturingGuard<void()> guard([]() { data::active_save_version = data::kSaveVersion; });
+
+        LegacyTexCoordWorld legacy;
+        legacy.chunks.Emplace({-1, 2});
+        legacy.chunks.Emplace({4, 0}); // No tex coord ids saved
+        legacy.worldGenSeed = 42;
+
+        // Gap filled up to chunk -1, 2
+        for (int y = 0; y <= 2; ++y) {
+            legacy.texCoordIds.emplace_back();
+            legacy.texCoordIds[y].emplace_front();
+        }
+        legacy.texCoordIds[2][-1][5] = 1234;
+
+        TestSerialize(legacy);
+        auto result = TestDeserialize<World>();
+
+        EXPECT_EQ(result.GetChunkTexCoordIds({-1, 2})[5], 1234);
+        EXPECT_EQ(result.GetChunkTexCoordIds({4, 0})[0], 0);
+        EXPECT_EQ(result.GetWorldGeneratorSeed(), 42);
+    }
+
+    TEST_F(WorldTest, SetTexCoordIdMarkDirty) {
+        auto& chunk = world_.EmplaceChunk({0, 0});
+        world_.MarkSaved();
+        EXPECT_FALSE(chunk.IsDirty());
+
+        world_.SetTexCoordId({1, 2}, TileLayer::base, 1);
+        EXPECT_TRUE(chunk.IsDirty());
+    }
+
+    TEST_F(WorldTest, UniqueDataMarkDirty) {
+        auto& left_chunk  = world_.EmplaceChunk({0, 0});
+        auto& right_chunk = world_.EmplaceChunk({1, 0});
+
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        // Structure is saved with each chunk it spans
+        auto& transport_belt  = proto.Make<proto::TransportBelt>();
+        const auto con_struct = std::make_shared<ConveyorStruct>(
+            Orientation::right, ConveyorStruct::TerminationType::straight, 2);
+        TestSetupConveyor(world_, {31, 2}, transport_belt, con_struct);
+        TestSetupConveyor(world_, {32, 2}, transport_belt, con_struct);
+
+        // Saved with every increment, so ids of unique data and structures are consistent within each increment
+        world_.MarkSaved();
+        EXPECT_TRUE(left_chunk.IsDirty());
+        EXPECT_TRUE(right_chunk.IsDirty());
+
+        world_.GetTile({31, 2}, TileLayer::entity)->Clear();
+        world_.MarkSaved();
+        EXPECT_FALSE(left_chunk.IsDirty());
+        EXPECT_TRUE(right_chunk.IsDirty());
+    }
+
+    TEST_F(WorldTest, SerializeIncrement) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+        world_.EmplaceChunk({2, 0});
+        world_.EmplaceChunk({3, 0});
+
+        auto base = TestSerializeDeserialize(world_);
+        world_.MarkSaved();
+
+        world_.SetTexCoordId({0, 0}, TileLayer::base, 1234);
+        world_.GetChunkC({1, 0})->TexCoordIds()[0] = 5678; // Not marked dirty, left out of increment
+        world_.DeleteChunk({2, 0});
+        world_.DeleteChunk({3, 0});
+        world_.EmplaceChunk({3, 0}).TexCoordIds()[0] = 4321;
+        world_.SetWorldGeneratorSeed(42);
+
+        std::stringstream ss;
+        {
+            cereal::PortableBinaryOutputArchive archive(ss);
+            world_.SaveIncrement(archive);
+        }
+        {
+            cereal::PortableBinaryInputArchive archive(ss);
+            base.LoadIncrement(archive);
+        }
+
+        EXPECT_EQ(base.GetTexCoordId({0, 0}, TileLayer::base), 1234);
+        EXPECT_EQ(base.GetTexCoordId({32, 0}, TileLayer::base), 0);
+        EXPECT_EQ(base.GetChunkC({2, 0}), nullptr);
+        ASSERT_NE(base.GetChunkC({3, 0}), nullptr);
+        EXPECT_EQ(base.GetChunkC({3, 0})->TexCoordIds()[0], 4321);
+        EXPECT_EQ(base.GetWorldGeneratorSeed(), 42);
+    }
+
+    TEST_F(WorldTest, SerializeIncrementUniqueData) {
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+
+        auto& transport_belt = proto.Make<proto::TransportBelt>();
+        auto& inserter       = proto.Make<proto::Inserter>();
+        proto.GenerateRelocationTable();
+
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+        world_.EmplaceChunk({2, 0});
+
+        // Structure spans chunks
+        const auto con_struct = std::make_shared<ConveyorStruct>(
+            Orientation::right, ConveyorStruct::TerminationType::straight, 2);
+        TestCreateConveyorSegment(world_, {31, 2}, con_struct, transport_belt);
+        TestCreateConveyorSegment(world_, {32, 2}, con_struct, transport_belt);
+
+        auto* inserter_tile = world_.GetTile({33, 3}, TileLayer::entity);
+        inserter_tile->SetPrototype(Orientation::up, inserter);
+        inserter_tile->MakeUniqueData<proto::InserterData>(Orientation::up);
+        world_.LogicRegister(LogicGroup::inserter, {33, 3}, TileLayer::entity);
+
+        auto base = TestSerializeDeserialize(world_);
+        world_.MarkSaved();
+
+        // Chunks with conveyor and inserter are not modified
+        world_.SetTexCoordId({64, 0}, TileLayer::base, 1234);
+
+        std::stringstream ss;
+        {
+            cereal::PortableBinaryOutputArchive archive(ss);
+            world_.SaveIncrement(archive);
+        }
+        {
+            // Unique data ids restart in each increment
+            unique.Clear();
+
+            cereal::PortableBinaryInputArchive archive(ss);
+            base.LoadIncrement(archive);
+        }
+
+        EXPECT_EQ(base.GetTexCoordId({64, 0}, TileLayer::base), 1234);
+
+        const auto* left_tile  = base.GetTile({31, 2}, TileLayer::entity);
+        const auto* right_tile = base.GetTile({32, 2}, TileLayer::entity);
+        ASSERT_NE(left_tile, nullptr);
+        ASSERT_NE(right_tile, nullptr);
+
+        const auto* left_data  = left_tile->GetUniqueData<proto::ConveyorData>();
+        const auto* right_data = right_tile->GetUniqueData<proto::ConveyorData>();
+        ASSERT_NE(left_data, nullptr);
+        ASSERT_NE(right_data, nullptr);
+        EXPECT_EQ(left_data->structure, right_data->structure); // Still one structure
+
+        const auto& conveyors = base.LogicGet(LogicGroup::conveyor);
+        ASSERT_EQ(conveyors.size(), 2);
+        EXPECT_EQ(conveyors[0].uniqueData.Get(), left_data);
+        EXPECT_EQ(conveyors[1].uniqueData.Get(), right_data);
+
+        const auto& inserters = base.LogicGet(LogicGroup::inserter);
+        ASSERT_EQ(inserters.size(), 1);
+        EXPECT_EQ(inserters[0].uniqueData.Get(), base.GetTile({33, 3}, TileLayer::entity)->GetUniqueData());
+    }
+
+    TEST_F(WorldTest, SerializeEncodedChunks) {
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        proto.GenerateRelocationTable();
+
+        world_.EmplaceChunk({0, 0}).TexCoordIds()[0] = 1234;
+        world_.EmplaceChunk({1, 0});
+        TestSetupContainer(world_, {32, 0}, Orientation::up, container);
+
+        auto result              = TestSerializeDeserialize(world_);
+        const auto& const_result = result;
+
+        // Chunk with entity is decoded when loading
+        EXPECT_EQ(result.GetEncodedChunkCount(), 1);
+        EXPECT_NE(const_result.GetChunkC({1, 0}), nullptr);
+        EXPECT_EQ(result.GetEncodedChunkCount(), 1);
+
+        // Saved again without decoding
+        auto resaved      = TestSerializeDeserialize(result);
+        const auto* chunk = static_cast<const World&>(resaved).GetChunkC({0, 0}); // Decoded on access
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_EQ(chunk->TexCoordIds()[0], 1234);
+        EXPECT_EQ(resaved.GetEncodedChunkCount(), 1); // Cannot be modified through const lookups, buffer is saved
+    }
+
+    TEST_F(WorldTest, LoadEncodedChunks) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({5, 0});
+
+        auto result = TestSerializeDeserialize(world_);
+        ASSERT_EQ(result.GetEncodedChunkCount(), 2);
+
+        result.LoadEncodedChunks({1, 0}, 2);
+
+        EXPECT_EQ(result.GetEncodedChunkCount(), 1);
+        EXPECT_NE(result.GetChunkC({0, 0}), nullptr);
+
+        // Kept apart from chunks of world until looked up through a non const lookup
+        const auto& const_result = result;
+        const auto* chunk        = const_result.GetChunkC({5, 0});
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_EQ(const_result.GetChunkC({5, 0}), chunk);
+        EXPECT_EQ(result.GetEncodedChunkCount(), 1);
+
+        EXPECT_EQ(result.GetChunkC({5, 0}), chunk);
+        EXPECT_EQ(result.GetEncodedChunkCount(), 0);
+    }
+
+    TEST_F(WorldTest, DeleteEncodedChunk) {
+        world_.EmplaceChunk({0, 0});
+
+        auto result = TestSerializeDeserialize(world_);
+        result.MarkSaved();
+
+        result.DeleteChunk({0, 0});
+        EXPECT_EQ(result.GetEncodedChunkCount(), 0);
+        EXPECT_EQ(result.GetChunkC({0, 0}), nullptr);
+    }
+
+    TEST_F(WorldTest, GenerateChunkDecodesEncoded) {
+        data::PrototypeManager proto;
+        world_.EmplaceChunk({0, 0}).TexCoordIds()[0] = 1234;
+
+        auto result = TestSerializeDeserialize(world_);
+        ASSERT_EQ(result.GetEncodedChunkCount(), 1);
+
+        ThreadPool pool(1);
+        result.QueueChunkGeneration({0, 0});
+        result.GenChunkAll(pool, proto);
+
+        EXPECT_EQ(result.GetEncodedChunkCount(), 0);
+
+        const auto* chunk = static_cast<const World&>(result).GetChunkC({0, 0});
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_EQ(chunk->TexCoordIds()[0], 1234); // Not generated
+        EXPECT_FALSE(chunk->IsDirty());
+    }
+
     TEST_F(WorldTest, EnableDisableAnimation) {
         world_.EmplaceChunk({0, 0});
         constexpr auto animation_offset = 101;
 
-        proto::ContainerEntity container;
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
         container.SetDimension({2, 3});
         TestSetupMultiTile(world_, {1, 2}, TileLayer::entity, Direction::up, container);
 
@@ -244,6 +591,144 @@ namespace jactorio::game
         EXPECT_NE(chunk.GetCTile({0, 0}, TileLayer::base).GetPrototype(), &tile);
     }
 
+    TEST_F(WorldTest, GenerateChunkFocus) {
+        world_.QueueChunkGeneration({0, 0});
+        world_.QueueChunkGeneration({12, 10});
+        world_.QueueChunkGeneration({10, 10});
+
+        const data::PrototypeManager proto;
+
+        // Nearest to focus first
+        world_.SetGenerationFocus({{-5, -5}, {9, 10}});
+        world_.GenChunk(proto);
+        EXPECT_NE(world_.GetChunkC({10, 10}), nullptr);
+
+        world_.SetGenerationFocus({{-5, -5}});
+        world_.GenChunk(proto);
+        EXPECT_NE(world_.GetChunkC({0, 0}), nullptr);
+        EXPECT_EQ(world_.GetChunkC({12, 10}), nullptr);
+    }
+
+    TEST_F(WorldTest, GenerateChunkSeedChanged) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        auto& water = proto.Make<proto::Tile>();
+        auto& grass = proto.Make<proto::Tile>();
+
+        auto& noise_layer     = proto.Make<proto::NoiseLayer<proto::Tile>>();
+        noise_layer.normalize = true;
+        noise_layer.Add(0, &water);
+        noise_layer.Add(1, &grass);
+
+        world_.QueueChunkGeneration({0, 0});
+        world_.GenChunk(proto);
+
+        // Generation plan rebuilt for new seed
+        world_.SetWorldGeneratorSeed(1234);
+        world_.QueueChunkGeneration({1, 0});
+        world_.GenChunk(proto);
+
+        World seed_world;
+        seed_world.SetWorldGeneratorSeed(1234);
+        seed_world.QueueChunkGeneration({1, 0});
+        seed_world.GenChunk(proto);
+
+        const auto* chunk      = world_.GetChunkC({1, 0});
+        const auto* seed_chunk = seed_world.GetChunkC({1, 0});
+        ASSERT_NE(chunk, nullptr);
+        ASSERT_NE(seed_chunk, nullptr);
+        for (int tile = 0; tile < Chunk::kChunkArea; ++tile) {
+            EXPECT_EQ(chunk->Tiles(TileLayer::base)[tile].GetPrototype(),
+                      seed_chunk->Tiles(TileLayer::base)[tile].GetPrototype());
+        }
+    }
+
+    TEST_F(WorldTest, GenerateChunkThreadPool) {
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        proto::Sprite sprite;
+        sprite.texCoordId = 12;
+
+        auto& water = proto.Make<proto::Tile>();
+        auto& grass = proto.Make<proto::Tile>();
+        water.sprite  = &sprite;
+        water.isWater = true;
+        grass.sprite  = &sprite;
+
+        auto& noise_layer     = proto.Make<proto::NoiseLayer<proto::Tile>>();
+        noise_layer.normalize = true;
+        noise_layer.Add(-0.5, &water);
+        noise_layer.Add(1, &grass);
+
+        World serial_world;
+        for (int i = 0; i < 6; ++i) {
+            world_.QueueChunkGeneration({i, -i});
+            serial_world.QueueChunkGeneration({i, -i});
+        }
+        serial_world.GenChunk(proto, 6);
+
+        ThreadPool pool(2);
+        world_.GenChunk(pool, proto, std::chrono::microseconds(1000)); // 4 chunks for 2 threads, 2 remain queued
+        world_.GenChunkFinish();
+        EXPECT_NE(world_.GetChunkC({0, 0}), nullptr);
+        EXPECT_EQ(world_.GetChunkC({5, -5}), nullptr);
+
+        world_.GenChunk(pool, proto, std::chrono::microseconds(1000));
+        world_.GenChunkFinish();
+
+        // Identical to generating on the calling thread
+        for (int i = 0; i < 6; ++i) {
+            const auto* chunk = world_.GetChunkC({i, -i});
+            ASSERT_NE(chunk, nullptr);
+
+            const auto* serial_chunk = serial_world.GetChunkC({i, -i});
+            for (int tile = 0; tile < Chunk::kChunkArea; ++tile) {
+                EXPECT_EQ(chunk->Tiles(TileLayer::base)[tile].GetPrototype(),
+                          serial_chunk->Tiles(TileLayer::base)[tile].GetPrototype());
+            }
+
+            const auto* tex_ids        = world_.GetChunkTexCoordIds({i, -i});
+            const auto* serial_tex_ids = serial_world.GetChunkTexCoordIds({i, -i});
+            EXPECT_TRUE(std::equal(tex_ids, tex_ids + Chunk::kChunkArea * kTileLayerCount, serial_tex_ids));
+            EXPECT_EQ(tex_ids[0], 12);
+        }
+    }
+
+    TEST_F(WorldTest, GenerateChunkThreadPoolClear) {
+        data::PrototypeManager proto;
+
+        ThreadPool pool(1);
+        world_.QueueChunkGeneration({0, 0});
+        world_.GenChunk(pool, proto, std::chrono::microseconds(1000));
+
+        // Chunk generating is discarded
+        world_.Clear();
+        world_.GenChunkFinish();
+        EXPECT_EQ(world_.GetChunkC({0, 0}), nullptr);
+    }
+
+    TEST_F(WorldTest, GenerateChunkAll) {
+        data::PrototypeManager proto;
+
+        const auto& existing = world_.EmplaceChunk({3, 0});
+        for (int i = 0; i < 10; ++i) {
+            world_.QueueChunkGeneration({i, 0});
+        }
+
+        ThreadPool pool(2);
+        world_.GenChunkAll(pool, proto); // More chunks queued than are submitted at a time
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_NE(world_.GetChunkC({i, 0}), nullptr);
+        }
+        EXPECT_EQ(world_.GetChunkC({10, 0}), nullptr);
+
+        // Existing chunk not replaced
+        EXPECT_EQ(world_.GetChunkC({3, 0}), &existing);
+    }
+
     TEST_F(WorldTest, Clear) {
         auto& added_chunk = world_.EmplaceChunk({6, 6});
 
@@ -262,7 +747,21 @@ namespace jactorio::game
 
         EXPECT_EQ(world_.GetChunkC({6, 6}), nullptr);
         EXPECT_TRUE(world_.LogicGet(LogicGroup::inserter).empty());
-        EXPECT_EQ(world_.GetChunkTexCoordIds({6, 6}).second, 0);
+        EXPECT_EQ(world_.GetChunkTexCoordIds({6, 6}), nullptr);
+    }
+
+    TEST_F(WorldTest, ClearReleasesUniqueData) {
+        world_.EmplaceChunk({0, 0});
+        auto& pool = world_.GetUniqueDataPool().Get<proto::ContainerEntityData>();
+
+        world_.GetTile({0, 0}, TileLayer::entity)
+            ->MakeUniqueData<proto::ContainerEntityData>(world_.GetUniqueDataPool(), 10);
+        EXPECT_EQ(pool.Size(), 1);
+        EXPECT_EQ(pool.SlabCount(), 1);
+
+        world_.Clear();
+        EXPECT_EQ(pool.Size(), 0);
+        EXPECT_EQ(pool.SlabCount(), 0);
     }
 
 
@@ -277,7 +776,10 @@ namespace jactorio::game
 
         // Registering again will not duplicate
         // Does not care about modified prototypes / unique data
-        const proto::ContainerEntity container;
+        data::PrototypeManager proto;
+        data::active_prototype_manager = &proto;
+
+        const auto& container = proto.Make<proto::ContainerEntity>();
         world_.GetTile({32, 0}, TileLayer::entity)->SetPrototype(Direction::up, container);
         world_.LogicRegister(LogicGroup::inserter, {32, 0}, TileLayer::entity);
         EXPECT_EQ(logic_list.size(), 1);
@@ -301,6 +803,28 @@ namespace jactorio::game
         EXPECT_EQ(world_.LogicGet(LogicGroup::conveyor).size(), 1);
     }
 
+    TEST_F(WorldTest, LogicRemoveMovesLast) {
+        world_.EmplaceChunk({0, 0});
+        world_.LogicRegister(LogicGroup::inserter, {1, 0}, TileLayer::entity);
+        world_.LogicRegister(LogicGroup::inserter, {2, 0}, TileLayer::entity);
+        world_.LogicRegister(LogicGroup::inserter, {3, 0}, TileLayer::entity);
+
+        world_.LogicRemove(LogicGroup::inserter, {1, 0}, TileLayer::entity);
+
+        auto& logic_list = world_.LogicGet(LogicGroup::inserter);
+        ASSERT_EQ(logic_list.size(), 2);
+        EXPECT_EQ(logic_list[0].coord, WorldCoord(3, 0));
+        EXPECT_EQ(logic_list[1].coord, WorldCoord(2, 0));
+
+        // Moved object can still be found
+        world_.LogicRemove(LogicGroup::inserter, {3, 0}, TileLayer::entity);
+        ASSERT_EQ(logic_list.size(), 1);
+        EXPECT_EQ(logic_list[0].coord, WorldCoord(2, 0));
+
+        world_.LogicRegister(LogicGroup::inserter, {2, 0}, TileLayer::entity);
+        EXPECT_EQ(logic_list.size(), 1);
+    }
+
     class WorldDeserialize : public testing::Test
     {
     protected:
@@ -374,6 +898,128 @@ namespace jactorio::game
         EXPECT_TRUE(result_inserter_data->dropoff.IsInitialized());
     }
 
+    TEST_F(WorldDeserialize, ParallelSpanChunks) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        container.SetDimension({2, 1});
+        TestSetupMultiTile(world_, {31, 0}, TileLayer::base, Orientation::up, container);
+
+        // Structure serialized with each chunk, both tiles share one structure once loaded
+        auto& transport_belt  = proto.Make<proto::TransportBelt>();
+        const auto con_struct = std::make_shared<ConveyorStruct>(
+            Orientation::right, ConveyorStruct::TerminationType::straight, 2);
+        TestSetupConveyor(world_, {31, 2}, transport_belt, con_struct);
+        TestSetupConveyor(world_, {32, 2}, transport_belt, con_struct);
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+        proto.GenerateRelocationTable();
+
+        ThreadPool pool(2);
+        data::active_thread_pool = &pool;
+        CapturingGuard<void()> guard([]() { data::active_thread_pool = nullptr; });
+
+        auto result = TestSerializeDeserialize(world_);
+        result.DeserializePostProcess();
+
+        EXPECT_EQ(result.GetTile({32, 0}, TileLayer::base)->GetTopLeft(), result.GetTile({31, 0}, TileLayer::base));
+
+        auto* left_data  = result.GetTile({31, 2}, TileLayer::entity)->GetUniqueData<proto::ConveyorData>();
+        auto* right_data = result.GetTile({32, 2}, TileLayer::entity)->GetUniqueData<proto::ConveyorData>();
+        ASSERT_NE(left_data, nullptr);
+        ASSERT_NE(right_data, nullptr);
+        EXPECT_EQ(left_data->structure, right_data->structure);
+    }
+
+    TEST_F(WorldDeserialize, DeferredChunks) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        auto& resource = proto.Make<proto::ResourceEntity>();
+        TestSetupResource(world_, {3, 4}, resource, 42);
+
+        auto& container = proto.Make<proto::ContainerEntity>();
+        TestSetupContainer(world_, {33, 0}, Orientation::up, container);
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+        proto.GenerateRelocationTable();
+
+        // Standalone chunk encoded by Finish, chunk with container encoded while serializing
+        data::DeferredSave save;
+        {
+            data::active_deferred_save = &save;
+            CapturingGuard<void()> guard([]() { data::active_deferred_save = nullptr; });
+
+            cereal::PortableBinaryOutputArchive archive(save.Stream());
+            archive(world_);
+        }
+        const auto bytes = save.Finish();
+
+        std::ostringstream expected(std::ios_base::binary);
+        {
+            cereal::PortableBinaryOutputArchive archive(expected);
+            archive(world_);
+        }
+        EXPECT_EQ(bytes.size(), expected.str().size());
+
+        std::istringstream iss(bytes, std::ios_base::binary);
+        cereal::PortableBinaryInputArchive archive(iss);
+        World result;
+        archive(result);
+        result.DeserializePostProcess();
+
+        ASSERT_NE(result.GetResourceAmount({3, 4}), nullptr);
+        EXPECT_EQ(*result.GetResourceAmount({3, 4}), 42);
+        ASSERT_NE(result.GetTile({33, 0}, TileLayer::entity), nullptr);
+        EXPECT_NE(result.GetTile({33, 0}, TileLayer::entity)->GetUniqueData<proto::ContainerEntityData>(), nullptr);
+    }
+
+    TEST_F(WorldDeserialize, DecodeChunksDrillReaches) {
+        world_.EmplaceChunk({0, 0});
+        world_.EmplaceChunk({1, 0});
+        world_.EmplaceChunk({3, 0});
+
+        data::PrototypeManager proto;
+        data::UniqueDataManager unique;
+
+        auto& item     = proto.Make<proto::Item>();
+        auto& resource = proto.Make<proto::ResourceEntity>();
+        resource.SetItem(&item);
+
+        auto& drill = proto.Make<proto::MiningDrill>();
+        drill.SetDimension({3, 3});
+        drill.miningRadius = 1;
+
+        // Ore only within chunk to the right, which has nothing referring outside itself
+        TestSetupResource(world_, {32, 1}, resource, 10);
+        TestSetupResource(world_, {32, 2}, resource, 10);
+        TestSetupDrill(world_, logic_, {29, 1}, Orientation::right, drill);
+
+        data::active_prototype_manager   = &proto;
+        data::active_unique_data_manager = &unique;
+        proto.GenerateRelocationTable();
+
+        auto result = TestSerializeDeserialize(world_);
+        ASSERT_EQ(result.GetEncodedChunkCount(), 2);
+
+        result.DeserializePostProcess();
+        EXPECT_EQ(result.GetEncodedChunkCount(), 1); // Beyond reach of drill
+
+        auto* drill_data = result.GetTile({29, 1}, TileLayer::entity)->GetUniqueData<proto::MiningDrillData>();
+        ASSERT_NE(drill_data, nullptr);
+        EXPECT_EQ(drill_data->resourceOffset, 9);
+        EXPECT_EQ(drill_data->resourceOffsets, (std::vector<uint16_t>{14}));
+    }
+
     TEST_F(WorldDeserialize, CallOnDeserialize) {
         class MockWorldObject : public TestMockWorldObject
         {
@@ -432,5 +1078,12 @@ namespace jactorio::game
 
         ASSERT_EQ(result_logic_list.size(), 1);
         EXPECT_EQ(old_logic_object, result_logic_list[0]);
+
+        // Index of registered coords was rebuilt
+        result.LogicRegister(LogicGroup::inserter, {2, 3}, TileLayer::resource);
+        EXPECT_EQ(result_logic_list.size(), 1);
+
+        result.LogicRemove(LogicGroup::inserter, {2, 3}, TileLayer::resource);
+        EXPECT_TRUE(result_logic_list.empty());
     }
 } // namespace jactorio::game
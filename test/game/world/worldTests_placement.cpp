@@ -72,15 +72,18 @@ namespace jactorio::game
         }
 
     protected:
-        proto::ContainerEntity entity_;
+        data::PrototypeManager proto_;
+
+        proto::ContainerEntity& entity_ = proto_.Make<proto::ContainerEntity>();
         proto::Sprite sprite_;
 
-        proto::Tile waterTile_;
-        proto::Tile landTile_;
+        proto::Tile& waterTile_ = proto_.Make<proto::Tile>();
+        proto::Tile& landTile_  = proto_.Make<proto::Tile>();
 
         World world_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
             GenerateTestWorld(world_, &waterTile_, &landTile_);
 
             // Conveyor utility requires tex coord id when setting up conveyor
@@ -256,7 +259,7 @@ namespace jactorio::game
             }
         };
 
-        Mock mock;
+        auto& mock = proto_.Make<Mock>();
         mock.SetDimension({2, 4});
         world_.Place({9, 10}, Direction::right, mock);
 
@@ -0,0 +1,114 @@
+// This file is subject to the terms and conditions defined in 'LICENSE' in the source code package
+
+#include <gtest/gtest.h>
+
+#include "game/world/world_gen_plan.h"
+
+#include "data/prototype_manager.h"
+#include "proto/sprite.h"
+
+namespace jactorio::game
+{
+    class WorldGenPlanTest : public testing::Test
+    {
+    protected:
+        data::PrototypeManager proto_;
+    };
+
+    TEST_F(WorldGenPlanTest, SortedLayers) {
+        auto& layer_1 = proto_.Make<proto::NoiseLayer<proto::Tile>>();
+        auto& layer_2 = proto_.Make<proto::NoiseLayer<proto::Tile>>();
+        auto& layer_3 = proto_.Make<proto::NoiseLayer<proto::Entity>>();
+        layer_1.order = 2;
+        layer_2.order = 1;
+
+        layer_1.octaveCount = 3;
+        layer_1.frequency   = 0.5;
+        layer_1.persistence = 0.75;
+
+        const WorldGenPlan plan(proto_, 100);
+        EXPECT_TRUE(plan.IsBuiltFrom(proto_, 100));
+        EXPECT_FALSE(plan.IsBuiltFrom(proto_, 101));
+
+        const auto& tile_layers = plan.GetTileLayers();
+        ASSERT_EQ(tile_layers.size(), 2);
+        EXPECT_EQ(tile_layers[0].noiseLayer, &layer_2);
+        EXPECT_EQ(tile_layers[1].noiseLayer, &layer_1);
+
+        // Seed offset by index of layer
+        EXPECT_EQ(tile_layers[0].params.seed, 100);
+        EXPECT_EQ(tile_layers[1].params.seed, 101);
+
+        EXPECT_EQ(tile_layers[1].params.octaveCount, 3);
+        EXPECT_DOUBLE_EQ(tile_layers[1].params.frequency, 0.5);
+        EXPECT_DOUBLE_EQ(tile_layers[1].params.persistence, 0.75);
+
+        // Seed offset restarts for entities
+        ASSERT_EQ(plan.GetEntityLayers().size(), 1);
+        EXPECT_EQ(plan.GetEntityLayers()[0].noiseLayer, &layer_3);
+        EXPECT_EQ(plan.GetEntityLayers()[0].params.seed, 100);
+    }
+
+    TEST_F(WorldGenPlanTest, TexCoordIds) {
+        proto::Sprite sprite;
+        sprite.texCoordId = 42;
+
+        proto::Tile tile_sprite;
+        tile_sprite.sprite = &sprite;
+        proto::Tile tile_no_sprite;
+
+        auto& layer = proto_.Make<proto::NoiseLayer<proto::Tile>>();
+        layer.Add(0, &tile_sprite);
+        layer.Add(0.5, &tile_no_sprite);
+        layer.Add(1, nullptr);
+
+        const WorldGenPlan plan(proto_, 0);
+        const auto& plan_layer = plan.GetTileLayers()[0];
+
+        EXPECT_EQ(plan_layer.prototypes, (std::vector<const proto::Tile*>{&tile_sprite, &tile_no_sprite, nullptr}));
+        EXPECT_EQ(plan_layer.texCoordIds, (std::vector<SpriteTexCoordIndexT>{42, 0, 0}));
+    }
+
+    TEST_F(WorldGenPlanTest, FindRangeMatchesNoiseLayer) {
+        proto::Tile tile_1;
+        proto::Tile tile_2;
+        proto::Tile tile_3;
+
+        for (const bool normalize : {false, true}) {
+            data::PrototypeManager proto;
+            auto& layer     = proto.Make<proto::NoiseLayer<proto::Tile>>();
+            layer.normalize = normalize;
+            layer.SetStartNoise(-0.5);
+            layer.Add(0, &tile_1);
+            layer.Add(0.25, &tile_2);
+            layer.Add(0.75, &tile_3);
+
+            const WorldGenPlan plan(proto, 0);
+            const auto& plan_layer = plan.GetTileLayers()[0];
+
+            for (const float val : {-2.f, -0.5f, -0.1f, 0.f, 0.1f, 0.25f, 0.5f, 0.75f, 0.8f, 2.f}) {
+                const auto range = plan_layer.FindRange(val);
+
+                const auto* expected = layer.Get(val);
+                if (expected == nullptr) {
+                    EXPECT_EQ(range, -1) << val;
+                    continue;
+                }
+
+                ASSERT_GE(range, 0) << val;
+                EXPECT_EQ(plan_layer.prototypes[range], expected) << val;
+
+                const auto [range_start, range_end] = layer.GetValNoiseRange(val);
+                EXPECT_EQ(plan_layer.ranges[range], range_start) << val;
+                EXPECT_EQ(plan_layer.ranges[range + 1], range_end) << val;
+            }
+        }
+    }
+
+    TEST_F(WorldGenPlanTest, FindRangeNoRanges) {
+        proto_.Make<proto::NoiseLayer<proto::Tile>>();
+
+        const WorldGenPlan plan(proto_, 0);
+        EXPECT_EQ(plan.GetTileLayers()[0].FindRange(-1), -1);
+    }
+} // namespace jactorio::game
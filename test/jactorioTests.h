@@ -154,13 +154,13 @@ namespace jactorio
     inline game::ChunkTile& TestSetupResource(game::World& world,
                                               const WorldCoord& coord,
                                               proto::ResourceEntity& resource,
-                                              const proto::ResourceEntityData::ResourceCount resource_amount) {
+                                              const ResourceEntityResourceCount resource_amount) {
 
         auto* tile = world.GetTile(coord, game::TileLayer::resource);
         assert(tile != nullptr);
 
         tile->SetPrototype(Orientation::up, &resource);
-        tile->MakeUniqueData<proto::ResourceEntityData>(resource_amount);
+        *world.GetResourceAmount(coord) = resource_amount;
 
         return *tile;
     }
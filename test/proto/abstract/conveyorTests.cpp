@@ -18,13 +18,17 @@ namespace jactorio::proto
     class ConveyorTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         game::World world_;
         game::Logic logic_;
 
-        TransportBelt lineProto_;
+        TransportBelt& lineProto_ = proto_.Make<TransportBelt>();
         Sprite sprite_;
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
 
             // Conveyor utility requires tex coord id when setting up conveyor
@@ -156,6 +160,19 @@ namespace jactorio::proto
         EXPECT_EQ(line_segment.length, 1);
     }
 
+    TEST_F(ConveyorTest, DataPooled) {
+        auto& pool = world_.GetUniqueDataPool().Get<ConveyorData>();
+
+        auto& first  = BuildConveyor({0, 0}, Orientation::right);
+        auto& second = BuildConveyor({1, 0}, Orientation::right);
+        EXPECT_EQ(pool.Size(), 2);
+        EXPECT_EQ(second.GetUniqueData<ConveyorData>() - first.GetUniqueData<ConveyorData>(), 1);
+
+        TlRemoveEvents({1, 0});
+        second.Clear();
+        EXPECT_EQ(pool.Size(), 1);
+    }
+
     TEST_F(ConveyorTest, OnRemoveDeleteConveyorSegment) {
         // Removing a conveyor needs to delete the conveyor segment associated with it
         BuildConveyor({0, 0}, Orientation::left);
@@ -253,7 +270,7 @@ namespace jactorio::proto
         auto* tile = world_.GetTile({1, 1}, game::TileLayer::entity);
 
 
-        TransportBelt proto;
+        auto& proto = proto_.Make<TransportBelt>();
         tile->SetPrototype(Orientation::up, &proto);
 
 
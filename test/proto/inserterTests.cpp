@@ -12,13 +12,17 @@ namespace jactorio::proto
     class InserterTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         game::World world_;
         game::Logic logic_;
 
-        Inserter inserterProto_;
-        ContainerEntity containerProto_;
+        Inserter& inserterProto_         = proto_.Make<Inserter>();
+        ContainerEntity& containerProto_ = proto_.Make<ContainerEntity>();
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
         }
 
@@ -34,7 +38,7 @@ namespace jactorio::proto
         auto* inserter_data = tile->GetUniqueData<InserterData>();
         ASSERT_NE(inserter_data, nullptr);
 
-        EXPECT_DOUBLE_EQ(inserter_data->rotationDegree.getAsDouble(), 180.);
+        EXPECT_DOUBLE_EQ(inserter_data->rotationDegree.AsDouble(), 180.);
 
         // Does not have both pickup + dropoff, not added
         EXPECT_EQ(world_.LogicGet(game::LogicGroup::inserter).size(), 0);
@@ -89,7 +93,7 @@ namespace jactorio::proto
 
 
         // Dropoff
-        AssemblyMachine asm_machine;
+        auto& asm_machine = proto_.Make<AssemblyMachine>();
         asm_machine.SetDimension({2, 2});
         TestSetupAssemblyMachine(world_, {1, 0}, Orientation::up, asm_machine);
         world_.UpdateDispatch({2, 0}, UpdateType::place);
@@ -150,7 +154,7 @@ namespace jactorio::proto
         const auto* result_data = static_cast<InserterData*>(result_base.get());
 
         EXPECT_EQ(result_data->orientation, Orientation::left);
-        EXPECT_DOUBLE_EQ(result_data->rotationDegree.getAsDouble(), 145.234);
+        EXPECT_DOUBLE_EQ(result_data->rotationDegree.AsDouble(), 145.234);
         EXPECT_EQ(result_data->status, InserterData::Status::dropoff);
         EXPECT_EQ(result_data->heldItem.count, 32);
     }
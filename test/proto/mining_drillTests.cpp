@@ -11,16 +11,20 @@ namespace jactorio::proto
     class MiningDrillTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         game::World world_;
         game::Logic logic_;
 
-        MiningDrill drill_;
+        MiningDrill& drill_ = proto_.Make<MiningDrill>();
 
         Item resourceItem_;
-        ResourceEntity resource_;
-        ContainerEntity container_;
+        ResourceEntity& resource_   = proto_.Make<ResourceEntity>();
+        ContainerEntity& container_ = proto_.Make<ContainerEntity>();
 
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
 
             drill_.SetWidth(3);
@@ -43,7 +47,7 @@ namespace jactorio::proto
          * [ ] [ ] [ ] [ ] [ ] [ ] [ ] [ ]
          */
 
-        MiningDrill drill;
+        auto& drill = proto_.Make<MiningDrill>();
         drill.SetWidth(4);
         drill.SetHeight(3);
         drill.miningRadius = 2;
@@ -52,7 +56,7 @@ namespace jactorio::proto
         EXPECT_FALSE(drill.OnCanBuild(world_, {2, 2}, Orientation::up));
 
         // Has resource tiles
-        ResourceEntity resource;
+        auto& resource = proto_.Make<ResourceEntity>();
         world_.GetTile({0, 0}, game::TileLayer::resource)->SetPrototype(Orientation::up, &resource);
 
         EXPECT_TRUE(drill.OnCanBuild(world_, {2, 2}, Orientation::up));
@@ -69,12 +73,12 @@ namespace jactorio::proto
          * [ ] [ ] [ ] [ ] [ ] [ ] [ ] [ ]
          */
 
-        MiningDrill drill;
+        auto& drill = proto_.Make<MiningDrill>();
         drill.SetWidth(4);
         drill.SetHeight(3);
         drill.miningRadius = 2;
 
-        ResourceEntity resource;
+        auto& resource = proto_.Make<ResourceEntity>();
         world_.GetTile({7, 6}, game::TileLayer::resource)->SetPrototype(Orientation::up, &resource);
 
         EXPECT_TRUE(drill.OnCanBuild(world_, {2, 2}, Orientation::up));
@@ -100,7 +104,7 @@ namespace jactorio::proto
         // Closer to the top left
         {
             Item item2;
-            ResourceEntity resource2;
+            auto& resource2 = proto_.Make<ResourceEntity>();
             resource2.SetItem(&item2);
 
             world_.GetTile({1, 1}, game::TileLayer::resource)->SetPrototype(Orientation::up, &resource2);
@@ -117,7 +121,7 @@ namespace jactorio::proto
 
 
         auto& container_tile = TestSetupContainer(world_, {4, 2}, Orientation::up, container_);
-        auto& resource_tile  = TestSetupResource(world_, {1, 1}, resource_, 100);
+        TestSetupResource(world_, {1, 1}, resource_, 100);
         auto& drill_tile     = TestSetupDrill(world_, logic_, {1, 1}, Orientation::right, drill_);
 
         auto* data = drill_tile.GetUniqueData<MiningDrillData>();
@@ -127,7 +131,7 @@ namespace jactorio::proto
         EXPECT_EQ(data->resourceOffset, 6);
 
         // Resource taken from ground
-        EXPECT_EQ(resource_tile.GetUniqueData<ResourceEntityData>()->resourceAmount, 99);
+        EXPECT_EQ(*world_.GetResourceAmount({1, 1}), 99);
 
         // Ensure it inserts into the correct entity
         Item item;
@@ -142,7 +146,21 @@ namespace jactorio::proto
         EXPECT_EQ(container_tile.GetUniqueData<ContainerEntityData>()->inventory[1].count, 1);
 
         // Another resource taken for next output
-        EXPECT_EQ(resource_tile.GetUniqueData<ResourceEntityData>()->resourceAmount, 98);
+        EXPECT_EQ(*world_.GetResourceAmount({1, 1}), 98);
+    }
+
+    TEST_F(MiningDrillTest, FindResourcesOnBuild) {
+        TestSetupResource(world_, {0, 0}, resource_, 1);
+        TestSetupResource(world_, {2, 1}, resource_, 1);
+        TestSetupResource(world_, {4, 4}, resource_, 1);
+        TestSetupResource(world_, {5, 5}, resource_, 1); // Outside mining area
+
+        auto& drill_tile = TestSetupDrill(world_, logic_, {1, 1}, Orientation::right, drill_);
+        auto* data       = drill_tile.GetUniqueData<MiningDrillData>();
+
+        // Mining area is 5 wide, first resource from top left is mined first
+        EXPECT_EQ(data->resourceOffset, 0);
+        EXPECT_EQ(data->resourceOffsets, (std::vector<uint16_t>{24, 7}));
     }
 
     TEST_F(MiningDrillTest, ExtractRemoveResourceEntity) {
@@ -213,7 +231,7 @@ namespace jactorio::proto
 
         drill_.resourceOutput.right = {3, 1};
 
-        AssemblyMachine asm_machine;
+        auto& asm_machine = proto_.Make<AssemblyMachine>();
         asm_machine.SetDimension({2, 2});
         TestSetupAssemblyMachine(world_, {4, 1}, Orientation::up, asm_machine);
 
@@ -365,4 +383,23 @@ namespace jactorio::proto
 
         EXPECT_TRUE(tile.GetUniqueData<MiningDrillData>()->output.IsInitialized());
     }
+
+    TEST_F(MiningDrillTest, OnDeserializeFindResources) {
+        TestSetupResource(world_, {0, 0}, resource_, 1);
+        TestSetupResource(world_, {2, 1}, resource_, 1);
+        TestSetupResource(world_, {4, 4}, resource_, 1);
+
+        auto& tile = TestSetupDrill(world_, logic_, {1, 1}, Orientation::right, drill_);
+        auto* data = tile.GetUniqueData<MiningDrillData>();
+
+        // Resource offsets are not serialized
+        data->resourceOffset = 7;
+        data->resourceOffsets.clear();
+
+        world_.DeserializePostProcess();
+
+        // Resources prior to resource offset already mined
+        EXPECT_EQ(data->resourceOffset, 7);
+        EXPECT_EQ(data->resourceOffsets, (std::vector<uint16_t>{24}));
+    }
 } // namespace jactorio::proto
@@ -14,7 +14,11 @@ namespace jactorio::proto
     class SplitterTest : public testing::Test
     {
     protected:
+        data::PrototypeManager proto_;
+
         void SetUp() override {
+            data::active_prototype_manager = &proto_;
+
             world_.EmplaceChunk({0, 0});
 
             // Conveyor utility requires tex coord id when setting up conveyor
@@ -26,8 +30,8 @@ namespace jactorio::proto
         game::World world_;
         game::Logic logic_;
 
-        TransportBelt transBelt_;
-        Splitter splitter_;
+        TransportBelt& transBelt_ = proto_.Make<TransportBelt>();
+        Splitter& splitter_       = proto_.Make<Splitter>();
         Sprite sprite_;
     };
 